@@ -92,6 +92,16 @@ std::string Result::text() const
 	return text(_readerOpts.textMode());
 }
 
+void Result::appendText(std::string& out, TextMode mode) const
+{
+	_content.appendText(out, mode);
+}
+
+void Result::appendText(std::string& out) const
+{
+	appendText(out, _readerOpts.textMode());
+}
+
 std::string Result::ecLevel() const
 {
 	return _ecLevel;
@@ -105,6 +105,13 @@ public:
 	 */
 	std::string text() const;
 
+	/**
+	 * @brief appendText appends text(mode) to out. Reusing out for many results avoids allocating a new string each
+	 * time, for plain text content the bytes are decoded straight into it.
+	 */
+	void appendText(std::string& out, TextMode mode) const;
+	void appendText(std::string& out) const;
+
 	/**
 	 * @brief ecLevel returns the error correction level of the symbol (empty string if not applicable)
 	 */
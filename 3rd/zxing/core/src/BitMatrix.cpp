@@ -94,6 +94,30 @@ BitMatrix::findBoundingBox(int &left, int& top, int& width, int& height, int min
 	return width >= minSize && height >= minSize;
 }
 
+bool
+BitMatrix::findCorners(int left, int top, int width, int height, std::array<PointI, 4>& corners) const
+{
+	int right = left + width - 1, bottom = top + height - 1;
+	const PointI origins[] = {{left, top}, {right, top}, {right, bottom}, {left, bottom}};
+	const PointI dirs[] = {{1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
+
+	for (int i = 0; i < 4; ++i) {
+		// sweep the anti-diagonals from the corner inwards, the first set pixel is the closest one
+		bool found = false;
+		for (int d = 0; d < width + height - 1 && !found; ++d)
+			for (int dx = std::max(0, d - height + 1); dx <= std::min(d, width - 1) && !found; ++dx) {
+				auto p = origins[i] + PointI(dx * dirs[i].x, (d - dx) * dirs[i].y);
+				if (get(p.x, p.y)) {
+					corners[i] = p;
+					found = true;
+				}
+			}
+		if (!found)
+			return false;
+	}
+	return true;
+}
+
 static auto isSet = [](auto v) { return bool(v); };
 
 bool
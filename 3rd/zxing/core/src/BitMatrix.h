@@ -11,6 +11,7 @@
 #include "Point.h"
 #include "Range.h"
 
+#include <array>
 #include <cstdint>
 #include <stdexcept>
 #include <vector>
@@ -124,6 +125,15 @@ public:
 	*/
 	bool findBoundingBox(int &left, int& top, int& width, int& height, int minSize = 1) const;
 
+	/**
+	* Find the non-white pixels closest (along the diagonals) to the four corners of the given rectangle, usually the
+	* bounding box. For a rectangular symbol rotated by less than 45 degrees, these are the corners of the symbol.
+	*
+	* @param corners the pixels found, in the order top-left, top-right, bottom-right, bottom-left of the rectangle
+	* @return True iff there is a non-white pixel inside the rectangle
+	*/
+	bool findCorners(int left, int top, int width, int height, std::array<PointI, 4>& corners) const;
+
 	int width() const { return _width; }
 
 	int height() const { return _height; }
@@ -97,14 +97,13 @@ bool Content::canProcess() const
 	return std::all_of(encodings.begin(), encodings.end(), [](Encoding e) { return CanProcess(e.eci); });
 }
 
-std::string Content::render(bool withECI) const
+void Content::render(std::string& res, bool withECI) const
 {
 	if (empty() || !canProcess())
-		return {};
+		return;
 
 #ifdef ZXING_READERS
-	std::string res;
-	res.reserve(bytes.size() * 2);
+	res.reserve(res.size() + bytes.size() * 2);
 	if (withECI)
 		res += symbology.toString(true);
 	ECI lastECI = ECI::Unknown;
@@ -133,17 +132,22 @@ std::string Content::render(bool withECI) const
 					res += c;
 			}
 		} else {
-			res += BytesToUtf8(bytes.asView(begin, end - begin), inEci);
+			AppendUtf8(res, bytes.asView(begin, end - begin), inEci);
 		}
 	});
-
-	return res;
 #else
 	//TODO: replace by proper construction from encoded data from within zint
-	return std::string(bytes.asString());
+	res += bytes.asString();
 #endif
 }
 
+std::string Content::render(bool withECI) const
+{
+	std::string res;
+	render(res, withECI);
+	return res;
+}
+
 std::string Content::text(TextMode mode) const
 {
 	switch (mode) {
@@ -169,6 +173,18 @@ std::string Content::text(TextMode mode) const
 	return {}; // silence compiler warning
 }
 
+void Content::appendText(std::string& out, TextMode mode) const
+{
+	bool isRendered = mode == TextMode::Plain || mode == TextMode::ECI;
+#ifdef ZXING_READERS
+	isRendered |= mode == TextMode::HRI && type() == ContentType::Text;
+#endif
+	if (isRendered)
+		render(out, mode == TextMode::ECI);
+	else
+		out += text(mode);
+}
+
 std::wstring Content::utfW() const
 {
 	return FromUtf8(render(false));
@@ -206,6 +222,13 @@ ByteArray Content::bytesECI() const
 CharacterSet Content::guessEncoding() const
 {
 #ifdef ZXING_READERS
+	// pure ASCII is always guessed as ISO-8859-1, no need to assemble and scan the blocks with unknown encoding
+	if (IsAscii(bytes.asString())) {
+		bool hasUnknown = false;
+		ForEachECIBlock([&](ECI eci, int begin, int end) { hasUnknown |= eci == ECI::Unknown && begin != end; });
+		return hasUnknown ? CharacterSet::ISO8859_1 : CharacterSet::Unknown;
+	}
+
 	// assemble all blocks with unknown encoding
 	ByteArray input;
 	ForEachECIBlock([&](ECI eci, int begin, int end) {
@@ -239,19 +262,21 @@ ContentType Content::type() const
 		return ContentType::ISO15434;
 
 	ECI fallback = ToECI(guessEncoding());
-	std::vector<bool> binaryECIs;
+	bool hasBinary = false, hasText = false;
 	ForEachECIBlock([&](ECI eci, int begin, int end) {
 		if (eci == ECI::Unknown)
 			eci = fallback;
-		binaryECIs.push_back((!IsText(eci)
-							  || (ToInt(eci) > 0 && ToInt(eci) < 28 && ToInt(eci) != 25
-								  && std::any_of(bytes.begin() + begin, bytes.begin() + end,
-												 [](auto c) { return c < 0x20 && c != 0x9 && c != 0xa && c != 0xd; }))));
+		bool isBinary = !IsText(eci)
+						|| (ToInt(eci) > 0 && ToInt(eci) < 28 && ToInt(eci) != 25
+							&& std::any_of(bytes.begin() + begin, bytes.begin() + end,
+										   [](auto c) { return c < 0x20 && c != 0x9 && c != 0xa && c != 0xd; }));
+		hasBinary |= isBinary;
+		hasText |= !isBinary;
 	});
 
-	if (!Contains(binaryECIs, true))
+	if (!hasBinary)
 		return ContentType::Text;
-	if (!Contains(binaryECIs, false))
+	if (!hasText)
 		return ContentType::Binary;
 
 	return ContentType::Mixed;
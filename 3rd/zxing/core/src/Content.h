@@ -41,6 +41,7 @@ class Content
 	void ForEachECIBlock(FUNC f) const;
 
 	void switchEncoding(ECI eci, bool isECI);
+	void render(std::string& out, bool withECI) const;
 	std::string render(bool withECI) const;
 
 public:
@@ -77,6 +78,7 @@ public:
 	bool canProcess() const;
 
 	std::string text(TextMode mode) const;
+	void appendText(std::string& out, TextMode mode) const; // reuses the capacity of out, see Barcode::appendText
 	std::wstring utfW() const; // utf16 or utf32 depending on the platform, i.e. on size_of(wchar_t)
 	std::string utf8() const { return render(false); }
 
@@ -0,0 +1,58 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace ZXing {
+
+/**
+ * Point in time after which a read operation should give up, optionally combined with a cancellation flag that
+ * another thread can raise. The default constructed Deadline never expires.
+ *
+ * The deadline is checked cooperatively between pyramid layers, readers and scan lines, so the time a read takes
+ * after expiry is bounded by the cost of a single one of those steps. Everything found until then is returned.
+ */
+class Deadline
+{
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point _time = Clock::time_point::max();
+	const std::atomic<bool>* _cancel = nullptr;
+
+public:
+	Deadline() = default;
+	explicit Deadline(Clock::time_point time, const std::atomic<bool>* cancel = nullptr) : _time(time), _cancel(cancel) {}
+	explicit Deadline(const std::atomic<bool>* cancel) : _cancel(cancel) {}
+
+	/// Deadline that expires the given duration from now (or earlier, if cancel is raised)
+	static Deadline In(std::chrono::milliseconds timeout, const std::atomic<bool>* cancel = nullptr)
+	{
+		return Deadline(Clock::now() + timeout, cancel);
+	}
+
+	bool isSet() const noexcept { return _time != Clock::time_point::max() || _cancel; }
+
+	bool expired() const noexcept
+	{
+		return (_cancel && _cancel->load(std::memory_order_relaxed)) || (_time != Clock::time_point::max() && Clock::now() >= _time);
+	}
+
+	/// Time left until expiry, zero if expired, milliseconds::max() if no time limit is set
+	std::chrono::milliseconds remaining() const noexcept
+	{
+		if (_cancel && _cancel->load(std::memory_order_relaxed))
+			return std::chrono::milliseconds(0);
+		if (_time == Clock::time_point::max())
+			return std::chrono::milliseconds::max();
+		auto left = std::chrono::duration_cast<std::chrono::milliseconds>(_time - Clock::now());
+		return std::max(left, std::chrono::milliseconds(0));
+	}
+};
+
+} // ZXing
@@ -7,6 +7,10 @@
 
 #include "GridSampler.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
 #ifdef PRINT_DEBUG
 #include "LogMatrix.h"
 #include "BitMatrixIO.h"
@@ -23,6 +27,72 @@ DetectorResult SampleGrid(const BitMatrix& image, int width, int height, const P
 	return SampleGrid(image, width, height, {ROI{0, width, 0, height, mod2Pix}});
 }
 
+// Samples the roi into res by stepping through the homogeneous coordinates of mod2Pix row by row instead of evaluating
+// the full projection for every module, and without per module bounds checks. The latter is only possible if the
+// denominator of mod2Pix has the same sign in all four corners of the roi (and hence everywhere in between): then
+// mod2Pix is a proper perspective transformation of the roi, which maps it onto the convex quadrilateral spanned by the
+// projected corners. As those have been checked to lie inside the image (see SampleGrid below), so does every sample
+// point. Returns false otherwise.
+static bool SampleROIFast(const BitMatrix& image, const ROI& roi, BitMatrix& res)
+{
+	using value_t = PointF::value_t;
+	constexpr int LANES = 8; // block size the inner loops are written for, so the compiler can vectorize them
+	constexpr int FRAC_BITS = 16;
+	constexpr value_t ONE = 1 << FRAC_BITS;
+
+	auto&& [x0, x1, y0, y1, mod2Pix] = roi;
+	auto w = [&](int x, int y) { return mod2Pix.homogeneous(centered(PointI{x, y}))[2]; };
+	auto wTL = w(x0, y0), wTR = w(x1 - 1, y0), wBR = w(x1 - 1, y1 - 1), wBL = w(x0, y1 - 1);
+	if (!(wTL > 0 && wTR > 0 && wBR > 0 && wBL > 0) && !(wTL < 0 && wTR < 0 && wBR < 0 && wBL < 0))
+		return false;
+
+	const int maxX = image.width() - 1, maxY = image.height() - 1;
+	auto set = [&](int x, int y, int64_t px, int64_t py) {
+		// the clamping only guards against rounding effects at the image border
+		if (image.get(std::clamp(int(px), 0, maxX), std::clamp(int(py), 0, maxY)))
+			res.set(x, y);
+	};
+
+	const auto step = mod2Pix.homogeneous(centered(PointI{x0 + 1, y0}));
+	const auto start = mod2Pix.homogeneous(centered(PointI{x0, y0}));
+	const value_t dX = step[0] - start[0], dY = step[1] - start[1], dW = step[2] - start[2];
+	const int n = x1 - x0;
+
+	for (int y = y0; y < y1; ++y) {
+		auto [X, Y, W] = mod2Pix.homogeneous(centered(PointI{x0, y}));
+		auto pFirst = PointF(X / W, Y / W);
+		auto pLast = mod2Pix(centered(PointI{x1 - 1, y}));
+
+		// If w changes so little along the row that the projection is affine for all practical purposes, interpolate
+		// linearly between the exact end points in fixed point arithmetic: the deviation from the exact projection is
+		// about length * |dw / w| / 4, which is limited to 1/32 pixel here.
+		if (n > 1 && 8 * std::abs(dW * (n - 1)) * maxAbsComponent(pLast - pFirst)
+						 < std::min(std::abs(W), std::abs(W + dW * (n - 1)))) {
+			auto px = int64_t(std::lround(pFirst.x * ONE)), py = int64_t(std::lround(pFirst.y * ONE));
+			auto dx = int64_t(std::lround((pLast.x - pFirst.x) / (n - 1) * ONE));
+			auto dy = int64_t(std::lround((pLast.y - pFirst.y) / (n - 1) * ONE));
+			for (int x = x0; x < x1; ++x, px += dx, py += dy)
+				set(x, y, px >> FRAC_BITS, py >> FRAC_BITS);
+			continue;
+		}
+
+		// general perspective: one division per module, computed LANES modules at a time
+		for (int x = x0; x < x1; x += LANES) {
+			value_t px[LANES], py[LANES];
+			for (int i = 0; i < LANES; ++i) {
+				value_t r = 1 / (W + i * dW);
+				px[i] = (X + i * dX) * r;
+				py[i] = (Y + i * dY) * r;
+			}
+			for (int i = 0, e = std::min(LANES, x1 - x); i < e; ++i)
+				set(x + i, y, int64_t(px[i]), int64_t(py[i]));
+			X += LANES * dX, Y += LANES * dY, W += LANES * dW;
+		}
+	}
+
+	return true;
+}
+
 DetectorResult SampleGrid(const BitMatrix& image, int width, int height, const ROIs& rois)
 {
 #ifdef PRINT_DEBUG
@@ -41,7 +111,12 @@ DetectorResult SampleGrid(const BitMatrix& image, int width, int height, const R
 	}
 
 	BitMatrix res(width, height);
-	for (auto&& [x0, x1, y0, y1, mod2Pix] : rois) {
+	for (auto&& roi : rois) {
+#ifndef PRINT_DEBUG
+		if (SampleROIFast(image, roi, res))
+			continue;
+#endif
+		auto&& [x0, x1, y0, y1, mod2Pix] = roi;
 		for (int y = y0; y < y1; ++y)
 			for (int x = x0; x < x1; ++x) {
 				auto p = mod2Pix(centered(PointI{x, y}));
@@ -8,6 +8,7 @@
 
 #include "BarcodeFormat.h"
 #include "BinaryBitmap.h"
+#include "ReadTimings.h"
 #include "ReaderOptions.h"
 #include "aztec/AZReader.h"
 #include "datamatrix/DMReader.h"
@@ -23,25 +24,29 @@ namespace ZXing {
 MultiFormatReader::MultiFormatReader(const ReaderOptions& opts) : _opts(opts)
 {
 	auto formats = opts.formats().empty() ? BarcodeFormat::Any : opts.formats();
+	auto add = [&](Reader* reader, BarcodeFormats readerFormats) {
+		_readers.emplace_back(reader);
+		_readerFormats.push_back(formats & readerFormats);
+	};
 
 	// Put linear readers upfront in "normal" mode
 	if (formats.testFlags(BarcodeFormat::LinearCodes) && !opts.tryHarder())
-		_readers.emplace_back(new OneD::Reader(opts));
+		add(new OneD::Reader(opts), BarcodeFormat::LinearCodes);
 
 	if (formats.testFlags(BarcodeFormat::QRCode | BarcodeFormat::MicroQRCode | BarcodeFormat::RMQRCode))
-		_readers.emplace_back(new QRCode::Reader(opts, true));
+		add(new QRCode::Reader(opts, true), BarcodeFormat::QRCode | BarcodeFormat::MicroQRCode | BarcodeFormat::RMQRCode);
 	if (formats.testFlag(BarcodeFormat::DataMatrix))
-		_readers.emplace_back(new DataMatrix::Reader(opts, true));
+		add(new DataMatrix::Reader(opts, true), BarcodeFormat::DataMatrix);
 	if (formats.testFlag(BarcodeFormat::Aztec))
-		_readers.emplace_back(new Aztec::Reader(opts, true));
+		add(new Aztec::Reader(opts, true), BarcodeFormat::Aztec);
 	if (formats.testFlag(BarcodeFormat::PDF417))
-		_readers.emplace_back(new Pdf417::Reader(opts));
+		add(new Pdf417::Reader(opts), BarcodeFormat::PDF417);
 	if (formats.testFlag(BarcodeFormat::MaxiCode))
-		_readers.emplace_back(new MaxiCode::Reader(opts));
+		add(new MaxiCode::Reader(opts), BarcodeFormat::MaxiCode);
 
 	// At end in "try harder" mode
 	if (formats.testFlags(BarcodeFormat::LinearCodes) && opts.tryHarder())
-		_readers.emplace_back(new OneD::Reader(opts));
+		add(new OneD::Reader(opts), BarcodeFormat::LinearCodes);
 }
 
 MultiFormatReader::~MultiFormatReader() = default;
@@ -49,9 +54,14 @@ MultiFormatReader::~MultiFormatReader() = default;
 Barcode MultiFormatReader::read(const BinaryBitmap& image) const
 {
 	Barcode r;
-	for (const auto& reader : _readers) {
-		r = reader->decode(image);
-  		if (r.isValid())
+	for (size_t i = 0; i < _readers.size(); ++i) {
+		if (_opts.deadline().expired())
+			break;
+		auto start = ReadTimings::Clock::now();
+		r = _readers[i]->decode(image);
+		if (auto* timings = _opts.timings())
+			timings->addReader(_readerFormats[i], ReadTimings::Clock::now() - start);
+		if (r.isValid())
 			return r;
 	}
 	return _opts.returnErrors() ? r : Barcode();
@@ -61,10 +71,15 @@ Barcodes MultiFormatReader::readMultiple(const BinaryBitmap& image, int maxSymbo
 {
 	Barcodes res;
 
-	for (const auto& reader : _readers) {
-		if (image.inverted() && !reader->supportsInversion)
+	for (size_t i = 0; i < _readers.size(); ++i) {
+		if (_opts.deadline().expired())
+			break;
+		if (image.inverted() && !_readers[i]->supportsInversion)
 			continue;
-		auto r = reader->decode(image, maxSymbols);
+		auto start = ReadTimings::Clock::now();
+		auto r = _readers[i]->decode(image, maxSymbols);
+		if (auto* timings = _opts.timings())
+			timings->addReader(_readerFormats[i], ReadTimings::Clock::now() - start);
 		if (!_opts.returnErrors()) {
 #ifdef __cpp_lib_erase_if
 			std::erase_if(r, [](auto&& s) { return !s.isValid(); });
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Barcode.h"
+#include "BarcodeFormat.h"
 
 #include <vector>
 #include <memory>
@@ -31,6 +32,7 @@ public:
 
 private:
 	std::vector<std::unique_ptr<Reader>> _readers;
+	std::vector<BarcodeFormats> _readerFormats; // the enabled formats handled by each reader (for ReadTimings)
 	const ReaderOptions& _opts;
 };
 
@@ -0,0 +1,52 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace ZXing {
+
+/// Returns maxThreads if it is > 0, otherwise the number of available cores (at least 1)
+inline int ThreadCount(int maxThreads)
+{
+	return maxThreads > 0 ? maxThreads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+/**
+ * Calls f(i) for every i in [0, n), distributed over up to ThreadCount(maxThreads) threads.
+ * The calling thread takes part in the work and the function returns after all calls finished.
+ * The order in which the indices are processed is unspecified, so f has to store its result per index.
+ */
+template <typename F>
+void ParallelFor(int n, int maxThreads, F&& f)
+{
+	int nbThreads = std::min(ThreadCount(maxThreads), n);
+	if (nbThreads <= 1) {
+		for (int i = 0; i < n; ++i)
+			f(i);
+		return;
+	}
+
+	std::atomic<int> next = 0;
+	auto worker = [&] {
+		for (int i; (i = next++) < n;)
+			f(i);
+	};
+
+	std::vector<std::future<void>> workers;
+	workers.reserve(nbThreads - 1);
+	for (int t = 1; t < nbThreads; ++t)
+		workers.push_back(std::async(std::launch::async, worker));
+	worker();
+	for (auto& w : workers)
+		w.get();
+}
+
+} // ZXing
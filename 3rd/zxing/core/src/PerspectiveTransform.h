@@ -10,6 +10,8 @@
 #include "Point.h"
 #include "Quadrilateral.h"
 
+#include <array>
+
 namespace ZXing {
 
 /**
@@ -41,6 +43,13 @@ public:
 	/// Project from the destination space (grid of modules) into the image space (bit matrix)
 	PointF operator()(PointF p) const;
 
+	/// Homogeneous coordinates {x, y, w} of the projection of p, i.e. operator()(p) == {x / w, y / w}.
+	/// They are linear in p, which allows to step through a grid with additions only.
+	std::array<value_t, 3> homogeneous(PointF p) const
+	{
+		return {a11 * p.x + a21 * p.y + a31, a12 * p.x + a22 * p.y + a32, a13 * p.x + a23 * p.y + a33};
+	}
+
 	bool isValid() const { return !std::isnan(a33); }
 };
 
@@ -0,0 +1,156 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Prescreen.h"
+
+#include "ZXAlgorithms.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+namespace ZXing {
+
+static constexpr int MAX_SAMPLED_SIZE  = 480; // longer side of the sampled image
+static constexpr int CELL_SIZE         = 8;   // cell size in sampled pixels
+static constexpr int MIN_EDGE_STRENGTH = 32;  // minimal |dx| + |dy| (central differences) of an edge pixel
+static constexpr int MIN_EDGE_COUNT    = 20;  // minimal number of edge pixels in a cell, a single straight edge yields ~16
+static constexpr int MIN_CELL_COUNT    = 2;   // minimal number of connected candidate cells in a region
+static constexpr int MIN_MARGIN        = 32;  // minimal margin in image pixels added around a region (quiet zones)
+
+struct CellStats
+{
+	std::array<uint16_t, 8> orientations = {}; // histogram over [0, 180) degree in 22.5 degree wide bins
+	uint16_t edges = 0;
+
+	bool isCandidate() const
+	{
+		if (edges < MIN_EDGE_COUNT)
+			return false;
+		// the edges of a symbol are aligned to one (linear) or two orthogonal (matrix) directions. Sum up two adjacent
+		// bins for both directions to get a 45 degree wide window each, unstructured content yields ~50% here.
+		int aligned = 0;
+		for (int i = 0; i < 4; ++i)
+			aligned = std::max(aligned, orientations[i] + orientations[i + 1] + orientations[i + 4] + orientations[(i + 5) % 8]);
+		return aligned * 10 >= edges * 7;
+	}
+};
+
+static int OrientationBin(int dx, int dy)
+{
+	// the sign of the gradient is irrelevant, fold it into the upper half plane
+	if (dy < 0 || (dy == 0 && dx < 0))
+		dx = -dx, dy = -dy;
+	int ax = std::abs(dx);
+	// tan(22.5) ~= 53/128 and tan(67.5) ~= 128/53
+	int octant = dy * 128 < ax * 53 ? 0 : dy < ax ? 1 : dy * 53 < ax * 128 ? 2 : 3;
+	return dx >= 0 ? octant : 7 - octant;
+}
+
+static bool Overlap(const ImageRegion& a, const ImageRegion& b)
+{
+	return a.left < b.left + b.width && b.left < a.left + a.width && a.top < b.top + b.height && b.top < a.top + a.height;
+}
+
+static ImageRegion Union(const ImageRegion& a, const ImageRegion& b)
+{
+	int left = std::min(a.left, b.left), top = std::min(a.top, b.top);
+	int right = std::max(a.left + a.width, b.left + b.width), bottom = std::max(a.top + a.height, b.top + b.height);
+	return {left, top, right - left, bottom - top};
+}
+
+std::vector<ImageRegion> FindCandidateRegions(const ImageView& iv)
+{
+	const ImageRegion all = {0, 0, iv.width(), iv.height()};
+
+	int step = (std::max(iv.width(), iv.height()) + MAX_SAMPLED_SIZE - 1) / MAX_SAMPLED_SIZE;
+	int width = iv.width() / step, height = iv.height() / step;
+	if (width < 4 * CELL_SIZE || height < 4 * CELL_SIZE)
+		return {all}; // too small to judge
+
+	// point sample the luminance (or the green channel of color images), this keeps the contrast of fine structures
+	std::vector<uint8_t> lum(width * height);
+	for (int y = 0; y < height; ++y) {
+		const uint8_t* src = iv.data(0, y * step) + GreenIndex(iv.format());
+		uint8_t* dst = lum.data() + y * width;
+		for (int x = 0; x < width; ++x)
+			dst[x] = src[x * step * iv.pixStride()];
+	}
+
+	int cellsX = (width + CELL_SIZE - 1) / CELL_SIZE, cellsY = (height + CELL_SIZE - 1) / CELL_SIZE;
+	std::vector<CellStats> cells(cellsX * cellsY);
+	for (int y = 1; y < height - 1; ++y) {
+		const uint8_t* row = lum.data() + y * width;
+		CellStats* cellRow = cells.data() + (y / CELL_SIZE) * cellsX;
+		for (int x = 1; x < width - 1; ++x) {
+			int dx = row[x + 1] - row[x - 1];
+			int dy = row[x + width] - row[x - width];
+			if (std::abs(dx) + std::abs(dy) < MIN_EDGE_STRENGTH)
+				continue;
+			auto& cell = cellRow[x / CELL_SIZE];
+			++cell.edges;
+			++cell.orientations[OrientationBin(dx, dy)];
+		}
+	}
+
+	std::vector<uint8_t> candidates(cells.size());
+	for (size_t i = 0; i < cells.size(); ++i)
+		candidates[i] = cells[i].isCandidate();
+
+	// collect the bounding boxes of 8-connected candidate cells
+	std::vector<ImageRegion> res;
+	std::vector<int> stack;
+	int margin = std::max(2 * CELL_SIZE * step, MIN_MARGIN);
+	for (int start = 0; start < Size(candidates); ++start) {
+		if (!candidates[start])
+			continue;
+		int x0 = start % cellsX, x1 = x0, y0 = start / cellsX, y1 = y0, count = 0;
+		candidates[start] = 0;
+		stack.push_back(start);
+		while (!stack.empty()) {
+			int i = stack.back(), cx = i % cellsX, cy = i / cellsX;
+			stack.pop_back();
+			++count;
+			x0 = std::min(x0, cx), x1 = std::max(x1, cx), y0 = std::min(y0, cy), y1 = std::max(y1, cy);
+			for (int ny = std::max(cy - 1, 0); ny <= std::min(cy + 1, cellsY - 1); ++ny)
+				for (int nx = std::max(cx - 1, 0); nx <= std::min(cx + 1, cellsX - 1); ++nx)
+					if (candidates[ny * cellsX + nx]) {
+						candidates[ny * cellsX + nx] = 0;
+						stack.push_back(ny * cellsX + nx);
+					}
+		}
+		if (count < MIN_CELL_COUNT)
+			continue;
+
+		int left = std::max(x0 * CELL_SIZE * step - margin, 0);
+		int top = std::max(y0 * CELL_SIZE * step - margin, 0);
+		int right = std::min((x1 + 1) * CELL_SIZE * step + margin, iv.width());
+		int bottom = std::min((y1 + 1) * CELL_SIZE * step + margin, iv.height());
+		res.push_back({left, top, right - left, bottom - top});
+	}
+
+	// merge overlapping regions so no symbol gets scanned twice
+	for (bool merged = true; merged;) {
+		merged = false;
+		for (size_t i = 0; i < res.size() && !merged; ++i)
+			for (size_t j = i + 1; j < res.size() && !merged; ++j)
+				if (Overlap(res[i], res[j])) {
+					res[i] = Union(res[i], res[j]);
+					res.erase(res.begin() + j);
+					merged = true;
+				}
+	}
+
+	int64_t area = 0;
+	for (auto& r : res)
+		area += r.area();
+	if (area * 2 > all.area())
+		return {all};
+
+	return res;
+}
+
+} // ZXing
@@ -0,0 +1,41 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "ImageView.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ZXing {
+
+struct ImageRegion
+{
+	int left = 0, top = 0, width = 0, height = 0;
+
+	int64_t area() const noexcept { return int64_t(width) * height; }
+	bool operator==(const ImageRegion& o) const noexcept
+	{
+		return left == o.left && top == o.top && width == o.width && height == o.height;
+	}
+};
+
+/**
+ * Cheap test for barcode-like structure in an image.
+ *
+ * The image is point sampled down to at most 480 pixels along its longer side. On that grid an edge density and
+ * gradient orientation histogram is collected per 8x8 cell. A cell is considered a candidate if it is densely
+ * populated by edges that are predominantly aligned along one or two orthogonal directions, as is the case for
+ * linear and matrix codes but not for smooth or unstructured content. Connected candidate cells are merged into
+ * regions.
+ *
+ * @return empty list if no candidate region was found, otherwise the non-overlapping bounding boxes (in image
+ *   coordinates, including a margin for quiet zones) of the candidate regions. If those cover most of the image,
+ *   a single region spanning the whole image is returned.
+ */
+std::vector<ImageRegion> FindCandidateRegions(const ImageView& iv);
+
+} // ZXing
@@ -14,6 +14,8 @@
 #include "HybridBinarizer.h"
 #include "MultiFormatReader.h"
 #include "Pattern.h"
+#include "Prescreen.h"
+#include "ReadTimings.h"
 #include "ThresholdBinarizer.h"
 #endif
 
@@ -139,6 +141,31 @@ std::unique_ptr<BinaryBitmap> CreateBitmap(ZXing::Binarizer binarizer, const Ima
 	return {}; // silence gcc warning
 }
 
+static Barcodes ReadBarcodesInRegions(const ImageView& iv, const std::vector<ImageRegion>& regions, const ReaderOptions& opts)
+{
+	Barcodes res;
+	int maxSymbols = opts.maxNumberOfSymbols() ? opts.maxNumberOfSymbols() : INT_MAX;
+	for (auto& region : regions) {
+		if (opts.deadline().expired())
+			break;
+		auto regionOpts = ReaderOptions(opts).setPrescreen(false).setMaxNumberOfSymbols(std::min(maxSymbols, 0xff));
+		auto rs = ReadBarcodes(iv.cropped(region.left, region.top, region.width, region.height), regionOpts);
+		for (auto& r : rs) {
+			auto position = r.position();
+			for (auto& p : position)
+				p += PointI(region.left, region.top);
+			r.setPosition(position);
+			if (!Contains(res, r)) {
+				res.push_back(std::move(r));
+				--maxSymbols;
+			}
+		}
+		if (maxSymbols <= 0)
+			break;
+	}
+	return res;
+}
+
 Barcode ReadBarcode(const ImageView& _iv, const ReaderOptions& opts)
 {
 	return FirstOrDefault(ReadBarcodes(_iv, ReaderOptions(opts).setMaxNumberOfSymbols(1)));
@@ -152,8 +179,25 @@ Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
 	if (!_iv.data() || _iv.width() * _iv.height() == 0)
 		throw std::invalid_argument("ImageView is null/empty");
 
+	auto* timings = opts.timings();
+
 	LumImage lum;
-	ImageView iv = SetupLumImageView(_iv, lum, opts);
+	ImageView iv = [&] {
+		ScopedTiming timing(timings ? &timings->lumExtraction : nullptr);
+		return SetupLumImageView(_iv, lum, opts);
+	}();
+
+	if (opts.prescreen() && !opts.isPure()) {
+		auto regions = [&] {
+			ScopedTiming timing(timings ? &timings->prescreen : nullptr);
+			return FindCandidateRegions(iv);
+		}();
+		if (regions.empty())
+			return {};
+		if (regions.size() > 1 || regions.front().area() < int64_t(iv.width()) * iv.height())
+			return ReadBarcodesInRegions(iv, regions, opts);
+	}
+
 	MultiFormatReader reader(opts);
 
 	if (opts.isPure())
@@ -168,12 +212,23 @@ Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
 		closedReader = std::make_unique<MultiFormatReader>(closedOptions);
 	}
 #endif
-	LumImagePyramid pyramid(iv, opts.downscaleThreshold() * opts.tryDownscale(), opts.downscaleFactor());
+	LumImagePyramid pyramid = [&] {
+		ScopedTiming timing(timings ? &timings->pyramid : nullptr);
+		return LumImagePyramid(iv, opts.downscaleThreshold() * opts.tryDownscale(), opts.downscaleFactor());
+	}();
+	// the readers binarize lazily, compute the bit matrix upfront to tell the two apart
+	bool timeBinarizer = timings && opts.hasFormat(BarcodeFormat::MatrixCodes);
 
 	Barcodes res;
 	int maxSymbols = opts.maxNumberOfSymbols() ? opts.maxNumberOfSymbols() : INT_MAX;
 	for (auto&& iv : pyramid.layers) {
+		if (opts.deadline().expired())
+			break;
 		auto bitmap = CreateBitmap(opts.binarizer(), iv);
+		if (timeBinarizer) {
+			ScopedTiming timing(&timings->binarize);
+			bitmap->getBitMatrix();
+		}
 		for (int close = 0; close <= (closedReader ? 1 : 0); ++close) {
 			if (close) {
 				// if we already inverted the image in the first round, we need to undo that first
@@ -184,6 +239,8 @@ Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
 
 			// TODO: check if closing after invert would be beneficial
 			for (int invert = 0; invert <= static_cast<int>(opts.tryInvert() && !close); ++invert) {
+				if (opts.deadline().expired())
+					return res;
 				if (invert)
 					bitmap->invert();
 				auto rs = (close ? *closedReader : reader).readMultiple(*bitmap, maxSymbols);
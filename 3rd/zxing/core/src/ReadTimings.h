@@ -0,0 +1,95 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BarcodeFormat.h"
+
+#include <chrono>
+#include <vector>
+
+namespace ZXing {
+
+/**
+ * Time spent in the individual stages of ReadBarcodes. Pass a pointer to an instance via ReaderOptions::setTimings
+ * to have the durations of every following call accumulated into it. The instance is not synchronized, so use one
+ * per concurrently running call.
+ */
+struct ReadTimings
+{
+	using Clock = std::chrono::steady_clock;
+	using Duration = Clock::duration;
+
+	/// The stages inside the QRCode and DataMatrix readers. Candidates decoded concurrently (see
+	/// ReaderOptions::maxThreads) are summed up, so the stages may add up to more than Reader::time.
+	struct Stages
+	{
+		Duration detect{};          ///< finder pattern search, including the grid sampling for DataMatrix
+		Duration sample{};          ///< grid sampling of the QRCode candidates
+		Duration decode{};          ///< codeword extraction, error correction and bit stream decoding
+		Duration errorCorrection{}; ///< the Reed-Solomon part of decode
+
+		Stages& operator+=(const Stages& other)
+		{
+			detect += other.detect;
+			sample += other.sample;
+			decode += other.decode;
+			errorCorrection += other.errorCorrection;
+			return *this;
+		}
+	};
+
+	struct Reader
+	{
+		BarcodeFormats formats; ///< the enabled formats handled by this reader, e.g. all linear ones for the 1D reader
+		Duration time{};        ///< detection, sampling, error correction and decoding
+		int calls = 0;
+		Stages stages;          ///< only measured by the QRCode and DataMatrix readers
+	};
+
+	Duration lumExtraction{}; ///< conversion of the input image to 8-bit luminance
+	Duration prescreen{};     ///< search for candidate regions (see ReaderOptions::prescreen)
+	Duration pyramid{};       ///< computation of the downscaled layers
+	Duration binarize{};      ///< computation of the bit matrices (only measured separately if matrix codes are enabled)
+	std::vector<Reader> readers;
+
+	Reader& reader(BarcodeFormats formats)
+	{
+		auto i = readers.begin();
+		while (i != readers.end() && !(i->formats == formats))
+			++i;
+		if (i == readers.end())
+			i = readers.insert(i, Reader{formats});
+		return *i;
+	}
+
+	void addReader(BarcodeFormats formats, Duration time)
+	{
+		auto& r = reader(formats);
+		r.time += time;
+		++r.calls;
+	}
+};
+
+/// Adds the time between construction and destruction to *target, does nothing if target is null
+class ScopedTiming
+{
+	ReadTimings::Duration* _target;
+	ReadTimings::Clock::time_point _start;
+
+public:
+	explicit ScopedTiming(ReadTimings::Duration* target)
+		: _target(target), _start(target ? ReadTimings::Clock::now() : ReadTimings::Clock::time_point())
+	{}
+	ScopedTiming(const ScopedTiming&) = delete;
+	ScopedTiming& operator=(const ScopedTiming&) = delete;
+	~ScopedTiming()
+	{
+		if (_target)
+			*_target += ReadTimings::Clock::now() - _start;
+	}
+};
+
+} // ZXing
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "ReaderOptions.h"
+#include "ReadTimings.h"
 #include "Barcode.h"
 
 namespace ZXing {
@@ -19,6 +20,15 @@ class Reader
 protected:
 	const ReaderOptions& _opts;
 
+	/// Adds the stage timings of one decode call to the ReadTimings entry of this reader (see MultiFormatReader)
+	void addStageTimings(BarcodeFormats readerFormats, const ReadTimings::Stages& stages) const
+	{
+		if (auto* timings = _opts.timings()) {
+			auto formats = _opts.formats().empty() ? BarcodeFormat::Any : _opts.formats();
+			timings->reader(formats & readerFormats).stages += stages;
+		}
+	}
+
 public:
 	const bool supportsInversion;
 
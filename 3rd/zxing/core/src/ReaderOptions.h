@@ -9,12 +9,15 @@
 
 #include "BarcodeFormat.h"
 #include "CharacterSet.h"
+#include "Deadline.h"
 
 #include <string_view>
 #include <utility>
 
 namespace ZXing {
 
+struct ReadTimings;
+
 /**
  * @brief The Binarizer enum
  *
@@ -58,6 +61,8 @@ class ReaderOptions
 	bool _validateITFCheckSum      : 1;
 	bool _returnCodabarStartEnd    : 1;
 	bool _returnErrors             : 1;
+	bool _prescreen                : 1;
+	bool _detectAll                : 1;
 	uint8_t _downscaleFactor       : 3;
 	EanAddOnSymbol _eanAddOnSymbol : 2;
 	Binarizer _binarizer           : 2;
@@ -69,8 +74,11 @@ class ReaderOptions
 
 	uint8_t _minLineCount        = 2;
 	uint8_t _maxNumberOfSymbols  = 0xff;
+	uint8_t _maxThreads          = 0;
 	uint16_t _downscaleThreshold = 500;
 	BarcodeFormats _formats      = BarcodeFormat::None;
+	Deadline _deadline;
+	ReadTimings* _timings        = nullptr;
 
 public:
 	// bitfields don't get default initialized to 0 before c++20
@@ -85,6 +93,8 @@ public:
 		  _validateITFCheckSum(0),
 		  _returnCodabarStartEnd(1),
 		  _returnErrors(0),
+		  _prescreen(0),
+		  _detectAll(0),
 		  _downscaleFactor(3),
 		  _eanAddOnSymbol(EanAddOnSymbol::Ignore),
 		  _binarizer(Binarizer::LocalAverage),
@@ -121,6 +131,14 @@ public:
 	ZX_PROPERTY(bool, tryDenoise, setTryDenoise)
 #endif
 
+	/// Skip images (or parts thereof) that show no barcode-like structure in a quick edge density/orientation pre-screen
+	ZX_PROPERTY(bool, prescreen, setPrescreen)
+
+	/// Search the whole image for all DataMatrix symbols at once instead of one after the other, meant for images densely
+	/// covered with symbols (e.g. sample trays); only used when looking for more than one symbol in a non-pure image
+	// WARNING: this API is experimental and may change/disappear
+	ZX_PROPERTY(bool, detectAll, setDetectAll)
+
 	/// Binarizer to use internally when using the ReadBarcode function
 	ZX_PROPERTY(Binarizer, binarizer, setBinarizer)
 
@@ -141,6 +159,15 @@ public:
 	/// The maximum number of symbols (barcodes) to detect / look for in the image with ReadBarcodes
 	ZX_PROPERTY(uint8_t, maxNumberOfSymbols, setMaxNumberOfSymbols)
 
+	/// The maximum number of threads used to search and decode multiple symbols in one image, 0 means one per core
+	ZX_PROPERTY(uint8_t, maxThreads, setMaxThreads)
+
+	/// Stop searching when the deadline expires (or gets cancelled) and return what has been found so far
+	ZX_PROPERTY(Deadline, deadline, setDeadline)
+
+	/// If not null, the time spent in the individual stages of ReadBarcodes is accumulated into the given ReadTimings
+	ZX_PROPERTY(ReadTimings*, timings, setTimings)
+
 	/// Enable the heuristic to detect and decode "full ASCII"/extended Code39 symbols
 	ZX_PROPERTY(bool, tryCode39ExtendedMode, setTryCode39ExtendedMode)
 
@@ -7,15 +7,29 @@
 
 #include "TextDecoder.h"
 
+#include "Utf.h"
 #include "ZXAlgorithms.h"
 #include "libzueci/zueci.h"
 
 #include <cassert>
 #include <stdexcept>
+#include <string_view>
 
 namespace ZXing {
 
-std::string BytesToUtf8(ByteView bytes, ECI eci)
+static bool IsAsciiCompatible(ECI eci)
+{
+	switch (eci) {
+	case ECI::UTF16BE:
+	case ECI::UTF16LE:
+	case ECI::UTF32BE:
+	case ECI::UTF32LE:
+	case ECI::ISO646_Inv: return false;
+	default: return true;
+	}
+}
+
+void AppendUtf8(std::string& out, ByteView bytes, ECI eci)
 {
 	constexpr unsigned int replacement = 0xFFFD;
 	constexpr unsigned int flags = ZUECI_FLAG_SB_STRAIGHT_THRU | ZUECI_FLAG_SJIS_STRAIGHT_THRU;
@@ -24,19 +38,32 @@ std::string BytesToUtf8(ByteView bytes, ECI eci)
 	if (eci == ECI::Unknown)
 		eci = ECI::Binary;
 
+	// the vast majority of symbols contain plain ASCII, which all but a few encodings map 1:1
+	auto str = std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	if ((IsAsciiCompatible(eci) && IsAscii(str)) || (eci == ECI::UTF8 && IsValidUtf8(str))) {
+		out.append(str);
+		return;
+	}
+
 	int error_number = zueci_dest_len_utf8(ToInt(eci), bytes.data(), bytes.size(), replacement, flags, &utf8_len);
 	if (error_number >= ZUECI_ERROR)
 		throw std::runtime_error("zueci_dest_len_utf8 failed");
 
-	std::string utf8(utf8_len, 0);
+	auto pos = out.size();
+	out.resize(pos + utf8_len);
 
 	error_number = zueci_eci_to_utf8(ToInt(eci), bytes.data(), bytes.size(), replacement, flags,
-									 reinterpret_cast<uint8_t*>(utf8.data()), &utf8_len);
+									 reinterpret_cast<uint8_t*>(out.data() + pos), &utf8_len);
 	if (error_number >= ZUECI_ERROR)
 		throw std::runtime_error("zueci_eci_to_utf8 failed");
 
-	assert(Size(utf8) == utf8_len);
+	assert(out.size() == pos + utf8_len);
+}
 
+std::string BytesToUtf8(ByteView bytes, ECI eci)
+{
+	std::string utf8;
+	AppendUtf8(utf8, bytes, eci);
 	return utf8;
 }
 
@@ -13,6 +13,12 @@
 
 namespace ZXing {
 
+/**
+ * Append the bytes, transcoded from the given encoding to UTF-8, to out. ASCII (in ASCII compatible encodings) and
+ * valid UTF-8 input is copied without transcoding.
+ */
+void AppendUtf8(std::string& out, ByteView bytes, ECI eci);
+
 std::string BytesToUtf8(ByteView bytes, ECI eci);
 
 inline std::string BytesToUtf8(ByteView bytes, CharacterSet cs)
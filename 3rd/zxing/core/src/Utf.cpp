@@ -10,8 +10,10 @@
 #include "ZXTestSupport.h"
 #include "ZXAlgorithms.h"
 
-#include <iomanip>
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <iomanip>
 #include <sstream>
 
 #if __cplusplus <= 201703L
@@ -134,6 +136,70 @@ std::wstring FromUtf8(std::u8string_view utf8)
 }
 #endif
 
+// Number of leading ASCII bytes. Tests 8 bytes at once, which is plain C++ the compiler can vectorize.
+static size_t AsciiPrefixLength(const char* str, size_t size)
+{
+	size_t i = 0;
+	for (uint64_t block; i + 8 <= size; i += 8) {
+		std::memcpy(&block, str + i, 8);
+		if (block & 0x8080808080808080ull)
+			break;
+	}
+	while (i < size && !(str[i] & 0x80))
+		++i;
+	return i;
+}
+
+bool IsAscii(std::string_view str)
+{
+	return AsciiPrefixLength(str.data(), str.size()) == str.size();
+}
+
+bool IsValidUtf8(std::string_view str)
+{
+	char32_t codePoint = 0;
+	state_t state = kAccepted;
+
+	for (size_t i = 0; i < str.size();) {
+		if (state == kAccepted) {
+			i += AsciiPrefixLength(str.data() + i, str.size() - i);
+			if (i == str.size())
+				break;
+		}
+		if (Utf8Decode(static_cast<char8_t>(str[i++]), state, codePoint) == kRejected)
+			return false;
+	}
+
+	return state == kAccepted;
+}
+
+size_t Utf8ToUtf16(std::string_view utf8, char16_t* out)
+{
+	char16_t* begin = out;
+	char32_t codePoint = 0;
+	state_t state = kAccepted;
+
+	for (size_t i = 0; i < utf8.size();) {
+		if (state == kAccepted) {
+			auto n = AsciiPrefixLength(utf8.data() + i, utf8.size() - i);
+			out = std::copy_n(utf8.data() + i, n, out);
+			if ((i += n) == utf8.size())
+				break;
+		}
+		if (Utf8Decode(static_cast<char8_t>(utf8[i++]), state, codePoint) != kAccepted)
+			continue;
+
+		if (codePoint > 0xffff) { // surrogate pair
+			*out++ = narrow_cast<char16_t>(0xd7c0 + (codePoint >> 10));
+			*out++ = narrow_cast<char16_t>(0xdc00 + (codePoint & 0x3ff));
+		} else {
+			*out++ = narrow_cast<char16_t>(codePoint);
+		}
+	}
+
+	return out - begin;
+}
+
 // Count the number of bytes required to store given code points in UTF-8.
 static size_t Utf8CountBytes(std::wstring_view str)
 {
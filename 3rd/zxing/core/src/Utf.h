@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 
@@ -16,6 +17,15 @@ std::wstring FromUtf8(std::string_view utf8);
 std::wstring FromUtf8(std::u8string_view utf8);
 #endif
 
+bool IsAscii(std::string_view str);
+bool IsValidUtf8(std::string_view str);
+
+/**
+ * Convert valid UTF-8 into UTF-16 code units written to out, which has to have room for utf8.size() code units.
+ * @return number of code units written
+ */
+size_t Utf8ToUtf16(std::string_view utf8, char16_t* out);
+
 std::wstring EscapeNonGraphical(std::wstring_view str);
 std::string EscapeNonGraphical(std::string_view utf8);
 
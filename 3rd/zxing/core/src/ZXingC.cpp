@@ -285,9 +285,11 @@ ZX_PROPERTY(bool, tryDownscale, TryDownscale)
 	ZX_PROPERTY(bool, tryDenoise, TryDenoise)
 #endif
 ZX_PROPERTY(bool, isPure, IsPure)
+ZX_PROPERTY(bool, prescreen, Prescreen)
 ZX_PROPERTY(bool, returnErrors, ReturnErrors)
 ZX_PROPERTY(int, minLineCount, MinLineCount)
 ZX_PROPERTY(int, maxNumberOfSymbols, MaxNumberOfSymbols)
+ZX_PROPERTY(int, maxThreads, MaxThreads)
 
 #undef ZX_PROPERTY
 
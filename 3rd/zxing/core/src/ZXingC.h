@@ -237,6 +237,7 @@ void ZXing_ReaderOptions_setTryDownscale(ZXing_ReaderOptions* opts, bool tryDown
 	void ZXing_ReaderOptions_setTryDenoise(ZXing_ReaderOptions* opts, bool tryDenoise);
 #endif
 void ZXing_ReaderOptions_setIsPure(ZXing_ReaderOptions* opts, bool isPure);
+void ZXing_ReaderOptions_setPrescreen(ZXing_ReaderOptions* opts, bool prescreen);
 void ZXing_ReaderOptions_setReturnErrors(ZXing_ReaderOptions* opts, bool returnErrors);
 void ZXing_ReaderOptions_setFormats(ZXing_ReaderOptions* opts, ZXing_BarcodeFormats formats);
 void ZXing_ReaderOptions_setBinarizer(ZXing_ReaderOptions* opts, ZXing_Binarizer binarizer);
@@ -244,6 +245,7 @@ void ZXing_ReaderOptions_setEanAddOnSymbol(ZXing_ReaderOptions* opts, ZXing_EanA
 void ZXing_ReaderOptions_setTextMode(ZXing_ReaderOptions* opts, ZXing_TextMode textMode);
 void ZXing_ReaderOptions_setMinLineCount(ZXing_ReaderOptions* opts, int n);
 void ZXing_ReaderOptions_setMaxNumberOfSymbols(ZXing_ReaderOptions* opts, int n);
+void ZXing_ReaderOptions_setMaxThreads(ZXing_ReaderOptions* opts, int n);
 
 bool ZXing_ReaderOptions_getTryHarder(const ZXing_ReaderOptions* opts);
 bool ZXing_ReaderOptions_getTryRotate(const ZXing_ReaderOptions* opts);
@@ -253,6 +255,7 @@ bool ZXing_ReaderOptions_getTryDownscale(const ZXing_ReaderOptions* opts);
 	bool ZXing_ReaderOptions_getTryDenoise(const ZXing_ReaderOptions* opts);
 #endif
 bool ZXing_ReaderOptions_getIsPure(const ZXing_ReaderOptions* opts);
+bool ZXing_ReaderOptions_getPrescreen(const ZXing_ReaderOptions* opts);
 bool ZXing_ReaderOptions_getReturnErrors(const ZXing_ReaderOptions* opts);
 ZXing_BarcodeFormats ZXing_ReaderOptions_getFormats(const ZXing_ReaderOptions* opts);
 ZXing_Binarizer ZXing_ReaderOptions_getBinarizer(const ZXing_ReaderOptions* opts);
@@ -260,6 +263,7 @@ ZXing_EanAddOnSymbol ZXing_ReaderOptions_getEanAddOnSymbol(const ZXing_ReaderOpt
 ZXing_TextMode ZXing_ReaderOptions_getTextMode(const ZXing_ReaderOptions* opts);
 int ZXing_ReaderOptions_getMinLineCount(const ZXing_ReaderOptions* opts);
 int ZXing_ReaderOptions_getMaxNumberOfSymbols(const ZXing_ReaderOptions* opts);
+int ZXing_ReaderOptions_getMaxThreads(const ZXing_ReaderOptions* opts);
 
 /*
  * ZXing/ReadBarcode.h
@@ -391,7 +391,7 @@ CorrectErrors(ByteArray& codewordBytes, int numDataCodewords)
 	return true;
 }
 
-static DecoderResult DoDecode(const BitMatrix& bits)
+static DecoderResult DoDecode(const BitMatrix& bits, ReadTimings::Stages* stages)
 {
 	// Construct a parser and read version, error-correction level
 	const Version* version = VersionForDimensionsOf(bits);
@@ -417,7 +417,11 @@ retry:
 	const int dataBlocksCount = Size(dataBlocks);
 	for (int j = 0; j < dataBlocksCount; j++) {
 		auto& [numDataCodewords, codewords] = dataBlocks[j];
-		if (!CorrectErrors(codewords, numDataCodewords)) {
+		bool corrected = [&] {
+			ScopedTiming timing(stages ? &stages->errorCorrection : nullptr);
+			return CorrectErrors(codewords, numDataCodewords);
+		}();
+		if (!corrected) {
 			if(version->versionNumber == 24 && !fix259) {
 				fix259 = true;
 				goto retry;
@@ -453,16 +457,18 @@ static BitMatrix FlippedL(const BitMatrix& bits)
 	return res;
 }
 
-DecoderResult Decode(const BitMatrix& bits)
+DecoderResult Decode(const BitMatrix& bits, ReadTimings::Stages* stages)
 {
-	auto res = DoDecode(bits);
+	ScopedTiming timing(stages ? &stages->decode : nullptr);
+
+	auto res = DoDecode(bits, stages);
 	if (res.isValid())
 		return res;
 
 	//TODO:
 	// * unify bit mirroring helper code with QRReader?
 	// * rectangular symbols with the a size of 8 x Y are not supported a.t.m.
-	if (auto mirroredRes = DoDecode(FlippedL(bits)); mirroredRes.error().type() != Error::Checksum) {
+	if (auto mirroredRes = DoDecode(FlippedL(bits), stages); mirroredRes.error().type() != Error::Checksum) {
 		mirroredRes.setIsMirrored(true);
 		return mirroredRes;
 	}
@@ -9,11 +9,12 @@
 
 #include "BitMatrix.h"
 #include "BitMatrixCursor.h"
-#include "ByteMatrix.h"
 #include "DetectorResult.h"
 #include "GridSampler.h"
 #include "LogMatrix.h"
+#include "Parallel.h"
 #include "Point.h"
+#include "Quadrilateral.h"
 #include "RegressionLine.h"
 #include "ResultPoint.h"
 #include "Scope.h"
@@ -25,6 +26,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <map>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -515,6 +517,51 @@ public:
 	}
 };
 
+/**
+* A log of the edge pixels (and the trace state) a tracer already passed by, used to prevent a later trace from doing
+* the same work twice. The memory is only allocated for the tiles of the image that are actually touched by a trace,
+* which is a small fraction of the image even when scanning all of it.
+*/
+class TraceHistory
+{
+	static constexpr int TILE_SIZE = 64;
+
+	int _tilesX = 0;
+	std::vector<std::unique_ptr<uint8_t[]>> _tiles;
+
+	static int offset(PointI p) { return (p.y % TILE_SIZE) * TILE_SIZE + p.x % TILE_SIZE; }
+	int tileIndex(PointI p) const { return (p.y / TILE_SIZE) * _tilesX + p.x / TILE_SIZE; }
+	const std::unique_ptr<uint8_t[]>& tile(PointI p) const { return _tiles[tileIndex(p)]; }
+	std::unique_ptr<uint8_t[]>& tile(PointI p) { return _tiles[tileIndex(p)]; }
+
+public:
+	TraceHistory() = default;
+	TraceHistory(int width, int height)
+		: _tilesX((width + TILE_SIZE - 1) / TILE_SIZE), _tiles(_tilesX * ((height + TILE_SIZE - 1) / TILE_SIZE))
+	{}
+
+	int get(PointI p) const
+	{
+		auto& t = tile(p);
+		return t ? t[offset(p)] : 0;
+	}
+
+	void set(PointI p, int state)
+	{
+		auto& t = tile(p);
+		if (!t)
+			t = std::make_unique<uint8_t[]>(TILE_SIZE * TILE_SIZE);
+		t[offset(p)] = narrow_cast<uint8_t>(state);
+	}
+
+	void clear()
+	{
+		for (auto& t : _tiles)
+			if (t)
+				std::fill_n(t.get(), TILE_SIZE * TILE_SIZE, 0);
+	}
+};
+
 class EdgeTracer : public BitMatrixCursorF
 {
 	enum class StepResult { FOUND, OPEN_END, CLOSED_END };
@@ -565,7 +612,7 @@ class EdgeTracer : public BitMatrixCursorF
 	}
 
 public:
-	ByteMatrix* history = nullptr;
+	TraceHistory* history = nullptr;
 	int state = 0;
 
 	using BitMatrixCursorF::BitMatrixCursor;
@@ -717,142 +764,148 @@ public:
 	}
 };
 
-static DetectorResult Scan(EdgeTracer& startTracer, std::array<DMRegressionLine, 4>& lines)
+/**
+* Try to trace an L-shaped finder pattern (and the b/w pattern at the top and right) starting from the tracer's
+* position, which is supposed to be on the white side of the outer edge of the left leg, looking at it.
+*/
+static DetectorResult ScanL(const EdgeTracer& startTracer, std::array<DMRegressionLine, 4>& lines)
 {
-	while (startTracer.moveToNextWhiteAfterBlack()) {
-		log(startTracer.p);
-
-		PointF tl, bl, br, tr;
-		auto& [lineL, lineB, lineR, lineT] = lines;
+	PointF tl, bl, br, tr;
+	auto& [lineL, lineB, lineR, lineT] = lines;
 
-		for (auto& l : lines)
-			l.reset();
+	for (auto& l : lines)
+		l.reset();
 
 #ifdef PRINT_DEBUG
-		SCOPE_EXIT([&] {
-			for (auto& l : lines)
-				log(l.points());
-		});
-# define CHECK(A) if (!(A)) { printf("broke at %d\n", __LINE__); continue; }
+	SCOPE_EXIT([&] {
+		for (auto& l : lines)
+			log(l.points());
+	});
+# define CHECK(A) if (!(A)) { printf("broke at %d\n", __LINE__); return {}; }
 #else
-# define CHECK(A) if(!(A)) continue
+# define CHECK(A) if(!(A)) return {}
 #endif
 
-		auto t = startTracer;
-		PointF up, right;
-
-		// follow left leg upwards
-		t.turnRight();
-		t.state = 1;
-		CHECK(t.traceLine(t.right(), lineL));
-		CHECK(t.traceCorner(t.right(), tl));
-		lineL.reverse();
-		auto tlTracer = t;
-
-		// follow left leg downwards
-		t = startTracer;
-		t.state = 1;
-		t.setDirection(tlTracer.right());
-		CHECK(t.traceLine(t.left(), lineL));
-
-		// check if lineL is L-shaped -> truncate the lower leg and set t to just before the corner
-		if (lineL.truncateIfLShape())
-			t.p = lineL.points().back();
-		t.updateDirectionFromOrigin(tl);
-		up = t.back();
-		CHECK(t.traceCorner(t.left(), bl));
-
-		// follow bottom leg right
-		t.state = 2;
-		CHECK(t.traceLine(t.left(), lineB));
-		t.updateDirectionFromOrigin(bl);
-		right = t.front();
-		CHECK(t.traceCorner(t.left(), br));
-
-		auto lenL = distance(tl, bl) - 1;
-		auto lenB = distance(bl, br) - 1;
-		CHECK(lenL >= 8 && lenB >= 10 && lenB >= lenL / 4 && lenB <= lenL * 18);
-
-		auto maxStepSize = static_cast<int>(lenB / 5 + 1); // datamatrix bottom dim is at least 10
-
-		// at this point we found a plausible L-shape and are now looking for the b/w pattern at the top and right:
-		// follow top row right 'half way' (at least 4 gaps), see traceGaps
-		tlTracer.setDirection(right);
-		CHECK(tlTracer.traceGaps(tlTracer.right(), lineT, maxStepSize, {}, lenB / 2));
-
-		maxStepSize = std::min(lineT.length() / 3, static_cast<int>(lenL / 5)) * 2;
-
-		// follow up until we reach the top line
-		t.setDirection(up);
-		t.state = 3;
-		CHECK(t.traceGaps(t.left(), lineR, maxStepSize, lineT));
-		CHECK(t.traceCorner(t.left(), tr));
-
-		auto lenT = distance(tl, tr) - 1;
-		auto lenR = distance(tr, br) - 1;
-
-		CHECK(std::abs(lenT - lenB) / lenB < 0.5 && std::abs(lenR - lenL) / lenL < 0.5 &&
-			  lineT.points().size() >= 5 && lineR.points().size() >= 5);
-
-		// continue top row right until we cross the right line
-		CHECK(tlTracer.traceGaps(tlTracer.right(), lineT, maxStepSize, lineR));
-
-		printf("L: %.1f, %.1f ^ %.1f, %.1f > %.1f, %.1f (%d : %d : %d : %d)\n", bl.x, bl.y,
-			   tl.x - bl.x, tl.y - bl.y, br.x - bl.x, br.y - bl.y, (int)lenL, (int)lenB, (int)lenT, (int)lenR);
-
-		for (auto* l : {&lineL, &lineB, &lineT, &lineR})
-			l->evaluate(1.0);
-
-		// find the bounding box corners of the code with sub-pixel precision by intersecting the 4 border lines
-		bl = intersect(lineB, lineL);
-		tl = intersect(lineT, lineL);
-		tr = intersect(lineT, lineR);
-		br = intersect(lineB, lineR);
-
-		int dimT, dimR;
-		double fracT, fracR;
-		auto splitDouble = [](double d, int* i, double* f) {
-			*i = std::isnormal(d) ? static_cast<int>(d + 0.5) : 0;
-			*f = std::isnormal(d) ? std::abs(d - *i) : INFINITY;
-		};
-		splitDouble(lineT.modules(tl, tr), &dimT, &fracT);
-		splitDouble(lineR.modules(br, tr), &dimR, &fracR);
-
-		// the dimension is 2x the number of black/white transitions
-		dimT *= 2;
-		dimR *= 2;
-
-		printf("L: %.1f, %.1f ^ %.1f, %.1f > %.1f, %.1f ^> %.1f, %.1f\n", bl.x, bl.y,
-			   tl.x - bl.x, tl.y - bl.y, br.x - bl.x, br.y - bl.y, tr.x, tr.y);
-		printf("dim: %d x %d\n", dimT, dimR);
-
-		// if we have an almost square (invalid rectangular) data matrix dimension, we try to parse it by assuming a
-		// square. we use the dimension that is closer to an integral value. all valid rectangular symbols differ in
-		// their dimension by at least 10. Note: this is currently not required for the black-box tests to complete.
-		if (std::abs(dimT - dimR) < 10)
-			dimT = dimR = fracR < fracT ? dimR : dimT;
-
-		CHECK(dimT >= 10 && dimT <= 144 && dimR >= 8 && dimR <= 144);
-
-		auto movedTowardsBy = [](PointF a, PointF b1, PointF b2, auto d) {
-			return a + d * normalized(normalized(b1 - a) + normalized(b2 - a));
-		};
-
-		// shrink shape by half a pixel to go from center of white pixel outside of code to the edge between white and black
-		QuadrilateralF sourcePoints = {
-			movedTowardsBy(tl, tr, bl, 0.5f),
-			// move the tr point a little less because the jagged top and right line tend to be statistically slightly
-			// inclined toward the center anyway.
-			movedTowardsBy(tr, br, tl, 0.3f),
-			movedTowardsBy(br, bl, tr, 0.5f),
-			movedTowardsBy(bl, tl, br, 0.5f),
-		};
-
-		auto res = SampleGrid(*startTracer.img, dimT, dimR, PerspectiveTransform(Rectangle(dimT, dimR, 0), sourcePoints));
-
-		CHECK(res.isValid());
+	auto t = startTracer;
+	PointF up, right;
+
+	// follow left leg upwards
+	t.turnRight();
+	t.state = 1;
+	CHECK(t.traceLine(t.right(), lineL));
+	CHECK(t.traceCorner(t.right(), tl));
+	lineL.reverse();
+	auto tlTracer = t;
+
+	// follow left leg downwards
+	t = startTracer;
+	t.state = 1;
+	t.setDirection(tlTracer.right());
+	CHECK(t.traceLine(t.left(), lineL));
+
+	// check if lineL is L-shaped -> truncate the lower leg and set t to just before the corner
+	if (lineL.truncateIfLShape())
+		t.p = lineL.points().back();
+	t.updateDirectionFromOrigin(tl);
+	up = t.back();
+	CHECK(t.traceCorner(t.left(), bl));
+
+	// follow bottom leg right
+	t.state = 2;
+	CHECK(t.traceLine(t.left(), lineB));
+	t.updateDirectionFromOrigin(bl);
+	right = t.front();
+	CHECK(t.traceCorner(t.left(), br));
+
+	auto lenL = distance(tl, bl) - 1;
+	auto lenB = distance(bl, br) - 1;
+	CHECK(lenL >= 8 && lenB >= 10 && lenB >= lenL / 4 && lenB <= lenL * 18);
+
+	auto maxStepSize = static_cast<int>(lenB / 5 + 1); // datamatrix bottom dim is at least 10
+
+	// at this point we found a plausible L-shape and are now looking for the b/w pattern at the top and right:
+	// follow top row right 'half way' (at least 4 gaps), see traceGaps
+	tlTracer.setDirection(right);
+	CHECK(tlTracer.traceGaps(tlTracer.right(), lineT, maxStepSize, {}, lenB / 2));
+
+	maxStepSize = std::min(lineT.length() / 3, static_cast<int>(lenL / 5)) * 2;
+
+	// follow up until we reach the top line
+	t.setDirection(up);
+	t.state = 3;
+	CHECK(t.traceGaps(t.left(), lineR, maxStepSize, lineT));
+	CHECK(t.traceCorner(t.left(), tr));
+
+	auto lenT = distance(tl, tr) - 1;
+	auto lenR = distance(tr, br) - 1;
+
+	CHECK(std::abs(lenT - lenB) / lenB < 0.5 && std::abs(lenR - lenL) / lenL < 0.5 &&
+		  lineT.points().size() >= 5 && lineR.points().size() >= 5);
+
+	// continue top row right until we cross the right line
+	CHECK(tlTracer.traceGaps(tlTracer.right(), lineT, maxStepSize, lineR));
+
+	printf("L: %.1f, %.1f ^ %.1f, %.1f > %.1f, %.1f (%d : %d : %d : %d)\n", bl.x, bl.y,
+		   tl.x - bl.x, tl.y - bl.y, br.x - bl.x, br.y - bl.y, (int)lenL, (int)lenB, (int)lenT, (int)lenR);
+
+	for (auto* l : {&lineL, &lineB, &lineT, &lineR})
+		l->evaluate(1.0);
+
+	// find the bounding box corners of the code with sub-pixel precision by intersecting the 4 border lines
+	bl = intersect(lineB, lineL);
+	tl = intersect(lineT, lineL);
+	tr = intersect(lineT, lineR);
+	br = intersect(lineB, lineR);
+
+	int dimT, dimR;
+	double fracT, fracR;
+	auto splitDouble = [](double d, int* i, double* f) {
+		*i = std::isnormal(d) ? static_cast<int>(d + 0.5) : 0;
+		*f = std::isnormal(d) ? std::abs(d - *i) : INFINITY;
+	};
+	splitDouble(lineT.modules(tl, tr), &dimT, &fracT);
+	splitDouble(lineR.modules(br, tr), &dimR, &fracR);
+
+	// the dimension is 2x the number of black/white transitions
+	dimT *= 2;
+	dimR *= 2;
 
-		return res;
+	printf("L: %.1f, %.1f ^ %.1f, %.1f > %.1f, %.1f ^> %.1f, %.1f\n", bl.x, bl.y,
+		   tl.x - bl.x, tl.y - bl.y, br.x - bl.x, br.y - bl.y, tr.x, tr.y);
+	printf("dim: %d x %d\n", dimT, dimR);
+
+	// if we have an almost square (invalid rectangular) data matrix dimension, we try to parse it by assuming a
+	// square. we use the dimension that is closer to an integral value. all valid rectangular symbols differ in
+	// their dimension by at least 10. Note: this is currently not required for the black-box tests to complete.
+	if (std::abs(dimT - dimR) < 10)
+		dimT = dimR = fracR < fracT ? dimR : dimT;
+
+	CHECK(dimT >= 10 && dimT <= 144 && dimR >= 8 && dimR <= 144);
+
+	auto movedTowardsBy = [](PointF a, PointF b1, PointF b2, auto d) {
+		return a + d * normalized(normalized(b1 - a) + normalized(b2 - a));
+	};
+
+	// shrink shape by half a pixel to go from center of white pixel outside of code to the edge between white and black
+	QuadrilateralF sourcePoints = {
+		movedTowardsBy(tl, tr, bl, 0.5f),
+		// move the tr point a little less because the jagged top and right line tend to be statistically slightly
+		// inclined toward the center anyway.
+		movedTowardsBy(tr, br, tl, 0.3f),
+		movedTowardsBy(br, bl, tr, 0.5f),
+		movedTowardsBy(bl, tl, br, 0.5f),
+	};
+
+	return SampleGrid(*startTracer.img, dimT, dimR, PerspectiveTransform(Rectangle(dimT, dimR, 0), sourcePoints));
+}
+
+static DetectorResult Scan(EdgeTracer& startTracer, std::array<DMRegressionLine, 4>& lines)
+{
+	while (startTracer.moveToNextWhiteAfterBlack()) {
+		log(startTracer.p);
+
+		if (auto res = ScanL(startTracer, lines); res.isValid())
+			return res;
 	}
 
 	return {};
@@ -871,9 +924,9 @@ static DetectorResults DetectNew(const BitMatrix& image, bool tryHarder, bool tr
 #endif
 
 	// a history log to remember where the tracing already passed by to prevent a later trace from doing the same work twice
-	ByteMatrix history;
+	TraceHistory history;
 	if (tryHarder)
-		history = ByteMatrix(image.width(), image.height());
+		history = TraceHistory(image.width(), image.height());
 
 	// instantiate RegressionLine objects outside of Scan function to prevent repetitive std::vector allocations
 	std::array<DMRegressionLine, 4> lines;
@@ -957,12 +1010,79 @@ static DetectorResult DetectPure(const BitMatrix& image)
 			{{left, top}, {right, top}, {right, bottom}, {left, bottom}}};
 }
 
+/**
+* Variant of DetectPure() for "pure" images of a code that is rotated by a multiple of 90 degrees and/or slightly
+* skewed. The corners of the symbol are the black pixels closest to the corners of the bounding box. The solid sides
+* of the L-shaped finder pattern identify the orientation and the dimensions are read off the two timing patterns.
+*/
+static DetectorResult DetectPureRotated(const BitMatrix& image)
+{
+	int left, top, width, height;
+	std::array<PointI, 4> corners;
+	if (!image.findBoundingBox(left, top, width, height, 8) || !image.findCorners(left, top, width, height, corners))
+		return {};
+
+	auto isSolid = [&](PointI a, PointI b) {
+		int steps = maxAbsComponent(b - a), black = 0;
+		auto dir = PointF(b - a) / std::max(steps, 1);
+		for (int i = 0; i <= steps; ++i)
+			black += image.get(centered(a) + i * dir);
+		return black * 10 >= (steps + 1) * 9;
+	};
+
+	// the bottom-left corner of the symbol is the one where the two solid sides of the finder pattern meet
+	int bl = 0;
+	while (bl < 4 && !(isSolid(corners[bl], corners[(bl + 1) % 4]) && isSolid(corners[bl], corners[(bl + 3) % 4])))
+		++bl;
+	if (bl == 4)
+		return {};
+
+	// outer corners of the corner pixels
+	constexpr PointI offsets[] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+	auto outer = [&](int i) { return PointF(corners[i % 4] + offsets[i % 4]); };
+	QuadrilateralF quad;
+	quad[0] = outer(bl + 1);
+	quad[3] = outer(bl);
+	quad[2] = outer(bl + 3);
+	quad[1] = quad[0] + quad[2] - quad[3];
+
+	// count the modules along the timing pattern from a to b, the second pass is done half a module inside
+	auto countModules = [&](PointF a, PointF b, PointF inward) {
+		int dim = 0;
+		double inset = 0.5;
+		for (int pass = 0; pass < 2; ++pass) {
+			auto along = normalized(b - a);
+			auto from = a + inset * (inward + along), to = b + inset * (inward - along);
+			dim = BitMatrixCursorF(image, from, bresenhamDirection(to - from)).countEdges(maxAbsComponent(to - from)) + 1;
+			inset = distance(a, b) / dim / 2;
+		}
+		return dim;
+	};
+	int dimT = countModules(quad[0], quad[1], normalized(quad[3] - quad[0]));
+	int dimR = countModules(quad[1], quad[2], normalized(quad[0] - quad[1]));
+
+	// the (white) top-right corner module is not part of the found corners but has to be next to the one found there
+	auto moduleSize = distance(quad[0], quad[1]) / dimT;
+	if (dimT % 2 != 0 || dimR % 2 != 0 || dimT < 10 || dimT > 144 || dimR < 8 || dimR > 144
+		|| distance(outer(bl + 2), quad[1]) > 2 * moduleSize + 1)
+		return {};
+
+	return SampleGrid(image, dimT, dimR, PerspectiveTransform(Rectangle(dimT, dimR, 0), quad));
+}
+
+static DetectorResult DetectPure(const BitMatrix& image, bool tryRotate)
+{
+	auto res = DetectPure(image);
+	if (res.isValid() || !tryRotate)
+		return res;
+	return DetectPureRotated(image);
+}
+
 DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, bool isPure)
 {
 #ifdef __cpp_impl_coroutine
 	// First try the very fast DetectPure() path. Also because DetectNew() generally fails with pure module size 1 symbols
-	// TODO: implement a tryRotate version of DetectPure, see #590.
-	if (auto r = DetectPure(image); r.isValid())
+	if (auto r = DetectPure(image, tryRotate); r.isValid())
 		co_yield std::move(r);
 	else if (!isPure) { // If r.isValid() then there is no point in looking for more (no-pure) symbols
 		bool found = false;
@@ -976,7 +1096,7 @@ DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, b
 		}
 	}
 #else
-	auto result = DetectPure(image);
+	auto result = DetectPure(image, tryRotate);
 	if (!result.isValid() && !isPure)
 		result = DetectNew(image, tryHarder, tryRotate);
 	if (!result.isValid() && tryHarder && !isPure)
@@ -985,4 +1105,85 @@ DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, b
 #endif
 }
 
+/**
+* Scan the lines [begin, end) (rows for horizontal, columns for vertical directions) every minSymbolSize pixels for
+* b/w edges in direction dir. Those are the candidate positions of the outer edge of an L-shaped finder pattern. The
+* candidates are collected from the scan lines only (a sparse edge map) and then traced one after the other. A
+* candidate is skipped if an earlier trace passed by already or if it lies inside of a symbol found before.
+*/
+static std::vector<DetectorResult> ScanBand(const BitMatrix& image, PointI dir, int begin, int end, int minSymbolSize)
+{
+	std::vector<PointI> candidates;
+	for (int i = begin + minSymbolSize / 2; i < end; i += minSymbolSize) {
+		PointI start = dir.x ? PointI(dir.x < 0 ? image.width() - 1 : 0, i) : PointI(i, dir.y < 0 ? image.height() - 1 : 0);
+		EdgeTracer tracer(image, centered(start), PointF(dir));
+		while (tracer.moveToNextWhiteAfterBlack())
+			candidates.push_back(PointI(tracer.p));
+	}
+
+	TraceHistory history(image.width(), image.height());
+	std::array<DMRegressionLine, 4> lines;
+	std::vector<DetectorResult> res;
+	for (auto p : candidates) {
+		if (history.get(p) || std::any_of(res.begin(), res.end(), [p](auto& r) { return IsInside(p, r.position()); }))
+			continue;
+
+		EdgeTracer tracer(image, centered(p), PointF(dir));
+		tracer.history = &history;
+		if (auto r = ScanL(tracer, lines); r.isValid())
+			res.push_back(std::move(r));
+	}
+
+	return res;
+}
+
+std::vector<DetectorResult> DetectAll(const BitMatrix& image, bool tryRotate, int maxThreads)
+{
+	std::vector<DetectorResult> res;
+	if (auto r = DetectPure(image, tryRotate); r.isValid()) {
+		res.push_back(std::move(r));
+		return res;
+	}
+
+#ifdef PRINT_DEBUG
+	LogMatrixWriter lmw(log, image, 1, "dm-log.pnm");
+	maxThreads = 1;
+#endif
+
+	constexpr int minSymbolSize = 8 * 2; // see DetectNew
+	constexpr int bandSize = 16 * minSymbolSize;
+
+	// split the image into bands of scan lines per scan direction, which can be traced independently
+	struct Band
+	{
+		PointI dir;
+		int begin, end;
+	};
+	std::vector<Band> bands;
+	for (auto dir : {PointI{-1, 0}, {1, 0}, {0, -1}, {0, 1}}) {
+		int size = dir.x ? image.height() : image.width();
+		for (int begin = 0; begin < size; begin += bandSize)
+			bands.push_back({dir, begin, std::min(begin + bandSize, size)});
+		if (!tryRotate)
+			break; // only test left direction
+	}
+
+	std::vector<std::vector<DetectorResult>> bandResults(bands.size());
+	ParallelFor(Size(bands), maxThreads, [&](int i) {
+		bandResults[i] = ScanBand(image, bands[i].dir, bands[i].begin, bands[i].end, minSymbolSize);
+	});
+
+	// a symbol is typically found in more than one band (scan direction or band border), keep the first one
+	for (auto& rs : bandResults)
+		for (auto& r : rs)
+			if (std::none_of(res.begin(), res.end(), [&r](auto& o) { return IsInside(Center(r.position()), o.position()); }))
+				res.push_back(std::move(r));
+
+	if (res.empty())
+		if (auto r = DetectOld(image); r.isValid())
+			res.push_back(std::move(r));
+
+	return res;
+}
+
 } // namespace ZXing::DataMatrix
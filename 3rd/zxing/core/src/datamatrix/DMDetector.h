@@ -6,15 +6,17 @@
 
 #pragma once
 
+#include "DetectorResult.h"
+
 #ifdef __cpp_impl_coroutine
 #include <Generator.h>
-#include <DetectorResult.h>
 #endif
 
+#include <vector>
+
 namespace ZXing {
 
 class BitMatrix;
-class DetectorResult;
 
 namespace DataMatrix {
 
@@ -26,5 +28,12 @@ using DetectorResults = DetectorResult;
 
 DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, bool isPure);
 
+/**
+* Detect all symbols in the image, e.g. a tray full of labeled vials. Contrary to Detect(), which traces from the
+* center lines outwards, L-shaped finder pattern candidates are collected from scan lines over the whole image and
+* traced concurrently by up to maxThreads threads (0 means one per core).
+*/
+std::vector<DetectorResult> DetectAll(const BitMatrix& image, bool tryRotate, int maxThreads);
+
 } // DataMatrix
 } // ZXing
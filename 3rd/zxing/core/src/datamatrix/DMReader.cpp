@@ -9,12 +9,15 @@
 #include "BinaryBitmap.h"
 #include "DMDecoder.h"
 #include "DMDetector.h"
+#include "Parallel.h"
+#include "ReadTimings.h"
 #include "ReaderOptions.h"
 #include "DecoderResult.h"
 #include "DetectorResult.h"
 #include "Barcode.h"
 
 #include <utility>
+#include <vector>
 
 namespace ZXing::DataMatrix {
 
@@ -27,32 +30,91 @@ Barcode Reader::decode(const BinaryBitmap& image) const
 	if (binImg == nullptr)
 		return {};
 	
-	auto detectorResult = Detect(*binImg, _opts.tryHarder(), _opts.tryRotate(), _opts.isPure());
-	if (!detectorResult.isValid())
+	ReadTimings::Stages stages;
+	auto detectorResult = [&] {
+		ScopedTiming timing(&stages.detect);
+		return Detect(*binImg, _opts.tryHarder(), _opts.tryRotate(), _opts.isPure());
+	}();
+	if (!detectorResult.isValid()) {
+		addStageTimings(BarcodeFormat::DataMatrix, stages);
 		return {};
+	}
 
-	return Barcode(Decode(detectorResult.bits()), std::move(detectorResult), BarcodeFormat::DataMatrix);
+	auto decoderResult = Decode(detectorResult.bits(), &stages);
+	addStageTimings(BarcodeFormat::DataMatrix, stages);
+	return Barcode(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::DataMatrix);
 #endif
 }
 
-#ifdef __cpp_impl_coroutine
 Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 {
 	auto binImg = image.getBitMatrix();
 	if (binImg == nullptr)
 		return {};
 
+	int nbThreads = maxSymbols == 1 ? 1 : ThreadCount(_opts.maxThreads());
+
 	Barcodes res;
+	ReadTimings::Stages stages;
+	std::vector<DetectorResult> detResults;
+	std::vector<DecoderResult> decResults;
+	std::vector<ReadTimings::Stages> decStages;
+	// decode the detected symbols concurrently and append the results in detection order, so the returned list is
+	// the same as with a sequential loop.
+	auto decodeBatch = [&] {
+		decResults.clear();
+		decResults.resize(detResults.size());
+		decStages.assign(detResults.size(), {});
+		ParallelFor(Size(detResults), nbThreads,
+					[&](int i) { decResults[i] = Decode(detResults[i].bits(), &decStages[i]); });
+		for (auto& s : decStages)
+			stages += s;
+
+		for (int i = 0; i < Size(detResults); ++i) {
+			if (decResults[i].isValid(_opts.returnErrors())) {
+				res.emplace_back(std::move(decResults[i]), std::move(detResults[i]), BarcodeFormat::DataMatrix);
+				if (maxSymbols > 0 && Size(res) >= maxSymbols)
+					return false;
+			}
+		}
+		detResults.clear();
+		return true;
+	};
+
+	// opt-in for images densely covered with symbols: search the whole image at once
+	if (_opts.detectAll() && maxSymbols != 1 && !_opts.isPure()) {
+		{
+			ScopedTiming timing(&stages.detect);
+			detResults = DetectAll(*binImg, _opts.tryRotate(), _opts.maxThreads());
+		}
+		decodeBatch();
+		addStageTimings(BarcodeFormat::DataMatrix, stages);
+		return res;
+	}
+
+#ifdef __cpp_impl_coroutine
+	// The symbols are detected one after the other but decoded concurrently in batches. The detector runs between the
+	// iterations of the loop, its time is the time spent outside of decodeBatch.
+	int batchSize = nbThreads == 1 ? 1 : 2 * nbThreads;
+	auto detectStart = ReadTimings::Clock::now();
 	for (auto&& detRes : Detect(*binImg, _opts.tryHarder(), _opts.tryRotate(), _opts.isPure())) {
-		auto decRes = Decode(detRes.bits());
-		if (decRes.isValid(_opts.returnErrors())) {
-			res.emplace_back(std::move(decRes), std::move(detRes), BarcodeFormat::DataMatrix);
-			if (maxSymbols > 0 && Size(res) >= maxSymbols)
-				break;
+		stages.detect += ReadTimings::Clock::now() - detectStart;
+		detResults.push_back(std::move(detRes));
+		if (Size(detResults) == batchSize && !decodeBatch()) {
+			addStageTimings(BarcodeFormat::DataMatrix, stages);
+			return res;
 		}
+		detectStart = ReadTimings::Clock::now();
 	}
+	stages.detect += ReadTimings::Clock::now() - detectStart;
+	decodeBatch();
+	addStageTimings(BarcodeFormat::DataMatrix, stages);
+#else
+	if (auto r = decode(image); r.isValid() || (_opts.returnErrors() && r.format() != BarcodeFormat::None))
+		res.push_back(std::move(r));
+#endif
 
 	return res;
 }
-#endif
+
 } // namespace ZXing::DataMatrix
@@ -16,9 +16,7 @@ public:
 	using ZXing::Reader::Reader;
 
 	Barcode decode(const BinaryBitmap& image) const override;
-#ifdef __cpp_impl_coroutine
 	Barcodes decode(const BinaryBitmap& image, int maxSymbols) const override;
-#endif
 };
 
 } // namespace ZXing::DataMatrix
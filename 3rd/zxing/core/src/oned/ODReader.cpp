@@ -81,7 +81,7 @@ Reader::~Reader() = default;
 * image if "trying harder".
 */
 static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers, const BinaryBitmap& image, bool tryHarder,
-						 bool rotate, bool isPure, int maxSymbols, int minLineCount, bool returnErrors)
+						 bool rotate, bool isPure, int maxSymbols, int minLineCount, bool returnErrors, const Deadline& deadline)
 {
 	Barcodes res;
 
@@ -114,6 +114,8 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 #endif
 
 	for (int i = 0; i < maxLines; i++) {
+		if (deadline.expired())
+			break;
 
 		// Scanning from the middle out. Determine which row we're looking at next:
 		int rowStepsAboveOrBelow = (i + 1) / 2;
@@ -269,10 +271,12 @@ out:
 Barcode Reader::decode(const BinaryBitmap& image) const
 {
 	auto result =
-		DoDecode(_readers, image, _opts.tryHarder(), false, _opts.isPure(), 1, _opts.minLineCount(), _opts.returnErrors());
+		DoDecode(_readers, image, _opts.tryHarder(), false, _opts.isPure(), 1, _opts.minLineCount(), _opts.returnErrors(),
+						  _opts.deadline());
 	
 	if (result.empty() && _opts.tryRotate())
-		result = DoDecode(_readers, image, _opts.tryHarder(), true, _opts.isPure(), 1, _opts.minLineCount(), _opts.returnErrors());
+		result = DoDecode(_readers, image, _opts.tryHarder(), true, _opts.isPure(), 1, _opts.minLineCount(), _opts.returnErrors(),
+						  _opts.deadline());
 
 	return FirstOrDefault(std::move(result));
 }
@@ -280,10 +284,10 @@ Barcode Reader::decode(const BinaryBitmap& image) const
 Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 {
 	auto resH = DoDecode(_readers, image, _opts.tryHarder(), false, _opts.isPure(), maxSymbols, _opts.minLineCount(),
-						 _opts.returnErrors());
+						 _opts.returnErrors(), _opts.deadline());
 	if ((!maxSymbols || Size(resH) < maxSymbols) && _opts.tryRotate()) {
 		auto resV = DoDecode(_readers, image, _opts.tryHarder(), true, _opts.isPure(), maxSymbols - Size(resH),
-							 _opts.minLineCount(), _opts.returnErrors());
+							 _opts.minLineCount(), _opts.returnErrors(), _opts.deadline());
 		resH.insert(resH.end(), resV.begin(), resV.end());
 	}
 	return resH;
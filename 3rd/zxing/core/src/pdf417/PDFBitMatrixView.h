@@ -0,0 +1,50 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BitMatrix.h"
+
+#include <cstdint>
+
+namespace ZXing {
+namespace Pdf417 {
+
+/**
+* Read-only view of a BitMatrix, rotated clockwise by 0, 90, 180 or 270 degrees. The view maps coordinates to
+* the underlying storage by strides, so rotating does not require copying the matrix. The pixel at (x, y) is
+* the same as in a BitMatrix copy of the image after rotate90() and/or rotate180().
+*/
+class BitMatrixView
+{
+	const uint8_t* _origin = nullptr;
+	int _width = 0;
+	int _height = 0;
+	int _xStride = 0;
+	int _yStride = 0;
+
+public:
+	BitMatrixView() = default;
+
+	BitMatrixView(const BitMatrix& bits, int rotation = 0)
+	{
+		const auto* data = bits.row(0).begin();
+		int w = bits.width(), h = bits.height();
+		switch ((rotation + 360) % 360) {
+		case 90: _origin = data + w - 1, _width = h, _height = w, _xStride = w, _yStride = -1; break;
+		case 180: _origin = data + w * h - 1, _width = w, _height = h, _xStride = -1, _yStride = -w; break;
+		case 270: _origin = data + (h - 1) * w, _width = h, _height = w, _xStride = -w, _yStride = 1; break;
+		default: _origin = data, _width = w, _height = h, _xStride = 1, _yStride = w;
+		}
+	}
+
+	int width() const { return _width; }
+	int height() const { return _height; }
+
+	bool get(int x, int y) const { return _origin[x * _xStride + y * _yStride] != 0; }
+};
+
+} // Pdf417
+} // ZXing
@@ -6,16 +6,15 @@
 
 #pragma once
 
+#include "PDFBitMatrixView.h"
 #include "ResultPoint.h"
 #include "ZXNullable.h"
 
 #include <list>
 #include <array>
-#include <memory>
 
 namespace ZXing {
 
-class BitMatrix;
 class BinaryBitmap;
 
 namespace Pdf417 {
@@ -33,7 +32,7 @@ class Detector
 public:
 	struct Result
 	{
-		std::shared_ptr<const BitMatrix> bits;
+		BitMatrixView bits; // the image as seen in the detected rotation
 		std::list<std::array<Nullable<ResultPoint>, 8>> points;
 		int rotation = -1;
 	};
@@ -17,6 +17,7 @@
 #include "PDFCustomData.h"
 #include "PDFDetector.h"
 #include "PDFScanningDecoder.h"
+#include "Parallel.h"
 #include "Pattern.h"
 #include "ReaderOptions.h"
 
@@ -65,7 +66,7 @@ static int GetMaxCodewordWidth(const std::array<Nullable<ResultPoint>, 8>& p)
 					std::max(GetMaxWidth(p[1], p[5]), GetMaxWidth(p[7], p[3]) * CodewordDecoder::MODULES_IN_CODEWORD / MODULES_IN_STOP_PATTERN));
 }
 
-static Barcodes DoDecode(const BinaryBitmap& image, bool multiple, bool tryRotate, bool returnErrors)
+static Barcodes DoDecode(const BinaryBitmap& image, bool multiple, bool tryRotate, bool returnErrors, int maxThreads)
 {
 	Detector::Result detectorResult = Detector::Detect(image, multiple, tryRotate);
 	if (detectorResult.points.empty())
@@ -73,18 +74,32 @@ static Barcodes DoDecode(const BinaryBitmap& image, bool multiple, bool tryRotat
 
 	auto rotate = [res = detectorResult](PointI p) {
 		switch(res.rotation) {
-		case 90: return PointI(res.bits->height() - p.y - 1, p.x);
-		case 180: return PointI(res.bits->width() - p.x - 1, res.bits->height() - p.y - 1);
-		case 270: return PointI(p.y, res.bits->width() - p.x - 1);
+		case 90: return PointI(res.bits.height() - p.y - 1, p.x);
+		case 180: return PointI(res.bits.width() - p.x - 1, res.bits.height() - p.y - 1);
+		case 270: return PointI(p.y, res.bits.width() - p.x - 1);
 		}
 		return p;
 	};
 
+	auto decode = [&](const std::array<Nullable<ResultPoint>, 8>& points) {
+		return ScanningDecoder::Decode(detectorResult.bits, points[4], points[5], points[6], points[7],
+									   GetMinCodewordWidth(points), GetMaxCodewordWidth(points));
+	};
+
+	// when looking for multiple symbols, all detected ones get decoded anyway, so do that concurrently
+	std::vector<const std::array<Nullable<ResultPoint>, 8>*> allPoints;
+	std::vector<DecoderResult> decoderResults;
+	if (multiple) {
+		for (const auto& points : detectorResult.points)
+			allPoints.push_back(&points);
+		decoderResults.resize(allPoints.size());
+		ParallelFor(Size(allPoints), maxThreads, [&](int i) { decoderResults[i] = decode(*allPoints[i]); });
+	}
+
 	Barcodes res;
+	int i = 0;
 	for (const auto& points : detectorResult.points) {
-		DecoderResult decoderResult =
-			ScanningDecoder::Decode(*detectorResult.bits, points[4], points[5], points[6], points[7],
-									GetMinCodewordWidth(points), GetMaxCodewordWidth(points));
+		DecoderResult decoderResult = multiple ? std::move(decoderResults[i++]) : decode(points);
 		if (decoderResult.isValid(returnErrors)) {
 			auto customData = std::static_pointer_cast<PDF417CustomData>(decoderResult.customData());
 			auto point = [&](int i) {
@@ -329,12 +344,12 @@ Reader::decode(const BinaryBitmap& image) const
 		// currently the best option to deal with 'aliased' input like e.g. 03-aliased.png
 	}
 
-	return FirstOrDefault(DoDecode(image, false, _opts.tryRotate(), _opts.returnErrors()));
+	return FirstOrDefault(DoDecode(image, false, _opts.tryRotate(), _opts.returnErrors(), 1));
 }
 
 Barcodes Reader::decode(const BinaryBitmap& image, [[maybe_unused]] int maxSymbols) const
 {
-	return DoDecode(image, true, _opts.tryRotate(), _opts.returnErrors());
+	return DoDecode(image, true, _opts.tryRotate(), _opts.returnErrors(), _opts.maxThreads());
 }
 
 } // Pdf417
@@ -6,7 +6,7 @@
 
 #include "PDFScanningDecoder.h"
 
-#include "BitMatrix.h"
+#include "PDFBitMatrixView.h"
 #include "DecoderResult.h"
 #include "PDFBarcodeMetadata.h"
 #include "PDFBarcodeValue.h"
@@ -29,7 +29,7 @@ static const int MAX_EC_CODEWORDS = 512;
 
 using ModuleBitCountType = std::array<int, CodewordDecoder::BARS_IN_MODULE>;
 
-static int AdjustCodewordStartColumn(const BitMatrix& image, int minColumn, int maxColumn, bool leftToRight, int codewordStartColumn, int imageRow)
+static int AdjustCodewordStartColumn(const BitMatrixView& image, int minColumn, int maxColumn, bool leftToRight, int codewordStartColumn, int imageRow)
 {
 	int correctedStartColumn = codewordStartColumn;
 	int increment = leftToRight ? -1 : 1;
@@ -48,7 +48,7 @@ static int AdjustCodewordStartColumn(const BitMatrix& image, int minColumn, int
 	return correctedStartColumn;
 }
 
-static bool GetModuleBitCount(const BitMatrix& image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, ModuleBitCountType& moduleBitCount)
+static bool GetModuleBitCount(const BitMatrixView& image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, ModuleBitCountType& moduleBitCount)
 {
 	int imageColumn = startColumn;
 	size_t moduleNumber = 0;
@@ -105,7 +105,7 @@ static int GetCodewordBucketNumber(int codeword)
 	return GetCodewordBucketNumber(GetBitCountForCodeword(codeword));
 }
 
-static Nullable<Codeword> DetectCodeword(const BitMatrix& image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, int minCodewordWidth, int maxCodewordWidth)
+static Nullable<Codeword> DetectCodeword(const BitMatrixView& image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, int minCodewordWidth, int maxCodewordWidth)
 {
 	startColumn = AdjustCodewordStartColumn(image, minColumn, maxColumn, leftToRight, startColumn, imageRow);
 	// we usually know fairly exact now how long a codeword is. We should provide minimum and maximum expected length
@@ -156,7 +156,7 @@ static Nullable<Codeword> DetectCodeword(const BitMatrix& image, int minColumn,
 	return nullptr;
 }
 
-static DetectionResultColumn GetRowIndicatorColumn(const BitMatrix& image, const BoundingBox& boundingBox, const ResultPoint& startPoint, bool leftToRight, int minCodewordWidth, int maxCodewordWidth)
+static DetectionResultColumn GetRowIndicatorColumn(const BitMatrixView& image, const BoundingBox& boundingBox, const ResultPoint& startPoint, bool leftToRight, int minCodewordWidth, int maxCodewordWidth)
 {
 	DetectionResultColumn rowIndicatorColumn(boundingBox, leftToRight ? DetectionResultColumn::RowIndicator::Left : DetectionResultColumn::RowIndicator::Right);
 	for (int i = 0; i < 2; i++) {
@@ -678,7 +678,7 @@ static DecoderResult CreateDecoderResult(DetectionResult& detectionResult)
 // This approach also allows detecting more details about the barcode, e.g. if a bar type (white or black) is wider
 // than it should be. This can happen if the scanner used a bad blackpoint.
 DecoderResult
-ScanningDecoder::Decode(const BitMatrix& image, const Nullable<ResultPoint>& imageTopLeft, const Nullable<ResultPoint>& imageBottomLeft,
+ScanningDecoder::Decode(const BitMatrixView& image, const Nullable<ResultPoint>& imageTopLeft, const Nullable<ResultPoint>& imageBottomLeft,
 	const Nullable<ResultPoint>& imageTopRight, const Nullable<ResultPoint>& imageBottomRight,
 	int minCodewordWidth, int maxCodewordWidth)
 {
@@ -319,8 +319,10 @@ DecoderResult DecodeBitStream(ByteArray&& bytes, const Version& version, ErrorCo
 		.setStructuredAppend(structuredAppend);
 }
 
-DecoderResult Decode(const BitMatrix& bits)
+DecoderResult Decode(const BitMatrix& bits, ReadTimings::Stages* stages)
 {
+	ScopedTiming timing(stages ? &stages->decode : nullptr);
+
 	if (!Version::HasValidSize(bits))
 		return FormatError("Invalid symbol size");
 
@@ -357,6 +359,7 @@ DecoderResult Decode(const BitMatrix& bits)
 		ByteArray& codewordBytes = dataBlock.codewords();
 		int numDataCodewords = dataBlock.numDataCodewords();
 
+		ScopedTiming ecTiming(stages ? &stages->errorCorrection : nullptr);
 		if (!CorrectErrors(codewordBytes, numDataCodewords))
 			error = ChecksumError();
 
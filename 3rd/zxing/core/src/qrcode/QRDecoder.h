@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "ReadTimings.h"
+
 namespace ZXing {
 
 class DecoderResult;
@@ -13,7 +15,8 @@ class BitMatrix;
 
 namespace QRCode {
 
-DecoderResult Decode(const BitMatrix& bits);
+/// If stages is not null, the time spent is added to its decode and errorCorrection members
+DecoderResult Decode(const BitMatrix& bits, ReadTimings::Stages* stages = nullptr);
 
 } // QRCode
 } // ZXing
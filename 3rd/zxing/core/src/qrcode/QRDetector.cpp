@@ -14,6 +14,7 @@
 #include "ConcentricFinder.h"
 #include "GridSampler.h"
 #include "LogMatrix.h"
+#include "Parallel.h"
 #include "Pattern.h"
 #include "QRFormatInformation.h"
 #include "QRVersion.h"
@@ -22,9 +23,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <iterator>
 #include <map>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -49,47 +52,40 @@ PatternView FindPattern(const PatternView& view)
 	});
 }
 
-std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool tryHarder)
+// A potential finder pattern center found on a scan line. If checked is set, pattern holds the result of
+// LocateConcentricPattern, otherwise the seed was dropped by the (stripe local) de-duplication.
+struct FinderPatternSeed
 {
-	constexpr int MIN_SKIP         = 3;           // 1 pixel/module times 3 modules/center
-	constexpr int MAX_MODULES_FAST = 20 * 4 + 17; // support up to version 20 for mobile clients
-
-	// Let's assume that the maximum version QR Code we support takes up 1/4 the height of the
-	// image, and then account for the center being 3 modules in size. This gives the smallest
-	// number of pixels the center could be, so skip this often. When trying harder, look for all
-	// QR versions regardless of how dense they are.
-	int height = image.height();
-	int skip = (3 * height) / (4 * MAX_MODULES_FAST);
-	if (skip < MIN_SKIP || tryHarder)
-		skip = MIN_SKIP;
+	PointF p;
+	int range = 0;
+	bool checked = false;
+	std::optional<ConcentricPattern> pattern;
+};
 
-	std::vector<ConcentricPattern> res;
-	[[maybe_unused]] int N = 0;
+static std::vector<FinderPatternSeed> ScanFinderPatternSeeds(const BitMatrix& image, int yBegin, int yEnd, int skip,
+														 const Deadline& deadline)
+{
+	std::vector<FinderPatternSeed> res;
+	std::vector<ConcentricPattern> found;
 	PatternRow row;
 
-	for (int y = skip - 1; y < height; y += skip) {
+	for (int y = yBegin; y < yEnd && !deadline.expired(); y += skip) {
 		GetPatternRow(image, y, row, false);
 		PatternView next = row;
 
 		while (next = FindPattern(next), next.isValid()) {
-			PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] / 2.0, y + 0.5);
+			FinderPatternSeed seed;
+			seed.p = PointF(next.pixelsInFront() + next[0] + next[1] + next[2] / 2.0, y + 0.5);
+			seed.range = next.sum() * 3; // 3 for very skewed samples
 
 			// make sure p is not 'inside' an already found pattern area
-			if (FindIf(res, [p](const auto& old) { return distance(p, old) < old.size / 2; }) == res.end()) {
-				log(p);
-				N++;
-				auto pattern = LocateConcentricPattern<E2E>(image, PATTERN, p,
-															next.sum() * 3); // 3 for very skewed samples
-				if (pattern) {
-					log(*pattern, 3);
-					log(*pattern + PointF(.2, 0), 3);
-					log(*pattern - PointF(.2, 0), 3);
-					log(*pattern + PointF(0, .2), 3);
-					log(*pattern - PointF(0, .2), 3);
-					assert(image.get(pattern->x, pattern->y));
-					res.push_back(*pattern);
-				}
+			seed.checked = FindIf(found, [p = seed.p](const auto& old) { return distance(p, old) < old.size / 2; }) == found.end();
+			if (seed.checked) {
+				seed.pattern = LocateConcentricPattern<E2E>(image, PATTERN, seed.p, seed.range);
+				if (seed.pattern)
+					found.push_back(*seed.pattern);
 			}
+			res.push_back(std::move(seed));
 
 			next.skipPair();
 			next.skipPair();
@@ -97,11 +93,123 @@ std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool t
 		}
 	}
 
+	return res;
+}
+
+std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool tryHarder, int maxThreads, const Deadline& deadline)
+{
+	constexpr int MIN_SKIP            = 3;           // 1 pixel/module times 3 modules/center
+	constexpr int MAX_MODULES_FAST    = 20 * 4 + 17; // support up to version 20 for mobile clients
+	constexpr int MIN_PIXELS_PARALLEL = 4'000'000;   // below that, starting threads costs more than it saves
+	constexpr int MIN_ROWS_PER_STRIPE = 64;
+
+	// Let's assume that the maximum version QR Code we support takes up 1/4 the height of the
+	// image, and then account for the center being 3 modules in size. This gives the smallest
+	// number of pixels the center could be, so skip this often. When trying harder, look for all
+	// QR versions regardless of how dense they are.
+	int height = image.height();
+	int skip = (3 * height) / (4 * MAX_MODULES_FAST);
+	if (skip < MIN_SKIP || tryHarder)
+		skip = MIN_SKIP;
+
+	// Split the scan lines into horizontal stripes that are searched concurrently. Each stripe only knows about
+	// the patterns it found itself, so it reports all seeds in scan order. They are replayed below against the
+	// global list of patterns, which results in exactly the same list as a single threaded scan.
+	int nbRows = height >= skip ? (height - skip) / skip + 1 : 0;
+	int nbStripes = int64_t(image.width()) * height < MIN_PIXELS_PARALLEL
+						? 1
+						: std::clamp(nbRows / MIN_ROWS_PER_STRIPE, 1, ThreadCount(maxThreads));
+
+	std::vector<std::vector<FinderPatternSeed>> stripes(nbStripes);
+	auto scanStripe = [&](int i) {
+		int rowBegin = nbRows * i / nbStripes;
+		int rowEnd   = nbRows * (i + 1) / nbStripes;
+		stripes[i] = ScanFinderPatternSeeds(image, skip - 1 + rowBegin * skip, skip - 1 + rowEnd * skip, skip, deadline);
+	};
+
+	ParallelFor(nbStripes, nbStripes, scanStripe);
+
+	std::vector<ConcentricPattern> res;
+	[[maybe_unused]] int N = 0;
+
+	for (auto& seeds : stripes) {
+		for (auto& seed : seeds) {
+			auto p = seed.p;
+			if (FindIf(res, [p](const auto& old) { return distance(p, old) < old.size / 2; }) != res.end())
+				continue;
+
+			log(p);
+			N++;
+			// the seed was suppressed by a pattern that did not survive the merge, so it still needs to be verified
+			if (!seed.checked)
+				seed.pattern = LocateConcentricPattern<E2E>(image, PATTERN, p, seed.range);
+			if (auto& pattern = seed.pattern) {
+				log(*pattern, 3);
+				log(*pattern + PointF(.2, 0), 3);
+				log(*pattern - PointF(.2, 0), 3);
+				log(*pattern + PointF(0, .2), 3);
+				log(*pattern - PointF(0, .2), 3);
+				assert(image.get(pattern->x, pattern->y));
+				res.push_back(*pattern);
+			}
+		}
+	}
+
 	printf("FPs?  : %d\n", N);
 
 	return res;
 }
 
+// Uniform grid over the finder pattern centers, used to only enumerate patterns that are close enough to each other
+// to be part of the same symbol.
+class FinderPatternGrid
+{
+	const FinderPatterns& _patterns;
+	PointF _origin;
+	double _cellSize = 1;
+	int _width = 1, _height = 1;
+	std::vector<std::vector<int>> _cells;
+
+	int col(double x) const { return std::clamp(narrow_cast<int>((x - _origin.x) / _cellSize), 0, _width - 1); }
+	int row(double y) const { return std::clamp(narrow_cast<int>((y - _origin.y) / _cellSize), 0, _height - 1); }
+
+public:
+	FinderPatternGrid(const FinderPatterns& patterns, double cellSize) : _patterns(patterns)
+	{
+		constexpr int MAX_CELLS = 256; // per dimension
+
+		if (patterns.empty())
+			return;
+
+		PointF max = _origin = patterns.front();
+		for (auto& p : patterns) {
+			UpdateMinMax(_origin.x, max.x, p.x);
+			UpdateMinMax(_origin.y, max.y, p.y);
+		}
+
+		_cellSize = std::max({cellSize, (max.x - _origin.x) / MAX_CELLS, (max.y - _origin.y) / MAX_CELLS, 1.0});
+		_width    = narrow_cast<int>((max.x - _origin.x) / _cellSize) + 1;
+		_height   = narrow_cast<int>((max.y - _origin.y) / _cellSize) + 1;
+		_cells.resize(_width * _height);
+
+		for (int i = 0; i < Size(patterns); ++i)
+			_cells[row(patterns[i].y) * _width + col(patterns[i].x)].push_back(i);
+	}
+
+	// returns the (sorted) indices of all patterns within radius of p
+	std::vector<int> neighbors(PointF p, double radius) const
+	{
+		std::vector<int> res;
+		for (int y = row(p.y - radius); y <= row(p.y + radius); ++y)
+			for (int x = col(p.x - radius); x <= col(p.x + radius); ++x)
+				for (int i : _cells[y * _width + x])
+					if (distance(p, _patterns[i]) <= radius)
+						res.push_back(i);
+		std::sort(res.begin(), res.end());
+		return res;
+	}
+};
+
 /**
  * @brief GenerateFinderPatternSets
  * @param patterns list of ConcentricPattern objects, i.e. found finder pattern squares
@@ -124,72 +232,89 @@ FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns)
 	const double cosUpper = std::cos(60. / 180 * 3.1415); // TODO: use c++20 std::numbers::pi_v
 	const double cosLower = std::cos(120. / 180 * 3.1415);
 
-	int nbPatterns = Size(patterns);
-	for (int i = 0; i < nbPatterns - 2; i++) {
-		for (int j = i + 1; j < nbPatterns - 1; j++) {
-			for (int k = j + 1; k < nbPatterns - 0; k++) {
-				const auto* a = &patterns[i];
-				const auto* b = &patterns[j];
-				const auto* c = &patterns[k];
-				// if the pattern sizes are too different to be part of the same symbol, skip this
-				// and the rest of the innermost loop (sorted list)
-				if (c->size > a->size * 2)
-					break;
-
-				// Orders the three points in an order [A,B,C] such that AB is less than AC
-				// and BC is less than AC, and the angle between BC and BA is less than 180 degrees.
-
-				auto distAB2 = squaredDistance(a, b);
-				auto distBC2 = squaredDistance(b, c);
-				auto distAC2 = squaredDistance(a, c);
-
-				if (distBC2 >= distAB2 && distBC2 >= distAC2) {
-					std::swap(a, b);
-					std::swap(distBC2, distAC2);
-				} else if (distAB2 >= distAC2 && distAB2 >= distBC2) {
-					std::swap(b, c);
-					std::swap(distAB2, distAC2);
-				}
-
-				auto distAB = std::sqrt(distAB2);
-				auto distBC = std::sqrt(distBC2);
-
-				// Make sure distAB and distBC don't differ more than reasonable
-				// TODO: make sure the constant 2 is not to conservative for reasonably tilted symbols
-				if (distAB > 2 * distBC || distBC > 2 * distAB)
-					continue;
-
-				// Estimate the module count and ignore this set if it can not result in a valid decoding
-				if (auto moduleCount = (distAB + distBC) / (2 * (a->size + b->size + c->size) / (3 * 7.f)) + 7;
-					moduleCount < 21 * 0.9 || moduleCount > 177 * 1.5) // moduleCount may be overestimated, see above
-					continue;
+	// The moduleCount check below limits distAB + distBC and the cosAB_BC check limits distAC to distAB + distBC.
+	// Since the scaled distances are never shorter than the euclidean ones, all three patterns of a plausible set are
+	// within maxDistance(sum of their sizes) of each other. With c->size <= 2 * a->size that sum is at most
+	// 5 * a->size, which is used for the neighbor lookup (the factor 1.01 covers rounding effects).
+	constexpr double MAX_MODULE_COUNT = 177 * 1.5;
+	auto maxDistance = [](int sizeSum) { return (MAX_MODULE_COUNT - 7) * 2 * sizeSum / (3 * 7.) * 1.01; };
+
+	auto addSet = [&](const ConcentricPattern* a, const ConcentricPattern* b, const ConcentricPattern* c) {
+		// Orders the three points in an order [A,B,C] such that AB is less than AC
+		// and BC is less than AC, and the angle between BC and BA is less than 180 degrees.
+
+		auto distAB2 = squaredDistance(a, b);
+		auto distBC2 = squaredDistance(b, c);
+		auto distAC2 = squaredDistance(a, c);
+
+		if (distBC2 >= distAB2 && distBC2 >= distAC2) {
+			std::swap(a, b);
+			std::swap(distBC2, distAC2);
+		} else if (distAB2 >= distAC2 && distAB2 >= distBC2) {
+			std::swap(b, c);
+			std::swap(distAB2, distAC2);
+		}
 
-				// Make sure the angle between AB and BC does not deviate from 90° too much
-				auto cosAB_BC = (distAB2 + distBC2 - distAC2) / (2 * distAB * distBC);
-				if (std::isnan(cosAB_BC) || cosAB_BC > cosUpper || cosAB_BC < cosLower)
-					continue;
+		auto distAB = std::sqrt(distAB2);
+		auto distBC = std::sqrt(distBC2);
+
+		// Make sure distAB and distBC don't differ more than reasonable
+		// TODO: make sure the constant 2 is not to conservative for reasonably tilted symbols
+		if (distAB > 2 * distBC || distBC > 2 * distAB)
+			return;
+
+		// Estimate the module count and ignore this set if it can not result in a valid decoding
+		if (auto moduleCount = (distAB + distBC) / (2 * (a->size + b->size + c->size) / (3 * 7.f)) + 7;
+			moduleCount < 21 * 0.9 || moduleCount > MAX_MODULE_COUNT) // moduleCount may be overestimated, see above
+			return;
+
+		// Make sure the angle between AB and BC does not deviate from 90° too much
+		auto cosAB_BC = (distAB2 + distBC2 - distAC2) / (2 * distAB * distBC);
+		if (std::isnan(cosAB_BC) || cosAB_BC > cosUpper || cosAB_BC < cosLower)
+			return;
+
+		// a^2 + b^2 = c^2 (Pythagorean theorem), and a = b (isosceles triangle).
+		// Since any right triangle satisfies the formula c^2 - b^2 - a^2 = 0,
+		// we need to check both two equal sides separately.
+		// The value of |c^2 - 2 * b^2| + |c^2 - 2 * a^2| increases as dissimilarity
+		// from isosceles right triangle.
+		double d = (std::abs(distAC2 - 2 * distAB2) + std::abs(distAC2 - 2 * distBC2));
+
+		// Use cross product to figure out whether A and C are correct or flipped.
+		// This asks whether BC x BA has a positive z component, which is the arrangement
+		// we want for A, B, C. If it's negative then swap A and C.
+		if (cross(*c - *b, *a - *b) < 0)
+			std::swap(a, c);
+
+		// arbitrarily limit the number of potential sets
+		// (this has performance implications while limiting the maximal number of detected symbols)
+		const auto setSizeLimit = 256;
+		if (sets.size() < setSizeLimit || sets.crbegin()->first > d) {
+			sets.emplace(d, FinderPatternSet{*a, *b, *c});
+			if (sets.size() > setSizeLimit)
+				sets.erase(std::prev(sets.end()));
+		}
+	};
 
-				// a^2 + b^2 = c^2 (Pythagorean theorem), and a = b (isosceles triangle).
-				// Since any right triangle satisfies the formula c^2 - b^2 - a^2 = 0,
-				// we need to check both two equal sides separately.
-				// The value of |c^2 - 2 * b^2| + |c^2 - 2 * a^2| increases as dissimilarity
-				// from isosceles right triangle.
-				double d = (std::abs(distAC2 - 2 * distAB2) + std::abs(distAC2 - 2 * distBC2));
-
-				// Use cross product to figure out whether A and C are correct or flipped.
-				// This asks whether BC x BA has a positive z component, which is the arrangement
-				// we want for A, B, C. If it's negative then swap A and C.
-				if (cross(*c - *b, *a - *b) < 0)
-					std::swap(a, c);
-
-				// arbitrarily limit the number of potential sets
-				// (this has performance implications while limiting the maximal number of detected symbols)
-				const auto setSizeLimit = 256;
-				if (sets.size() < setSizeLimit || sets.crbegin()->first > d) {
-					sets.emplace(d, FinderPatternSet{*a, *b, *c});
-					if (sets.size() > setSizeLimit)
-						sets.erase(std::prev(sets.end()));
-				}
+	// Instead of iterating over all triples, only the neighbors of pattern i that are close enough and not too different
+	// in size (see below) are considered. The neighbor lists are sorted, so the sets are visited in the same (i, j, k)
+	// order as with the plain triple loop, which keeps the ranking (including the order of equally ranked sets).
+	int nbPatterns = Size(patterns);
+	auto grid = FinderPatternGrid(patterns, nbPatterns ? maxDistance(5 * patterns[nbPatterns / 2].size) : 1);
+	for (int i = 0; i < nbPatterns - 2; i++) {
+		const auto* a = &patterns[i];
+		auto maxDistA = maxDistance(5 * a->size);
+		auto nbs = grid.neighbors(*a, maxDistA);
+		// if the pattern sizes are too different to be part of the same symbol, skip them
+		nbs.erase(std::remove_if(nbs.begin(), nbs.end(), [&](int j) { return j <= i || patterns[j].size > a->size * 2; }),
+				  nbs.end());
+
+		for (int j = 0; j < Size(nbs) - 1; j++) {
+			const auto* b = &patterns[nbs[j]];
+			for (int k = j + 1; k < Size(nbs); k++) {
+				const auto* c = &patterns[nbs[k]];
+				if (distance(*b, *c) <= maxDistance(a->size + b->size + c->size))
+					addSet(a, b, c);
 			}
 		}
 	}
@@ -565,6 +690,56 @@ DetectorResult DetectPureQR(const BitMatrix& image)
 			{{left, top}, {right, top}, {right, bottom}, {left, bottom}}};
 }
 
+/**
+* Variant of DetectPureQR() for "pure" images of a code that is rotated by a multiple of 90 degrees and/or slightly
+* skewed. The corners of the symbol are the black pixels closest to the corners of the bounding box, three of which
+* have to be the outer corners of a finder pattern. The fourth corner is extrapolated from the other three.
+*/
+DetectorResult DetectPureQRRotated(const BitMatrix& image)
+{
+	using Pattern = std::array<PatternView::value_type, PATTERN.size()>;
+
+	constexpr int MIN_MODULES = Version::SymbolSize(1, Type::Model2).x;
+
+	int left, top, width, height;
+	std::array<PointI, 4> corners;
+	if (!image.findBoundingBox(left, top, width, height, MIN_MODULES) || std::abs(width - height) > 1
+		|| !image.findCorners(left, top, width, height, corners))
+		return {};
+
+	// look for a finder pattern along the diagonal from each corner, exactly one corner must not have one
+	std::array<int, 4> fpWidths = {};
+	std::array<PointF, 4> dirs;
+	int missing = -1;
+	for (int i = 0; i < 4; ++i) {
+		auto diagonal = corners[(i + 2) % 4] - corners[i];
+		dirs[i] = bresenhamDirection(PointF(diagonal));
+		auto pattern = BitMatrixCursorF(image, centered(corners[i]), dirs[i])
+						   .readPatternFromBlack<Pattern>(1, maxAbsComponent(diagonal) / 3 + 1);
+		if (IsPattern(pattern, PATTERN))
+			fpWidths[i] = Reduce(pattern);
+		else if (missing == -1)
+			missing = i;
+		else
+			return {};
+	}
+	if (missing == -1)
+		return {};
+
+	int tl = (missing + 2) % 4, tr = (missing + 3) % 4, bl = (missing + 1) % 4;
+	auto center = [&](int i) { return ConcentricPattern{centered(corners[i]) + fpWidths[i] / 2.f * dirs[i], fpWidths[i]}; };
+	auto dimension = EstimateDimension(image, center(tl), center(tr)).dim;
+	if (!Version::IsValidSize({dimension, dimension}, Type::Model2))
+		return {};
+
+	// outer corners of the corner pixels
+	constexpr PointI offsets[] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+	auto outer = [&](int i) { return PointF(corners[i] + offsets[i]); };
+	QuadrilateralF quad = {outer(tl), outer(tr), outer(tr) + outer(bl) - outer(tl), outer(bl)};
+
+	return SampleGrid(image, dimension, dimension, PerspectiveTransform(Rectangle(dimension, dimension, 0), quad));
+}
+
 DetectorResult DetectPureMQR(const BitMatrix& image)
 {
 	using Pattern = std::array<PatternView::value_type, PATTERN.size()>;
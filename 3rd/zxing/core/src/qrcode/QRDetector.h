@@ -8,6 +8,7 @@
 #pragma once
 
 #include "ConcentricFinder.h"
+#include "Deadline.h"
 #include "DetectorResult.h"
 
 #include <vector>
@@ -27,7 +28,12 @@ struct FinderPatternSet
 using FinderPatterns = std::vector<ConcentricPattern>;
 using FinderPatternSets = std::vector<FinderPatternSet>;
 
-FinderPatterns FindFinderPatterns(const BitMatrix& image, bool tryHarder);
+/**
+ * @brief FindFinderPatterns scans the image for QRCode finder patterns
+ * @param maxThreads maximum number of horizontal stripes scanned concurrently (large images only), 0 means one per core
+ * @param deadline the remaining rows are skipped once it expired
+ */
+FinderPatterns FindFinderPatterns(const BitMatrix& image, bool tryHarder, int maxThreads = 0, const Deadline& deadline = {});
 FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns);
 
 DetectorResult SampleQR(const BitMatrix& image, const FinderPatternSet& fp);
@@ -35,6 +41,7 @@ DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp);
 DetectorResult SampleRMQR(const BitMatrix& image, const ConcentricPattern& fp);
 
 DetectorResult DetectPureQR(const BitMatrix& image);
+DetectorResult DetectPureQRRotated(const BitMatrix& image);
 DetectorResult DetectPureMQR(const BitMatrix& image);
 DetectorResult DetectPureRMQR(const BitMatrix& image);
 
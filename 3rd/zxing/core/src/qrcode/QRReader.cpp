@@ -13,14 +13,21 @@
 #include "DecoderResult.h"
 #include "DetectorResult.h"
 #include "LogMatrix.h"
+#include "Parallel.h"
 #include "QRDecoder.h"
 #include "QRDetector.h"
+#include "ReadTimings.h"
 #include "Barcode.h"
 
 #include <utility>
+#include <vector>
 
 namespace ZXing::QRCode {
 
+// the formats this reader is registered for in MultiFormatReader
+static const BarcodeFormats ReaderFormats =
+	BarcodeFormat::QRCode | BarcodeFormat::MicroQRCode | BarcodeFormat::RMQRCode;
+
 Barcode Reader::decode(const BinaryBitmap& image) const
 {
 #if 1
@@ -32,18 +39,27 @@ Barcode Reader::decode(const BinaryBitmap& image) const
 	if (binImg == nullptr)
 		return {};
 
+	ReadTimings::Stages stages;
 	DetectorResult detectorResult;
-	if (_opts.hasFormat(BarcodeFormat::QRCode))
-		detectorResult = DetectPureQR(*binImg);
-	if (_opts.hasFormat(BarcodeFormat::MicroQRCode) && !detectorResult.isValid())
-		detectorResult = DetectPureMQR(*binImg);
-	if (_opts.hasFormat(BarcodeFormat::RMQRCode) && !detectorResult.isValid())
-		detectorResult = DetectPureRMQR(*binImg);
-
-	if (!detectorResult.isValid())
+	{
+		ScopedTiming timing(&stages.detect);
+		if (_opts.hasFormat(BarcodeFormat::QRCode))
+			detectorResult = DetectPureQR(*binImg);
+		if (_opts.hasFormat(BarcodeFormat::QRCode) && _opts.tryRotate() && !detectorResult.isValid())
+			detectorResult = DetectPureQRRotated(*binImg);
+		if (_opts.hasFormat(BarcodeFormat::MicroQRCode) && !detectorResult.isValid())
+			detectorResult = DetectPureMQR(*binImg);
+		if (_opts.hasFormat(BarcodeFormat::RMQRCode) && !detectorResult.isValid())
+			detectorResult = DetectPureRMQR(*binImg);
+	}
+
+	if (!detectorResult.isValid()) {
+		addStageTimings(ReaderFormats, stages);
 		return {};
+	}
 
-	auto decoderResult = Decode(detectorResult.bits());
+	auto decoderResult = Decode(detectorResult.bits(), &stages);
+	addStageTimings(ReaderFormats, stages);
 	auto format = detectorResult.bits().width() != detectorResult.bits().height() ? BarcodeFormat::RMQRCode
 				  : detectorResult.bits().width() < 21                            ? BarcodeFormat::MicroQRCode
 																				  : BarcodeFormat::QRCode;
@@ -67,6 +83,47 @@ void logFPSet(const FinderPatternSet& fps [[maybe_unused]])
 #endif
 }
 
+struct DecodedCandidate
+{
+	DetectorResult detRes;
+	DecoderResult decRes;
+	ReadTimings::Stages stages;
+};
+
+// Samples and decodes the candidates concurrently in batches. The results of each batch are processed in candidate
+// order, and skip() is checked again before accepting one, so the conflict resolution (see usedFPs) and the returned
+// list are exactly the same as with a sequential loop. accept() returns false to stop the search. The stage timings of
+// all decoded candidates are added to stages.
+template <typename CANDIDATE, typename SKIP, typename DECODE, typename ACCEPT>
+static void DecodeCandidates(const std::vector<CANDIDATE>& candidates, int maxSymbols, int maxThreads,
+							 ReadTimings::Stages& stages, SKIP skip, DECODE decode, ACCEPT accept)
+{
+	constexpr int MIN_CANDIDATES_PARALLEL = 8; // below that, starting threads costs more than it saves
+
+	// speculatively decoding more candidates than needed is only worth it if more than one symbol is requested
+	int nbThreads = maxSymbols == 1 || Size(candidates) < MIN_CANDIDATES_PARALLEL ? 1 : ThreadCount(maxThreads);
+	int batchSize = nbThreads == 1 ? 1 : 4 * nbThreads;
+
+	std::vector<const CANDIDATE*> batch;
+	std::vector<DecodedCandidate> results;
+	for (auto next = candidates.begin(); next != candidates.end();) {
+		batch.clear();
+		for (; next != candidates.end() && Size(batch) < batchSize; ++next)
+			if (!skip(*next))
+				batch.push_back(&*next);
+
+		results.clear();
+		results.resize(batch.size());
+		ParallelFor(Size(batch), nbThreads, [&](int i) { results[i] = decode(*batch[i]); });
+		for (auto& r : results)
+			stages += r.stages;
+
+		for (int i = 0; i < Size(batch); ++i)
+			if (!skip(*batch[i]) && !accept(*batch[i], results[i]))
+				return;
+	}
+}
+
 Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 {
 	auto binImg = image.getBitMatrix();
@@ -75,9 +132,17 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 
 #ifdef PRINT_DEBUG
 	LogMatrixWriter lmw(log, *binImg, 5, "qr-log.pnm");
+	// the log matrix is not thread safe
+	const int maxThreads = 1;
+#else
+	const int maxThreads = _opts.maxThreads();
 #endif
-	
-	auto allFPs = FindFinderPatterns(*binImg, _opts.tryHarder());
+
+	ReadTimings::Stages stages;
+	auto allFPs = [&] {
+		ScopedTiming timing(&stages.detect);
+		return FindFinderPatterns(*binImg, _opts.tryHarder(), maxThreads, _opts.deadline());
+	}();
 
 #ifdef PRINT_DEBUG
 	printf("allFPs: %d\n", Size(allFPs));
@@ -85,69 +150,70 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 
 	std::vector<ConcentricPattern> usedFPs;
 	Barcodes res;
-	
-	if (_opts.hasFormat(BarcodeFormat::QRCode)) {
-		auto allFPSets = GenerateFinderPatternSets(allFPs);
-		for (const auto& fpSet : allFPSets) {
-			if (Contains(usedFPs, fpSet.bl) || Contains(usedFPs, fpSet.tl) || Contains(usedFPs, fpSet.tr))
-				continue;
 
-			logFPSet(fpSet);
+	auto isUsed = [&](const ConcentricPattern& fp) { return Contains(usedFPs, fp); };
+	auto isFull = [&] { return maxSymbols && Size(res) == maxSymbols; };
 
-			auto detectorResult = SampleQR(*binImg, fpSet);
-			if (detectorResult.isValid()) {
-				auto decoderResult = Decode(detectorResult.bits());
-				if (decoderResult.isValid()) {
+	if (_opts.hasFormat(BarcodeFormat::QRCode)) {
+		auto allFPSets = [&] {
+			ScopedTiming timing(&stages.detect);
+			return GenerateFinderPatternSets(allFPs);
+		}();
+		DecodeCandidates(
+			allFPSets, maxSymbols, maxThreads, stages,
+			[&](const FinderPatternSet& fpSet) { return isUsed(fpSet.bl) || isUsed(fpSet.tl) || isUsed(fpSet.tr); },
+			[&](const FinderPatternSet& fpSet) {
+				logFPSet(fpSet);
+				DecodedCandidate r;
+				{
+					ScopedTiming timing(&r.stages.sample);
+					r.detRes = SampleQR(*binImg, fpSet);
+				}
+				if (r.detRes.isValid())
+					r.decRes = Decode(r.detRes.bits(), &r.stages);
+				return r;
+			},
+			[&](const FinderPatternSet& fpSet, DecodedCandidate& r) {
+				if (r.decRes.isValid()) {
 					usedFPs.push_back(fpSet.bl);
 					usedFPs.push_back(fpSet.tl);
 					usedFPs.push_back(fpSet.tr);
 				}
-				if (decoderResult.isValid(_opts.returnErrors())) {
-					res.emplace_back(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::QRCode);
-					if (maxSymbols && Size(res) == maxSymbols)
-						break;
-				}
-			}
-		}
+				if (r.detRes.isValid() && r.decRes.isValid(_opts.returnErrors()))
+					res.emplace_back(std::move(r.decRes), std::move(r.detRes), BarcodeFormat::QRCode);
+				return !isFull();
+			});
 	}
-	
-	if (_opts.hasFormat(BarcodeFormat::MicroQRCode) && !(maxSymbols && Size(res) == maxSymbols)) {
-		for (const auto& fp : allFPs) {
-			if (Contains(usedFPs, fp))
-				continue;
-
-			auto detectorResult = SampleMQR(*binImg, fp);
-			if (detectorResult.isValid()) {
-				auto decoderResult = Decode(detectorResult.bits());
-				if (decoderResult.isValid(_opts.returnErrors())) {
-					res.emplace_back(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::MicroQRCode);
-					if (maxSymbols && Size(res) == maxSymbols)
-						break;
-				}
 
-			}
-		}
-	}
-	
-	if (_opts.hasFormat(BarcodeFormat::RMQRCode) && !(maxSymbols && Size(res) == maxSymbols)) {
-		// TODO proper
-		for (const auto& fp : allFPs) {
-			if (Contains(usedFPs, fp))
-				continue;
-
-			auto detectorResult = SampleRMQR(*binImg, fp);
-			if (detectorResult.isValid()) {
-				auto decoderResult = Decode(detectorResult.bits());
-				if (decoderResult.isValid(_opts.returnErrors())) {
-					res.emplace_back(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::RMQRCode);
-					if (maxSymbols && Size(res) == maxSymbols)
-						break;
+	// the MicroQRCode and rMQRCode candidates are the single finder patterns that are not part of a decoded QRCode
+	auto decodeSingleFPs = [&](auto sample, BarcodeFormat format) {
+		DecodeCandidates(
+			allFPs, maxSymbols, maxThreads, stages, isUsed,
+			[&](const ConcentricPattern& fp) {
+				DecodedCandidate r;
+				{
+					ScopedTiming timing(&r.stages.sample);
+					r.detRes = sample(*binImg, fp);
 				}
+				if (r.detRes.isValid())
+					r.decRes = Decode(r.detRes.bits(), &r.stages);
+				return r;
+			},
+			[&](const ConcentricPattern&, DecodedCandidate& r) {
+				if (r.detRes.isValid() && r.decRes.isValid(_opts.returnErrors()))
+					res.emplace_back(std::move(r.decRes), std::move(r.detRes), format);
+				return !isFull();
+			});
+	};
 
-			}
-		}
-	}
+	if (_opts.hasFormat(BarcodeFormat::MicroQRCode) && !isFull())
+		decodeSingleFPs(SampleMQR, BarcodeFormat::MicroQRCode);
+
+	// TODO proper
+	if (_opts.hasFormat(BarcodeFormat::RMQRCode) && !isFull())
+		decodeSingleFPs(SampleRMQR, BarcodeFormat::RMQRCode);
 
+	addStageTimings(ReaderFormats, stages);
 	return res;
 }
 
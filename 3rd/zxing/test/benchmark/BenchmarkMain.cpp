@@ -0,0 +1,230 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "GenericGF.h"
+#include "GlobalHistogramBinarizer.h"
+#include "GridSampler.h"
+#include "HybridBinarizer.h"
+#include "MultiFormatWriter.h"
+#include "PerspectiveTransform.h"
+#include "ReadBarcode.h"
+#include "ReadTimings.h"
+#include "ReedSolomonDecoder.h"
+#include "ReedSolomonEncoder.h"
+#include "SyntheticCorpus.h"
+#include "ThresholdBinarizer.h"
+#include "qrcode/QRDetector.h"
+#include "qrcode/QREncodeResult.h"
+#include "qrcode/QREncoder.h"
+#include "qrcode/QRErrorCorrectionLevel.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::Benchmark;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Settings
+{
+	std::string filter;
+	std::chrono::milliseconds minTime{500};
+};
+
+// keeps the optimizer from discarding the benchmarked computations
+volatile int64_t sink = 0;
+
+template <typename T>
+void Consume(T value)
+{
+	sink = static_cast<int64_t>(value);
+}
+
+/**
+ * Runs op (one operation per call) until minTime has passed (at least once, after one untimed warm-up call) and
+ * prints the result as a single JSON object per line. extra is printed as additional numeric members.
+ */
+void Run(const Settings& settings, const std::string& name, const std::function<void()>& op,
+		 const std::map<std::string, double>& extra = {})
+{
+	if (name.find(settings.filter) == std::string::npos)
+		return;
+
+	if (settings.minTime.count() > 0)
+		op();
+
+	int64_t iterations = 0;
+	auto start = Clock::now();
+	auto elapsed = Clock::duration::zero();
+	do {
+		op();
+		++iterations;
+		elapsed = Clock::now() - start;
+	} while (elapsed < settings.minTime);
+
+	double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+	std::printf(R"({"name":"%s","iterations":%lld,"ns_per_op":%.1f,"ops_per_sec":%.2f)", name.c_str(),
+				static_cast<long long>(iterations), ns, 1e9 / ns);
+	for (auto& [key, value] : extra)
+		std::printf(R"(,"%s":%.4f)", key.c_str(), value);
+	std::printf("}\n");
+	std::fflush(stdout);
+}
+
+const std::vector<BarcodeFormat> Formats = {BarcodeFormat::QRCode,  BarcodeFormat::DataMatrix, BarcodeFormat::Aztec,
+											BarcodeFormat::PDF417,  BarcodeFormat::Code128,    BarcodeFormat::EAN13};
+
+constexpr int CORPUS_SIZE = 8;
+constexpr int FRAME_WIDTH = 640, FRAME_HEIGHT = 480;
+
+void StageBenchmarks(const Settings& settings)
+{
+	// a 720p frame with a mildly distorted QR code, typical for the camera use case
+	auto symbol = MultiFormatWriter(BarcodeFormat::QRCode).setMargin(0).encode(SampleText(BarcodeFormat::QRCode, 0), 0, 0);
+	auto frame = Render(symbol, Distortions().back(), 1280, 720, 1);
+	auto iv = frame.view();
+
+	Run(settings, "binarize/LocalAverage/1280x720", [&] { Consume(HybridBinarizer(iv).getBitMatrix()->width()); });
+	Run(settings, "binarize/GlobalHistogram/1280x720", [&] { Consume(GlobalHistogramBinarizer(iv).getBitMatrix()->width()); });
+	Run(settings, "binarize/FixedThreshold/1280x720", [&] { Consume(ThresholdBinarizer(iv, 127).getBitMatrix()->width()); });
+
+	auto bits = HybridBinarizer(iv).getBitMatrix()->copy();
+	Run(settings, "finder/QRCode/1280x720", [&] { Consume(QRCode::FindFinderPatterns(bits, false, 1).size()); });
+	Run(settings, "finder/QRCode/1280x720/tryHarder", [&] { Consume(QRCode::FindFinderPatterns(bits, true, 1).size()); });
+
+	// sampling every module of a 1 pixel per module symbol, i.e. the per module cost of the grid sampler
+	auto pure = MultiFormatWriter(BarcodeFormat::QRCode).setMargin(0).encode(std::string(150, 'A'), 0, 0);
+	int dim = pure.width();
+	auto toImage = PerspectiveTransform(Rectangle<PointF>(dim, dim), Rectangle<PointF>(dim, dim));
+	Run(settings, "sample/grid/" + std::to_string(dim) + "x" + std::to_string(dim),
+		[&] { Consume(SampleGrid(pure, dim, dim, toImage).bits().width()); });
+
+	// largest QR code block (version 40-L): 118 data + 30 error correction code words, 15 errors (the maximum)
+	const auto& field = GenericGF::QRCodeField256();
+	std::vector<int> codewords(148);
+	for (size_t i = 0; i < codewords.size(); ++i)
+		codewords[i] = (i * 37 + 11) & 0xff;
+	ReedSolomonEncode(field, codewords, 30);
+	auto corrupted = codewords;
+	for (int i = 0; i < 15; ++i)
+		corrupted[i * 9] ^= 0x5a;
+	Run(settings, "reedsolomon/QRCode/148-30/15errors", [&] {
+		auto message = corrupted;
+		Consume(ReedSolomonDecode(field, message, 30));
+	});
+
+	auto content = std::wstring(L"MASK-SELECTION-") + std::wstring(100, L'7');
+	Run(settings, "encoder/QRCode/auto-mask", [&] {
+		Consume(QRCode::Encode(content, QRCode::ErrorCorrectionLevel::Medium, CharacterSet::Unknown, 0, false).maskPattern);
+	});
+	Run(settings, "encoder/QRCode/fixed-mask", [&] {
+		Consume(QRCode::Encode(content, QRCode::ErrorCorrectionLevel::Medium, CharacterSet::Unknown, 0, false, 0).maskPattern);
+	});
+}
+
+double Millis(ReadTimings::Duration d, int n)
+{
+	return std::chrono::duration<double, std::milli>(d).count() / n;
+}
+
+// returns false if a symbol of an undistorted corpus was not decoded
+bool DecodeBenchmarks(const Settings& settings)
+{
+	bool ok = true;
+	for (auto format : Formats) {
+		for (const auto& distortion : Distortions()) {
+			auto name = "decode/" + ToString(format) + "/" + distortion.name;
+			if (name.find(settings.filter) == std::string::npos)
+				continue;
+
+			auto corpus = GenerateCorpus(format, distortion, CORPUS_SIZE, FRAME_WIDTH, FRAME_HEIGHT);
+
+			// one untimed pass to determine the success rate and the per stage timings
+			ReadTimings timings;
+			auto opts = ReaderOptions().setFormats(format).setTimings(&timings);
+			int decoded = 0;
+			for (auto& sample : corpus) {
+				auto res = ReadBarcode(sample.frame.view(), opts);
+				decoded += res.isValid() && res.text() == sample.text;
+			}
+			double successRate = double(decoded) / Size(corpus);
+			if (distortion.name == "clean" && decoded != Size(corpus)) {
+				std::cerr << name << ": decoded only " << decoded << " of " << Size(corpus) << " clean samples\n";
+				ok = false;
+			}
+
+			std::map<std::string, double> extra = {
+				{"success_rate", successRate},
+				{"lum_ms", Millis(timings.lumExtraction, Size(corpus))},
+				{"pyramid_ms", Millis(timings.pyramid, Size(corpus))},
+				{"binarize_ms", Millis(timings.binarize, Size(corpus))},
+			};
+			for (auto& reader : timings.readers) {
+				extra["reader_ms"] += Millis(reader.time, Size(corpus));
+				extra["detect_ms"] += Millis(reader.stages.detect, Size(corpus));
+				extra["sample_ms"] += Millis(reader.stages.sample, Size(corpus));
+				extra["decode_ms"] += Millis(reader.stages.decode, Size(corpus));
+				extra["error_correction_ms"] += Millis(reader.stages.errorCorrection, Size(corpus));
+			}
+
+			opts.setTimings(nullptr);
+			size_t i = 0;
+			Run(settings, name, [&] { Consume(ReadBarcode(corpus[i++ % corpus.size()].frame.view(), opts).isValid()); }, extra);
+		}
+	}
+
+	// the cost of looking for all formats in a frame that contains only one
+	if (std::string("decode/any/clean").find(settings.filter) != std::string::npos) {
+		auto corpus = GenerateCorpus(BarcodeFormat::QRCode, Distortions().front(), CORPUS_SIZE, FRAME_WIDTH, FRAME_HEIGHT);
+		size_t i = 0;
+		Run(settings, "decode/any/clean", [&] { Consume(ReadBarcode(corpus[i++ % corpus.size()].frame.view()).isValid()); });
+	}
+	return ok;
+}
+
+void EncodeBenchmarks(const Settings& settings)
+{
+	for (auto format : Formats) {
+		int i = 0;
+		Run(settings, "encode/" + ToString(format), [&] {
+			Consume(MultiFormatWriter(format).encode(SampleText(format, i++ % CORPUS_SIZE), 0, 0).width());
+		});
+	}
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	Settings settings;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			settings.filter = argv[++i];
+		} else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+			settings.minTime = std::chrono::milliseconds(std::atoi(argv[++i]));
+		} else {
+			std::cerr << "Usage: " << argv[0] << " [--filter <substring>] [--min-time <ms per benchmark>]\n\n"
+					  << "Prints one JSON object per benchmark and line. Exits with 1 if a symbol in one of the\n"
+					  << "undistorted ('clean') synthetic corpora could not be decoded.\n";
+			return 2;
+		}
+	}
+
+	StageBenchmarks(settings);
+	bool ok = DecodeBenchmarks(settings);
+	EncodeBenchmarks(settings);
+
+	return ok ? 0 : 1;
+}
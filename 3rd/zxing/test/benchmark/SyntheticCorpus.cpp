@@ -0,0 +1,128 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "SyntheticCorpus.h"
+
+#include "GridSampler.h"
+#include "MultiFormatWriter.h"
+#include "PerspectiveTransform.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ZXing::Benchmark {
+
+const std::vector<Distortion>& Distortions()
+{
+	static const std::vector<Distortion> distortions = {
+		{"clean"},
+		{"rotated", 17},
+		{"perspective", 0, 0.25},
+		{"blurred", 0, 0, 1},
+		{"noisy", 0, 0, 0, 30},
+		{"mixed", -9, 0.15, 1, 20},
+	};
+	return distortions;
+}
+
+static void BoxBlur(std::vector<int>& img, int width, int height, int radius)
+{
+	std::vector<int> tmp(img.size());
+	auto pass = [&](const std::vector<int>& src, std::vector<int>& dst, int n, int lines, int step, int stride) {
+		for (int l = 0; l < lines; ++l)
+			for (int i = 0; i < n; ++i) {
+				int sum = 0;
+				for (int k = -radius; k <= radius; ++k)
+					sum += src[l * stride + std::clamp(i + k, 0, n - 1) * step];
+				dst[l * stride + i * step] = sum / (2 * radius + 1);
+			}
+	};
+	pass(img, tmp, width, height, 1, width);
+	pass(tmp, img, height, width, width, 1);
+}
+
+LumFrame Render(const BitMatrix& symbol, const Distortion& d, int width, int height, uint32_t seed)
+{
+	constexpr int INK = 40, PAPER = 230;
+
+	// linear symbols are stretched to a wide box, matrix symbols keep their aspect ratio
+	double sw = symbol.width(), sh = symbol.height();
+	double bw, bh;
+	if (sh * 4 < sw) {
+		bw = 0.6 * width;
+		bh = 0.35 * height;
+	} else {
+		double scale = std::min(0.6 * width / sw, 0.6 * height / sh);
+		bw = scale * sw;
+		bh = scale * sh;
+	}
+
+	double a = d.rotation * std::acos(-1) / 180, c = std::cos(a), s = std::sin(a);
+	double inset = d.perspective * bw / 2;
+	auto corner = [&](double x, double y) {
+		return PointF(width / 2. + c * x - s * y, height / 2. + s * x + c * y);
+	};
+	QuadrilateralF quad = {corner(-bw / 2 + inset, -bh / 2), corner(bw / 2 - inset, -bh / 2), corner(bw / 2, bh / 2),
+						   corner(-bw / 2, bh / 2)};
+	PerspectiveTransform frameToSymbol(quad, Rectangle<PointF>(symbol.width(), symbol.height()));
+
+	// 2x2 super sampling for anti-aliased module edges
+	std::vector<int> img(width * height);
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x) {
+			int ink = 0;
+			for (double dy : {0.25, 0.75})
+				for (double dx : {0.25, 0.75}) {
+					auto p = frameToSymbol(PointF(x + dx, y + dy));
+					ink += symbol.isIn(p) && symbol.get(p);
+				}
+			img[y * width + x] = PAPER - (PAPER - INK) * ink / 4;
+		}
+
+	if (d.blur > 0) {
+		BoxBlur(img, width, height, d.blur);
+		BoxBlur(img, width, height, d.blur);
+	}
+
+	LumFrame res{std::vector<uint8_t>(width * height), width, height};
+	uint32_t state = seed * 2654435761u + 1;
+	for (size_t i = 0; i < img.size(); ++i) {
+		int noise = 0;
+		if (d.noise > 0) {
+			state = state * 1664525u + 1013904223u; // LCG, good enough for sensor noise and fully reproducible
+			noise = static_cast<int>((state >> 16) % (2 * d.noise + 1)) - d.noise;
+		}
+		res.pixels[i] = static_cast<uint8_t>(std::clamp(img[i] + noise, 0, 255));
+	}
+	return res;
+}
+
+std::string SampleText(BarcodeFormat format, int index)
+{
+	switch (format) {
+	case BarcodeFormat::EAN13: {
+		auto digits = std::to_string(400000000000LL + index * 7919LL);
+		int sum = 0;
+		for (int i = 0; i < 12; ++i)
+			sum += (digits[i] - '0') * (i % 2 ? 3 : 1);
+		return digits + std::to_string((10 - sum % 10) % 10);
+	}
+	case BarcodeFormat::Code128: return "C128-" + std::to_string(1000 + index);
+	default: return "BENCH-" + std::to_string(index) + "-" + ToString(format) + "-0123456789";
+	}
+}
+
+std::vector<Sample> GenerateCorpus(BarcodeFormat format, const Distortion& distortion, int count, int width, int height)
+{
+	std::vector<Sample> res;
+	for (int i = 0; i < count; ++i) {
+		auto text = SampleText(format, i);
+		auto symbol = MultiFormatWriter(format).setMargin(0).encode(text, 0, 0);
+		res.push_back({text, Render(symbol, distortion, width, height, i + 1)});
+	}
+	return res;
+}
+
+} // namespace ZXing::Benchmark
@@ -0,0 +1,58 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BarcodeFormat.h"
+#include "BitMatrix.h"
+#include "ImageView.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ZXing::Benchmark {
+
+/// Image degradations applied when rendering a symbol into a synthetic camera like frame
+struct Distortion
+{
+	std::string name;
+	double rotation = 0;    ///< clockwise, in degrees
+	double perspective = 0; ///< keystone: the top edge is shortened by this fraction of its length
+	int blur = 0;           ///< radius of the (twice applied) box blur in pixels
+	int noise = 0;          ///< amplitude of the uniformly distributed luminance noise
+};
+
+/// The standard set of distortions, starting with the undistorted "clean" one
+const std::vector<Distortion>& Distortions();
+
+struct LumFrame
+{
+	std::vector<uint8_t> pixels;
+	int width = 0, height = 0;
+
+	ImageView view() const { return {pixels.data(), width, height, ImageFormat::Lum}; }
+};
+
+struct Sample
+{
+	std::string text;
+	LumFrame frame;
+};
+
+/**
+ * Render the symbol centered into a width x height frame (dark ink on light paper), covering about 60% of the
+ * frame, then apply the distortion. The result only depends on the arguments, noise is drawn from a generator
+ * seeded with seed.
+ */
+LumFrame Render(const BitMatrix& symbol, const Distortion& distortion, int width, int height, uint32_t seed);
+
+/// Valid content for the given format, unique per index
+std::string SampleText(BarcodeFormat format, int index);
+
+/// Encode count symbols of the given format with the writer and render them with the distortion
+std::vector<Sample> GenerateCorpus(BarcodeFormat format, const Distortion& distortion, int count, int width, int height);
+
+} // namespace ZXing::Benchmark
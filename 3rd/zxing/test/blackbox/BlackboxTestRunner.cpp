@@ -7,6 +7,7 @@
 #include "BlackboxTestRunner.h"
 
 #include "ImageLoader.h"
+#include "Parallel.h"
 #include "ReadBarcode.h"
 #include "Utf.h"
 #include "ZXAlgorithms.h"
@@ -14,15 +15,19 @@
 #include <fmt/core.h>
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <exception>
 #include <fstream>
 #include <map>
+#include <numeric>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace ZXing::Test {
@@ -150,9 +155,16 @@ static std::string checkResult(const fs::path& imgPath, std::string_view expecte
 	return "Error reading file";
 }
 
+using Micros = std::chrono::microseconds;
+
 static int failed = 0;
 static int extra = 0;
 static int totalImageLoadTime = 0;
+static int threadCount = 0;
+
+// per image decode latencies, keyed by format and by "<folder>@<rotation>/<fast|slow|pure>"
+static std::map<std::string, std::vector<Micros>> formatLatencies;
+static std::map<std::string, std::vector<Micros>> testLatencies;
 
 int timeSince(std::chrono::steady_clock::time_point startTime)
 {
@@ -198,6 +210,79 @@ static std::string printPositiveTestStats(int imageCount, const TestCase::TC& tc
 	return failures;
 }
 
+static Micros Sum(const std::vector<Micros>& latencies)
+{
+	return std::accumulate(latencies.begin(), latencies.end(), Micros(0));
+}
+
+// nearest-rank percentile of the (unsorted) latencies
+static Micros Percentile(std::vector<Micros> latencies, double p)
+{
+	if (latencies.empty())
+		return Micros(0);
+	int rank = std::clamp(narrow_cast<int>(std::ceil(p * Size(latencies))) - 1, 0, Size(latencies) - 1);
+	std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+	return latencies[rank];
+}
+
+static double ToMs(Micros us)
+{
+	return us.count() / 1000.0;
+}
+
+static void printLatencyStats()
+{
+	fmt::print("\n{:20} {:>7} {:>9} {:>9} {:>9} {:>10}\n", "format", "images", "p50 ms", "p95 ms", "max ms", "images/s");
+	for (const auto& [format, latencies] : formatLatencies) {
+		auto sum = Sum(latencies);
+		fmt::print("{:20} {:7} {:9.2f} {:9.2f} {:9.2f} {:10.1f}\n", format, Size(latencies), ToMs(Percentile(latencies, 0.5)),
+				   ToMs(Percentile(latencies, 0.95)), ToMs(Percentile(latencies, 1.0)),
+				   sum.count() ? Size(latencies) * 1e6 / sum.count() : 0.0);
+	}
+	fmt::print("(images/s is the single threaded throughput, i.e. the inverse of the mean latency)\n\n");
+}
+
+// baseline file format: one line per test "<key> <images> <p50 us> <p95 us> <total us>"
+static void saveBaseline(const fs::path& path)
+{
+	std::ofstream out(path);
+	if (!out)
+		throw std::runtime_error("Failed to write baseline: " + path.string());
+	for (const auto& [key, latencies] : testLatencies)
+		fmt::print(out, "{} {} {} {} {}\n", key, latencies.size(), Percentile(latencies, 0.5).count(),
+				   Percentile(latencies, 0.95).count(), Sum(latencies).count());
+}
+
+// prints the tests whose total decode time changed by more than 10% (and 5 ms) compared to the baseline
+static void compareBaseline(const fs::path& path)
+{
+	std::ifstream in(path);
+	if (!in)
+		throw std::runtime_error("Failed to read baseline: " + path.string());
+
+	std::map<std::string, int64_t> baseline;
+	std::string key;
+	int64_t images, p50, p95, total;
+	while (in >> key >> images >> p50 >> p95 >> total)
+		baseline[key] = total;
+
+	fmt::print("timing compared to baseline {}:\n", path.string());
+	int64_t oldTotal = 0, newTotal = 0;
+	for (const auto& [key, latencies] : testLatencies) {
+		auto i = baseline.find(key);
+		if (i == baseline.end())
+			continue;
+		auto current = Sum(latencies).count();
+		oldTotal += i->second;
+		newTotal += current;
+		if (std::abs(current - i->second) > std::max<int64_t>(5000, i->second / 10))
+			fmt::print("  {:30} {:9.1f} -> {:9.1f} ms ({:+.0f}%)\n", key, i->second / 1000.0, current / 1000.0,
+					   100.0 * (current - i->second) / std::max<int64_t>(1, i->second));
+	}
+	fmt::print("  {:30} {:9.1f} -> {:9.1f} ms ({:+.0f}%)\n\n", "total", oldTotal / 1000.0, newTotal / 1000.0,
+			   100.0 * (newTotal - oldTotal) / std::max<int64_t>(1, oldTotal));
+}
+
 static std::vector<fs::path> getImagesInDirectory(const fs::path& directory)
 {
 	std::vector<fs::path> result;
@@ -211,8 +296,24 @@ static std::vector<fs::path> getImagesInDirectory(const fs::path& directory)
 	return result;
 }
 
+static ReaderOptions testOptions(ReaderOptions opts, const std::string& tcName)
+{
+	opts.setTryDownscale(tcName == "slow_");
+	opts.setDownscaleFactor(2);
+	opts.setDownscaleThreshold(180);
+	opts.setTryHarder(tcName == "slow");
+	opts.setTryRotate(tcName == "slow");
+	opts.setTryInvert(tcName == "slow");
+	opts.setIsPure(tcName == "pure");
+	if (opts.isPure())
+		opts.setBinarizer(Binarizer::FixedThreshold);
+	// the images are already decoded concurrently, one per thread
+	opts.setMaxThreads(1);
+	return opts;
+}
+
 static void doRunTests(const fs::path& directory, std::string_view format, int totalTests, const std::vector<TestCase>& tests,
-					   ReaderOptions opts)
+					   const ReaderOptions& opts)
 {
 	auto imgPaths = getImagesInDirectory(directory);
 	auto folderName = directory.stem();
@@ -220,6 +321,43 @@ static void doRunTests(const fs::path& directory, std::string_view format, int t
 	if (Size(imgPaths) != totalTests)
 		fmt::print("TEST {} => Expected number of tests: {}, got: {} => FAILED\n", folderName.string(), totalTests, imgPaths.size());
 
+	// every image of every test case and rotation is an independent job, the results are collected in order afterwards
+	struct Job
+	{
+		const fs::path* imgPath;
+		int rotation;
+		const ReaderOptions* opts;
+	};
+	struct Outcome
+	{
+		bool detected = false;
+		std::string error;
+		Micros latency{};
+	};
+
+	std::vector<ReaderOptions> tcOpts;
+	tcOpts.reserve(std::extent_v<decltype(TestCase::tc)> * tests.size());
+	std::vector<Job> jobs;
+	for (auto& test : tests)
+		for (auto& tc : test.tc) {
+			if (tc.name.empty())
+				break;
+			tcOpts.push_back(testOptions(opts, tc.name));
+			for (const auto& imgPath : imgPaths)
+				jobs.push_back({&imgPath, test.rotation, &tcOpts.back()});
+		}
+
+	std::vector<Outcome> outcomes(jobs.size());
+	ParallelFor(Size(jobs), threadCount, [&](int i) {
+		auto startTime = std::chrono::steady_clock::now();
+		auto barcode = ReadBarcode(ImageLoader::load(*jobs[i].imgPath).rotated(jobs[i].rotation), *jobs[i].opts);
+		outcomes[i].latency = std::chrono::duration_cast<Micros>(std::chrono::steady_clock::now() - startTime);
+		outcomes[i].detected = barcode.isValid();
+		if (barcode.isValid())
+			outcomes[i].error = checkResult(*jobs[i].imgPath, format, barcode);
+	});
+
+	auto outcome = outcomes.begin();
 	for (auto& test : tests) {
 		fmt::print("{:20} @ {:3}, {:3}", folderName.string(), test.rotation, Size(imgPaths));
 		std::vector<int> times;
@@ -227,31 +365,22 @@ static void doRunTests(const fs::path& directory, std::string_view format, int t
 		for (auto tc : test.tc) {
 			if (tc.name.empty())
 				break;
-			auto startTime = std::chrono::steady_clock::now();
-			opts.setTryDownscale(tc.name == "slow_");
-			opts.setDownscaleFactor(2);
-			opts.setDownscaleThreshold(180);
-			opts.setTryHarder(tc.name == "slow");
-			opts.setTryRotate(tc.name == "slow");
-			opts.setTryInvert(tc.name == "slow");
-			opts.setIsPure(tc.name == "pure");
-			if (opts.isPure())
-				opts.setBinarizer(Binarizer::FixedThreshold);
+			auto& latencies = testLatencies[fmt::format("{}@{}/{}", folderName.string(), test.rotation, tc.name)];
 			for (const auto& imgPath : imgPaths) {
-				auto barcode = ReadBarcode(ImageLoader::load(imgPath).rotated(test.rotation), opts);
-				if (barcode.isValid()) {
-					auto error = checkResult(imgPath, format, barcode);
-					if (!error.empty())
-						tc.misReadFiles[imgPath] = error;
-				} else {
+				if (!outcome->detected)
 					tc.notDetectedFiles.insert(imgPath);
-				}
+				else if (!outcome->error.empty())
+					tc.misReadFiles[imgPath] = outcome->error;
+				latencies.push_back(outcome->latency);
+				formatLatencies[std::string(format)].push_back(outcome->latency);
+				++outcome;
 			}
 
-			times.push_back(timeSince(startTime));
+			times.push_back(narrow_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(Sum(latencies)).count()));
 			failures += printPositiveTestStats(Size(imgPaths), tc);
 		}
-		fmt::print(" | time: {:3} vs {:3} ms\n", times.front(), times.back());
+		// the images are decoded concurrently, so this is the summed decode latency, not the elapsed time
+		fmt::print(" | latency: {:3} vs {:3} ms\n", times.front(), times.back());
 		if (!failures.empty())
 			fmt::print("\n{}\n", failures);
 	}
@@ -291,8 +420,12 @@ static void doRunStructuredAppendTest(const fs::path& directory, std::string_vie
 		auto tc = test.tc[0];
 		auto startTime = std::chrono::steady_clock::now();
 
+		auto& latencies = testLatencies[fmt::format("{}@{}/{}", folderName.string(), test.rotation, tc.name)];
 		for (const auto& [testPath, testImgPaths] : imageGroups) {
+			auto groupStartTime = std::chrono::steady_clock::now();
 			auto barcode = readMultiple(testImgPaths, format);
+			latencies.push_back(std::chrono::duration_cast<Micros>(std::chrono::steady_clock::now() - groupStartTime));
+			formatLatencies[std::string(format)].push_back(latencies.back());
 			if (barcode.isValid()) {
 				auto error = checkResult(testPath, format, barcode);
 				if (!error.empty())
@@ -309,8 +442,10 @@ static void doRunStructuredAppendTest(const fs::path& directory, std::string_vie
 	}
 }
 
-int runBlackBoxTests(const fs::path& testPathPrefix, const std::set<std::string>& includedTests)
+int runBlackBoxTests(const fs::path& testPathPrefix, const std::set<std::string>& includedTests, const RunOptions& runOptions)
 {
+	threadCount = ThreadCount(runOptions.threads);
+
 	auto hasTest = [&includedTests](const fs::path& dir) {
 		auto stem = dir.stem().string();
 		return includedTests.empty() || Contains(includedTests, stem) ||
@@ -682,8 +817,17 @@ int runBlackBoxTests(const fs::path& testPathPrefix, const std::set<std::string>
 
 		int totalTime = timeSince(startTime);
 		int decodeTime = totalTime - totalImageLoadTime;
+		printLatencyStats();
+		if (!runOptions.baseline.empty())
+			compareBaseline(runOptions.baseline);
+		if (!runOptions.saveBaseline.empty())
+			saveBaseline(runOptions.saveBaseline);
 		fmt::print("load time:   {} ms.\n", totalImageLoadTime);
-		fmt::print("decode time: {} ms.\n", decodeTime);
+		fmt::print("decode time: {} ms on {} threads ({} ms summed over all images).\n", decodeTime, threadCount,
+				   std::chrono::duration_cast<std::chrono::milliseconds>(
+					   std::accumulate(formatLatencies.begin(), formatLatencies.end(), Micros(0),
+									   [](Micros sum, const auto& entry) { return sum + Sum(entry.second); }))
+					   .count());
 		fmt::print("total time:  {} ms.\n", totalTime);
 		if (failed)
 			fmt::print("WARNING: {} tests failed.\n", failed);
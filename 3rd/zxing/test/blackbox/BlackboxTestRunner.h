@@ -12,6 +12,14 @@
 
 namespace ZXing::Test {
 
-int runBlackBoxTests(const fs::path& blackboxPath, const std::set<std::string>& includedTests);
+struct RunOptions
+{
+	int threads = 0;         ///< number of threads decoding the images, 0 means one per core
+	fs::path baseline;       ///< timings file of an earlier run to compare the per test decode times with
+	fs::path saveBaseline;   ///< file to store the timings of this run in
+};
+
+int runBlackBoxTests(const fs::path& blackboxPath, const std::set<std::string>& includedTests,
+					 const RunOptions& runOptions = {});
 
 } // ZXing::Test
@@ -12,6 +12,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -49,9 +50,11 @@ public:
 };
 
 std::map<fs::path, STBImage> cache;
+std::mutex cacheMutex; // the black box tests decode images of the cache concurrently
 
 void ImageLoader::clearCache()
 {
+	std::lock_guard lock(cacheMutex);
 	cache.clear();
 }
 
@@ -59,6 +62,7 @@ const ImageView& ImageLoader::load(const fs::path& imgPath)
 {
 	thread_local std::unique_ptr<BinaryBitmap> localAverage, threshold;
 
+	std::lock_guard lock(cacheMutex);
 	auto& binImg = cache[imgPath];
 	if (!binImg)
 		binImg.load(imgPath);
@@ -27,7 +27,11 @@ int getEnv(const char* name, int fallback = 0)
 int main(int argc, char** argv)
 {
 	if (argc <= 1) {
-		std::cout << "Usage: " << argv[0] << " <test_path_prefix>" << std::endl;
+		std::cout << "Usage: " << argv[0] << " <test_path_prefix> [-t<test>]... [-j<threads>] [-b<baseline>] [-s<baseline>]\n"
+				  << "  -t  run only the given test (directory), may be repeated\n"
+				  << "  -j  number of decoding threads (default: one per core)\n"
+				  << "  -b  compare the per test decode times with a baseline file\n"
+				  << "  -s  save the per test decode times as baseline file" << std::endl;
 		return 0;
 	}
 
@@ -54,12 +58,18 @@ int main(int argc, char** argv)
 		return 0;
 	} else {
 		std::set<std::string> includedTests;
+		RunOptions runOptions;
 		for (int i = 2; i < argc; ++i) {
-			if (std::strlen(argv[i]) > 2 && argv[i][0] == '-' && argv[i][1] == 't') {
-				includedTests.insert(argv[i] + 2);
+			if (std::strlen(argv[i]) <= 2 || argv[i][0] != '-')
+				continue;
+			switch (argv[i][1]) {
+			case 't': includedTests.insert(argv[i] + 2); break;
+			case 'j': runOptions.threads = std::atoi(argv[i] + 2); break;
+			case 'b': runOptions.baseline = argv[i] + 2; break;
+			case 's': runOptions.saveBaseline = argv[i] + 2; break;
 			}
 		}
 
-		return runBlackBoxTests(pathPrefix, includedTests);
+		return runBlackBoxTests(pathPrefix, includedTests, runOptions);
 	}
 }
@@ -106,3 +106,28 @@ TEST(ContentTest, ECI)
 		EXPECT_EQ(c.bytesECI().asString(), std::string_view("]d4\\000003C:\\\\Test\\000026Täßt"));
 	}
 }
+
+TEST(ContentTest, AppendText)
+{
+	Content c;
+	c.symbology = {'d', '1', 3}; // DataMatrix
+	c.append("ASCII only, 0123456789");
+
+	std::string buffer = "prefix:";
+	for (auto mode : {TextMode::Plain, TextMode::ECI, TextMode::HRI, TextMode::Hex, TextMode::Escaped}) {
+		buffer.resize(7);
+		c.appendText(buffer, mode);
+		EXPECT_EQ(buffer, "prefix:" + c.text(mode));
+	}
+
+	c.switchEncoding(ECI::ISO8859_5);
+	c.append(ByteArray{'A', 0xE9, 'Z'});
+	c.switchEncoding(ECI::UTF8);
+	c.append("Täßt");
+	for (auto mode : {TextMode::Plain, TextMode::ECI, TextMode::HRI, TextMode::Hex, TextMode::Escaped}) {
+		buffer.clear();
+		c.appendText(buffer, mode);
+		EXPECT_EQ(buffer, c.text(mode));
+	}
+	EXPECT_EQ(c.utf8(), u8"ASCII only, 0123456789A\u0449ZTäßt");
+}
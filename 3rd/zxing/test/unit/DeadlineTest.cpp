@@ -0,0 +1,64 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "Deadline.h"
+#include "ReadBarcode.h"
+#include "oned/ODCode128Writer.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+
+using namespace ZXing;
+using namespace std::chrono_literals;
+
+TEST(DeadlineTest, Expiry)
+{
+	EXPECT_FALSE(Deadline().isSet());
+	EXPECT_FALSE(Deadline().expired());
+	EXPECT_EQ(Deadline().remaining(), std::chrono::milliseconds::max());
+
+	EXPECT_TRUE(Deadline::In(0ms).expired());
+	EXPECT_EQ(Deadline::In(-5ms).remaining(), 0ms);
+	EXPECT_FALSE(Deadline::In(1h).expired());
+	EXPECT_GT(Deadline::In(1h).remaining(), 59min);
+
+	std::atomic<bool> cancel = false;
+	auto deadline = Deadline::In(1h, &cancel);
+	EXPECT_TRUE(deadline.isSet());
+	EXPECT_FALSE(deadline.expired());
+	cancel = true;
+	EXPECT_TRUE(deadline.expired());
+	EXPECT_EQ(deadline.remaining(), 0ms);
+}
+
+TEST(DeadlineTest, ReadBarcodesStopsWhenExpired)
+{
+	auto bits = QRCode::Writer().setMargin(4).encode(L"DEADLINE", 200, 200);
+	auto buf = ToMatrix<uint8_t>(bits);
+	ImageView iv(buf.data(), bits.width(), bits.height(), ImageFormat::Lum);
+
+	EXPECT_EQ(ReadBarcode(iv, ReaderOptions().setDeadline(Deadline::In(1h))).text(), "DEADLINE");
+	EXPECT_TRUE(ReadBarcodes(iv, ReaderOptions().setDeadline(Deadline::In(0ms))).empty());
+	EXPECT_FALSE(ReadBarcode(iv, ReaderOptions().setIsPure(true).setDeadline(Deadline::In(0ms))).isValid());
+
+	std::atomic<bool> cancel = true;
+	EXPECT_TRUE(ReadBarcodes(iv, ReaderOptions().setDeadline(Deadline(&cancel))).empty());
+	cancel = false;
+	EXPECT_EQ(Size(ReadBarcodes(iv, ReaderOptions().setDeadline(Deadline(&cancel)))), 1);
+}
+
+TEST(DeadlineTest, LinearReaderStopsWhenExpired)
+{
+	auto bits = OneD::Code128Writer().encode(L"DEADLINE", 300, 80);
+	auto buf = ToMatrix<uint8_t>(bits);
+	ImageView iv(buf.data(), bits.width(), bits.height(), ImageFormat::Lum);
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::Code128);
+
+	EXPECT_EQ(ReadBarcode(iv, opts).text(), "DEADLINE");
+	EXPECT_FALSE(ReadBarcode(iv, opts.setDeadline(Deadline::In(0ms))).isValid());
+}
@@ -0,0 +1,69 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "GridSampler.h"
+#include "PseudoRandom.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+
+namespace {
+
+	// random 'modules' of 5x5 pixels, so that sample points at the module centers are well away from pixel borders
+	BitMatrix RandomModules(int width, int height)
+	{
+		PseudoRandom random(42);
+		BitMatrix res(width * 5, height * 5);
+		for (int y = 0; y < height; ++y)
+			for (int x = 0; x < width; ++x)
+				if (random.next(0, 1))
+					res.setRegion(x * 5, y * 5, 5, 5);
+		return res;
+	}
+
+	BitMatrix ReferenceSample(const BitMatrix& image, int dim, const PerspectiveTransform& mod2Pix)
+	{
+		BitMatrix res(dim, dim);
+		for (int y = 0; y < dim; ++y)
+			for (int x = 0; x < dim; ++x)
+				if (image.get(mod2Pix(centered(PointI{x, y}))))
+					res.set(x, y);
+		return res;
+	}
+
+}
+
+TEST(GridSamplerTest, MatchesPointwiseProjection)
+{
+	auto image = RandomModules(60, 60);
+	int dim = 45;
+	auto src = Rectangle(dim, dim, 0);
+
+	for (QuadrilateralF dst : {
+			 QuadrilateralF{PointF{10, 10}, {235, 10}, {235, 235}, {10, 235}},  // axis aligned
+			 QuadrilateralF{PointF{150, 5}, {295, 150}, {150, 295}, {5, 150}},  // rotated 45 deg
+			 QuadrilateralF{PointF{30, 10}, {280, 40}, {250, 290}, {5, 250}},   // perspective
+			 QuadrilateralF{PointF{60, 60}, {240, 20}, {290, 290}, {20, 250}}}) { // strong perspective
+		auto mod2Pix = PerspectiveTransform(src, dst);
+		auto sampled = SampleGrid(image, dim, dim, mod2Pix);
+		ASSERT_TRUE(sampled.isValid());
+
+		auto expected = ReferenceSample(image, dim, mod2Pix);
+		int differences = 0;
+		for (int y = 0; y < dim; ++y)
+			for (int x = 0; x < dim; ++x)
+				differences += sampled.bits().get(x, y) != expected.get(x, y);
+		EXPECT_EQ(differences, 0);
+	}
+}
+
+TEST(GridSamplerTest, RejectsGridOutsideOfImage)
+{
+	auto image = RandomModules(20, 20);
+	auto mod2Pix = PerspectiveTransform(Rectangle(21, 21, 0), {PointF{-5, 10}, {90, 10}, {90, 90}, {-5, 90}});
+	EXPECT_FALSE(SampleGrid(image, 21, 21, mod2Pix).isValid());
+}
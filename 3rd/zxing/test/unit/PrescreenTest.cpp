@@ -0,0 +1,98 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "Prescreen.h"
+#include "PseudoRandom.h"
+#include "ReadBarcode.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace ZXing;
+
+namespace {
+
+	// a 1920x1080 camera like frame: a smooth light gradient with some sensor noise
+	std::vector<uint8_t> Frame(int width, int height)
+	{
+		PseudoRandom random(7);
+		std::vector<uint8_t> res(width * height);
+		for (int y = 0; y < height; ++y)
+			for (int x = 0; x < width; ++x)
+				res[y * width + x] = static_cast<uint8_t>(150 + x * 60 / width + y * 20 / height + random.next(-6, 6));
+		return res;
+	}
+
+	void FillRect(std::vector<uint8_t>& frame, int width, int left, int top, int w, int h, uint8_t value)
+	{
+		for (int y = top; y < top + h; ++y)
+			for (int x = left; x < left + w; ++x)
+				frame[y * width + x] = value;
+	}
+
+	void DrawQRCode(std::vector<uint8_t>& frame, int width, int left, int top, int size)
+	{
+		auto symbol = QRCode::Writer().setMargin(0).encode(L"PRESCREEN", size, size);
+		for (int y = 0; y < symbol.height(); ++y)
+			for (int x = 0; x < symbol.width(); ++x)
+				if (symbol.get(x, y))
+					frame[(top + y) * width + left + x] = 30;
+	}
+
+	constexpr int W = 1920, H = 1080;
+
+}
+
+TEST(PrescreenTest, RejectsFramesWithoutStructure)
+{
+	auto frame = Frame(W, H);
+	ImageView iv(frame.data(), W, H, ImageFormat::Lum);
+	EXPECT_TRUE(FindCandidateRegions(iv).empty());
+	EXPECT_TRUE(ReadBarcodes(iv, ReaderOptions().setPrescreen(true)).empty());
+
+	// isolated straight edges (e.g. a box on a conveyor) are no barcode candidates either
+	FillRect(frame, W, 301, 205, 700, 400, 90);
+	EXPECT_TRUE(FindCandidateRegions(iv).empty());
+}
+
+TEST(PrescreenTest, FindsSymbolRegion)
+{
+	auto frame = Frame(W, H);
+	FillRect(frame, W, 301, 205, 700, 400, 90);
+	DrawQRCode(frame, W, 1400, 700, 200);
+	ImageView iv(frame.data(), W, H, ImageFormat::Lum);
+
+	auto regions = FindCandidateRegions(iv);
+	ASSERT_EQ(Size(regions), 1);
+	auto& r = regions.front();
+	EXPECT_LE(r.left, 1400);
+	EXPECT_LE(r.top, 700);
+	EXPECT_GE(r.left + r.width, 1600);
+	EXPECT_GE(r.top + r.height, 900);
+	EXPECT_LT(r.area() * 2, W * H);
+
+	auto expected = ReadBarcodes(iv, ReaderOptions().setFormats(BarcodeFormat::QRCode));
+	auto prescreened = ReadBarcodes(iv, ReaderOptions().setFormats(BarcodeFormat::QRCode).setPrescreen(true));
+	ASSERT_EQ(Size(expected), 1);
+	ASSERT_EQ(Size(prescreened), 1);
+	EXPECT_EQ(prescreened[0].text(), "PRESCREEN");
+	EXPECT_EQ(prescreened[0].position(), expected[0].position());
+}
+
+TEST(PrescreenTest, SmallImagesAreScannedCompletely)
+{
+	std::vector<uint8_t> frame(20 * 20, 255);
+	ImageView iv(frame.data(), 20, 20, ImageFormat::Lum);
+	auto regions = FindCandidateRegions(iv);
+	ASSERT_EQ(Size(regions), 1);
+	EXPECT_EQ(regions.front(), (ImageRegion{0, 0, 20, 20}));
+}
+
+TEST(PrescreenTest, RegionAreaDoesNotOverflow)
+{
+	EXPECT_EQ((ImageRegion{0, 0, 50000, 50000}).area(), int64_t(2500000000));
+}
@@ -0,0 +1,64 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "ReadBarcode.h"
+#include "ReadTimings.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace ZXing;
+
+TEST(ReadTimingsTest, AccumulatesStagesAndReaders)
+{
+	auto bits = QRCode::Writer().setMargin(4).encode(L"TIMINGS", 600, 600);
+	std::vector<uint8_t> buf(bits.width() * bits.height() * 3);
+	for (int i = 0; i < bits.width() * bits.height(); ++i)
+		buf[3 * i] = buf[3 * i + 1] = buf[3 * i + 2] = bits.get(i % bits.width(), i / bits.width()) ? 0 : 255;
+	ImageView iv(buf.data(), bits.width(), bits.height(), ImageFormat::RGB);
+
+	ReadTimings timings;
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::QRCode | BarcodeFormat::EAN13).setTimings(&timings);
+	auto res = ReadBarcodes(iv, opts);
+	ASSERT_EQ(Size(res), 1);
+	EXPECT_EQ(res[0].text(), "TIMINGS");
+
+	EXPECT_GT(timings.lumExtraction.count(), 0);
+	EXPECT_GT(timings.pyramid.count(), 0);
+	EXPECT_GT(timings.binarize.count(), 0);
+	EXPECT_EQ(timings.prescreen.count(), 0);
+	ASSERT_EQ(Size(timings.readers), 2);
+	for (auto& reader : timings.readers) {
+		EXPECT_TRUE(reader.formats == BarcodeFormat::QRCode || reader.formats == BarcodeFormat::EAN13);
+		EXPECT_GT(reader.calls, 0);
+		EXPECT_GT(reader.time.count(), 0);
+	}
+
+	// the QRCode reader splits its time into stages, the 1D reader does not
+	for (auto& reader : timings.readers) {
+		if (reader.formats == BarcodeFormat::QRCode) {
+			EXPECT_GT(reader.stages.detect.count(), 0);
+			EXPECT_GT(reader.stages.sample.count(), 0);
+			EXPECT_GT(reader.stages.decode.count(), 0);
+			EXPECT_GT(reader.stages.errorCorrection.count(), 0);
+			EXPECT_LE(reader.stages.errorCorrection.count(), reader.stages.decode.count());
+		} else {
+			EXPECT_EQ(reader.stages.detect.count(), 0);
+			EXPECT_EQ(reader.stages.decode.count(), 0);
+		}
+	}
+
+	// a second call accumulates into the same instance
+	auto first = timings.readers[0].calls;
+	ReadBarcodes(iv, opts);
+	EXPECT_EQ(timings.readers[0].calls, 2 * first);
+
+	// without timings the results are the same
+	auto plain = ReadBarcodes(iv, ReaderOptions(opts).setTimings(nullptr));
+	ASSERT_EQ(Size(plain), 1);
+	EXPECT_EQ(plain[0].position(), res[0].position());
+}
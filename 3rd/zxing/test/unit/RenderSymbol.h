@@ -0,0 +1,32 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BitMatrix.h"
+#include "Point.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace ZXing {
+
+// render a symbol centered into a size x size luminance image, rotated clockwise by degrees
+inline std::vector<uint8_t> Render(const BitMatrix& symbol, double degrees, int size)
+{
+	std::vector<uint8_t> res(size * size, 255);
+	double a = degrees * std::acos(-1) / 180, c = std::cos(a), s = std::sin(a);
+	for (int y = 0; y < size; ++y)
+		for (int x = 0; x < size; ++x) {
+			double dx = x + 0.5 - size / 2., dy = y + 0.5 - size / 2.;
+			auto p = PointF(c * dx + s * dy + symbol.width() / 2., -s * dx + c * dy + symbol.height() / 2.);
+			if (symbol.isIn(p) && symbol.get(p))
+				res[y * size + x] = 0;
+		}
+	return res;
+}
+
+}
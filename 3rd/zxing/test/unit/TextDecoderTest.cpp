@@ -3,6 +3,7 @@
 */
 // SPDX-License-Identifier: Apache-2.0
 
+#include "ByteArray.h"
 #include "CharacterSet.h"
 #include "TextDecoder.h"
 #include "Utf.h"
@@ -219,3 +220,16 @@ TEST(TextDecoderTest, AppendUTF16BE)
 		EXPECT_EQ(ToUtf8(str), "𐀀");
 	}
 }
+
+TEST(TextDecoderTest, AppendUtf8)
+{
+	// the ASCII and valid UTF-8 fast paths have to produce the same result as transcoding
+	std::string out = "0123456789";
+	AppendUtf8(out, ByteArray(std::string("ABCDEFGHIJKLMNOPQRSTUVWXYZ")), ECI::ISO8859_5);
+	EXPECT_EQ(out, "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+
+	const uint8_t utf8[] = {'A', 0xC3, 0xA4, 'B', 0xE2, 0x82, 0xAC};
+	EXPECT_EQ(BytesToUtf8(utf8, ECI::UTF8), "A\xC3\xA4" "B\xE2\x82\xAC");
+	const uint8_t invalid[] = {'A', 0xC3, 'B'};
+	EXPECT_EQ(BytesToUtf8(invalid, ECI::UTF8), "A\xEF\xBF\xBD" "B"); // U+FFFD
+}
@@ -6,6 +6,7 @@
 #include "Utf.h"
 
 #include "gtest/gtest.h"
+#include <string>
 
 using namespace ZXing;
 
@@ -40,3 +41,33 @@ TEST(TextUtfEncodingTest, FromUtf8)
 //	EXPECT_EQ(FromUtf8("A\xE8G"), L"AG");                   // Bad UTF-8 (missing continuation bytes)
 //	EXPECT_EQ(FromUtf8("A\xED\xA0\x80G"), L"AG");           // Bad UTF-8 (unpaired high surrogate U+D800)
 }
+
+TEST(TextUtfEncodingTest, IsValidUtf8)
+{
+	EXPECT_TRUE(IsAscii(""));
+	EXPECT_TRUE(IsAscii("0123456789ABCDEFGHIJ\x7F"));
+	EXPECT_FALSE(IsAscii("0123456789ABCDEF\xC3\xA4"));
+
+	EXPECT_TRUE(IsValidUtf8("0123456789ABCDEFGHIJ"));
+	EXPECT_TRUE(IsValidUtf8("A\xE8\x80\xBFG 01234567 \xF0\x90\x80\x80"));
+	EXPECT_FALSE(IsValidUtf8("01234567A\xE8\x80\xBF\x80G")); // extra continuation byte
+	EXPECT_FALSE(IsValidUtf8("A\xE8\x80G"));                   // missing continuation byte
+	EXPECT_FALSE(IsValidUtf8("0123456789A\xE8\x80"));          // truncated at the end
+	EXPECT_FALSE(IsValidUtf8("A\xED\xA0\x80G"));              // unpaired high surrogate U+D800
+	EXPECT_FALSE(IsValidUtf8("A\xC0\xAFG"));                   // overlong encoding of '/'
+}
+
+TEST(TextUtfEncodingTest, Utf8ToUtf16)
+{
+	auto toUtf16 = [](std::string_view utf8) {
+		std::u16string res(utf8.size(), 0);
+		res.resize(Utf8ToUtf16(utf8, res.data()));
+		return res;
+	};
+
+	EXPECT_EQ(toUtf16(""), u"");
+	EXPECT_EQ(toUtf16("0123456789ABCDEFGHIJ"), u"0123456789ABCDEFGHIJ");
+	EXPECT_EQ(toUtf16("A\xE8\x80\xBFG"), u"A\u803FG");
+	EXPECT_EQ(toUtf16("01234567\xF0\x90\x80\x80" "01234567"), u"01234567\U0001000001234567");
+	EXPECT_EQ(toUtf16("\xC3\xA4\xC3\xB6\xC3\xBC"), u"\u00E4\u00F6\u00FC");
+}
@@ -0,0 +1,89 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "ReadBarcode.h"
+#include "RenderSymbol.h"
+#include "datamatrix/DMDetector.h"
+#include "datamatrix/DMWriter.h"
+
+#include "gtest/gtest.h"
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::DataMatrix;
+
+namespace {
+
+	// a tray of cols x rows DataMatrix labeled vials
+	BitMatrix Tray(int cols, int rows, int labelSize = 100)
+	{
+		BitMatrix tray(cols * labelSize, rows * labelSize);
+		Writer writer;
+		writer.setMargin(labelSize / 5);
+		for (int r = 0; r < rows; ++r)
+			for (int c = 0; c < cols; ++c) {
+				auto label = writer.encode("VIAL-" + std::to_string(r * cols + c), labelSize, labelSize);
+				for (int y = 0; y < label.height(); ++y)
+					for (int x = 0; x < label.width(); ++x)
+						if (label.get(x, y))
+							tray.set(c * labelSize + x, r * labelSize + y);
+			}
+		return tray;
+	}
+
+}
+
+TEST(DMDetectorTest, DetectAllFindsEverySymbolOnce)
+{
+	constexpr int cols = 12, rows = 8;
+	auto tray = Tray(cols, rows);
+
+	auto serial = DetectAll(tray, true, 1);
+	EXPECT_EQ(Size(serial), cols * rows);
+
+	auto concurrent = DetectAll(tray, true, 4);
+	ASSERT_EQ(concurrent.size(), serial.size());
+	for (size_t i = 0; i < serial.size(); ++i)
+		EXPECT_EQ(concurrent[i].position(), serial[i].position());
+}
+
+TEST(DMDetectorTest, ReadBarcodesDecodesFullTray)
+{
+	constexpr int cols = 12, rows = 8;
+	auto tray = Tray(cols, rows);
+	auto buf = ToMatrix<uint8_t>(tray);
+	auto iv = ImageView(buf.data(), buf.width(), buf.height(), ImageFormat::Lum);
+
+	auto res = ReadBarcodes(iv, ReaderOptions().setFormats(BarcodeFormat::DataMatrix).setDetectAll(true));
+	std::set<std::string> texts;
+	for (auto& r : res)
+		texts.insert(r.text());
+	EXPECT_EQ(Size(res), cols * rows);
+	EXPECT_EQ(Size(texts), cols * rows);
+}
+
+TEST(DMDetectorTest, DetectPureRotatedSymbols)
+{
+	auto symbol = Writer().setMargin(0).encode("PURE-ROTATED-0123456789", 120, 120);
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::DataMatrix).setIsPure(true);
+
+	for (int rotation : {0, 90, 180, 270}) {
+		auto buf = Render(symbol, rotation, 200);
+		auto res = ReadBarcode({buf.data(), 200, 200, ImageFormat::Lum}, opts);
+		EXPECT_EQ(res.text(), "PURE-ROTATED-0123456789") << rotation;
+		EXPECT_EQ((res.orientation() + 360) % 360, rotation) << rotation;
+	}
+
+	// slightly skewed, e.g. by a label applicator
+	for (double skew : {-7., -2.5, 3., 8.}) {
+		auto buf = Render(symbol, 90 + skew, 200);
+		auto res = ReadBarcode({buf.data(), 200, 200, ImageFormat::Lum}, opts);
+		EXPECT_EQ(res.text(), "PURE-ROTATED-0123456789") << skew;
+		EXPECT_NEAR(res.orientation(), 90 + skew, 2) << skew;
+	}
+}
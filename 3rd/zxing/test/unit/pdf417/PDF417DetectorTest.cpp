@@ -0,0 +1,54 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "PseudoRandom.h"
+#include "ReadBarcode.h"
+#include "pdf417/PDFBitMatrixView.h"
+#include "pdf417/PDFWriter.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+using namespace ZXing::Pdf417;
+
+TEST(PDF417DetectorTest, BitMatrixViewMatchesRotatedCopy)
+{
+	PseudoRandom random(17);
+	BitMatrix bits(13, 7);
+	for (int y = 0; y < bits.height(); ++y)
+		for (int x = 0; x < bits.width(); ++x)
+			bits.set(x, y, random.next(0, 1));
+
+	for (int rotation : {0, 90, 180, 270}) {
+		auto copy = bits.copy();
+		if (rotation == 90 || rotation == 270)
+			copy.rotate90();
+		if (rotation >= 180)
+			copy.rotate180();
+
+		BitMatrixView view(bits, rotation);
+		ASSERT_EQ(view.width(), copy.width());
+		ASSERT_EQ(view.height(), copy.height());
+		for (int y = 0; y < copy.height(); ++y)
+			for (int x = 0; x < copy.width(); ++x)
+				EXPECT_EQ(view.get(x, y), copy.get(x, y)) << rotation << ": " << x << "," << y;
+	}
+}
+
+TEST(PDF417DetectorTest, DetectsRotatedSymbols)
+{
+	auto symbol = Writer().setMargin(10).encode(L"rotated view", 400, 200);
+	auto buf = ToMatrix<uint8_t>(symbol);
+	auto iv = ImageView(buf.data(), buf.width(), buf.height(), ImageFormat::Lum);
+
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::PDF417);
+	for (int rotation : {0, 90, 180, 270}) {
+		auto res = ReadBarcode(iv.rotated(rotation), opts);
+		EXPECT_TRUE(res.isValid()) << rotation;
+		EXPECT_EQ(res.text(), "rotated view") << rotation;
+		EXPECT_EQ((res.orientation() + 360) % 360, rotation) << rotation;
+	}
+}
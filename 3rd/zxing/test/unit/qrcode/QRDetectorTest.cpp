@@ -0,0 +1,161 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "ReadBarcode.h"
+#include "RenderSymbol.h"
+#include "qrcode/QRDetector.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::QRCode;
+
+namespace {
+
+	// a sheet of cols x rows small QRCode labels
+	BitMatrix LabelSheet(int cols, int rows, int labelSize = 120)
+	{
+		BitMatrix sheet(cols * labelSize, rows * labelSize);
+		Writer writer;
+		for (int r = 0; r < rows; ++r)
+			for (int c = 0; c < cols; ++c) {
+				auto label = writer.encode(L"LABEL-" + std::to_wstring(r * cols + c), labelSize, labelSize);
+				for (int y = 0; y < label.height(); ++y)
+					for (int x = 0; x < label.width(); ++x)
+						if (label.get(x, y))
+							sheet.set(c * labelSize + x, r * labelSize + y);
+			}
+		return sheet;
+	}
+
+}
+
+TEST(QRDetectorTest, FindFinderPatternsStripesMatchSerialScan)
+{
+	// large enough (> 4 MP) for the stripes to be scanned concurrently
+	constexpr int cols = 20, rows = 14, labelSize = 120;
+	auto sheet = LabelSheet(cols, rows, labelSize);
+
+	for (bool tryHarder : {false, true}) {
+		auto serial = FindFinderPatterns(sheet, tryHarder, 1);
+
+		// the three finder patterns of every label are found exactly once, at the same place as in a single label
+		// (the data modules of some labels contain additional finder like patterns)
+		auto single = FindFinderPatterns(LabelSheet(1, 1, labelSize), tryHarder, 1);
+		ASSERT_EQ(Size(single), 3);
+		std::vector<int> found(cols * rows * 3);
+		for (auto& p : serial) {
+			int label = int(p.y) / labelSize * cols + int(p.x) / labelSize;
+			auto origin = PointF(int(p.x) / labelSize * labelSize, int(p.y) / labelSize * labelSize);
+			for (int i = 0; i < 3; ++i)
+				if (distance(PointF(p) - origin, PointF(single[i])) < 1)
+					found[label * 3 + i]++;
+		}
+		EXPECT_EQ(found, std::vector<int>(cols * rows * 3, 1));
+
+		for (int threads : {2, 3, 7, 100}) {
+			auto striped = FindFinderPatterns(sheet, tryHarder, threads);
+			ASSERT_EQ(striped.size(), serial.size());
+			for (size_t i = 0; i < serial.size(); ++i) {
+				EXPECT_EQ(striped[i].x, serial[i].x);
+				EXPECT_EQ(striped[i].y, serial[i].y);
+				EXPECT_EQ(striped[i].size, serial[i].size);
+			}
+		}
+	}
+}
+
+TEST(QRDetectorTest, GenerateFinderPatternSetsOnLabelSheet)
+{
+	constexpr int cols = 3, rows = 2, labelSize = 120;
+	auto sheet = LabelSheet(cols, rows, labelSize);
+	auto fps = FindFinderPatterns(sheet, true);
+	ASSERT_EQ(Size(fps), cols * rows * 3);
+
+	auto sets = GenerateFinderPatternSets(fps);
+	EXPECT_LE(Size(sets), 256);
+
+	// every label contributes exactly one set with all three patterns inside of it, in the expected orientation
+	auto label = [](PointF p) { return int(p.y) / labelSize * cols + int(p.x) / labelSize; };
+	std::vector<int> found(cols * rows);
+	for (auto& s : sets)
+		if (label(s.bl) == label(s.tl) && label(s.tl) == label(s.tr)) {
+			EXPECT_LT(s.tl.x, s.tr.x);
+			EXPECT_LT(s.tl.y, s.bl.y);
+			found[label(s.tl)]++;
+		}
+	EXPECT_EQ(found, std::vector<int>(cols * rows, 1));
+}
+
+TEST(QRDetectorTest, GenerateFinderPatternSetsIgnoresDistantPatterns)
+{
+	// two identical symbols far apart, further than any plausible symbol size
+	auto single = LabelSheet(1, 1);
+	BitMatrix canvas(120 * 40, 120);
+	for (int y = 0; y < single.height(); ++y)
+		for (int x = 0; x < single.width(); ++x)
+			if (single.get(x, y)) {
+				canvas.set(x, y);
+				canvas.set(canvas.width() - single.width() + x, y);
+			}
+
+	auto fps = FindFinderPatterns(canvas, true);
+	ASSERT_EQ(Size(fps), 6);
+	auto sets = GenerateFinderPatternSets(fps);
+	ASSERT_EQ(Size(sets), 2);
+	EXPECT_EQ(sets[0].tl.y, sets[1].tl.y);
+	EXPECT_EQ(sets[0].tl.x + canvas.width() - single.width(), sets[1].tl.x);
+}
+
+TEST(QRDetectorTest, ConcurrentDecodeMatchesSequentialDecode)
+{
+	constexpr int cols = 4, rows = 3;
+	auto sheet = LabelSheet(cols, rows);
+	auto buf = ToMatrix<uint8_t>(sheet);
+	auto iv = ImageView(buf.data(), buf.width(), buf.height(), ImageFormat::Lum);
+
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::QRCode).setTryRotate(false).setTryDownscale(false);
+	auto sequential = ReadBarcodes(iv, ReaderOptions(opts).setMaxThreads(1));
+	ASSERT_EQ(Size(sequential), cols * rows);
+
+	for (int maxSymbols : {0, 1, 5}) {
+		opts.setMaxNumberOfSymbols(maxSymbols ? maxSymbols : 0xff);
+		auto expected = ReadBarcodes(iv, ReaderOptions(opts).setMaxThreads(1));
+		auto concurrent = ReadBarcodes(iv, ReaderOptions(opts).setMaxThreads(4));
+		ASSERT_EQ(concurrent.size(), expected.size());
+		for (size_t i = 0; i < expected.size(); ++i) {
+			EXPECT_EQ(concurrent[i].text(), expected[i].text());
+			EXPECT_EQ(concurrent[i].position(), expected[i].position());
+		}
+	}
+}
+
+TEST(QRDetectorTest, DetectPureRotatedSymbols)
+{
+	auto symbol = Writer().setMargin(0).encode(L"PURE-ROTATED", 125, 125);
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::QRCode).setIsPure(true);
+
+	for (int rotation : {0, 90, 180, 270}) {
+		auto buf = Render(symbol, rotation, 205);
+		auto res = ReadBarcode({buf.data(), 205, 205, ImageFormat::Lum}, opts);
+		EXPECT_EQ(res.text(), "PURE-ROTATED") << rotation;
+		EXPECT_EQ((res.orientation() + 360) % 360, rotation) << rotation;
+	}
+
+	for (double skew : {-7., -2.5, 3., 8.}) {
+		auto buf = Render(symbol, 270 + skew, 205);
+		auto res = ReadBarcode({buf.data(), 205, 205, ImageFormat::Lum}, opts);
+		EXPECT_EQ(res.text(), "PURE-ROTATED") << skew;
+		EXPECT_NEAR((res.orientation() + 360) % 360, 270 + skew, 2) << skew;
+	}
+
+	// without tryRotate, only the axis aligned symbol is detected
+	auto buf = Render(symbol, 90, 205);
+	EXPECT_FALSE(ReadBarcode({buf.data(), 205, 205, ImageFormat::Lum}, opts.setTryRotate(false)).isValid());
+}
@@ -0,0 +1,157 @@
+/**
+ * @file RecognizerBenchmark.cpp
+ * @brief 应用层识别/生成性能基准：在合成图像上测量QRCodeRecognizer与QRCodeGenerator的吞吐量
+ *
+ * 每个基准输出一行JSON，便于在发布前与上一次的结果比较。
+ * ZXing内部各阶段的微基准见 3rd/zxing/test/benchmark
+ */
+#include "core/QRCodeGenerator.h"
+#include "core/QRCodeRecognizer.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include <QStringList>
+#include <QTransform>
+
+#include <cstdio>
+#include <functional>
+#include <iostream>
+
+namespace {
+
+struct Settings {
+    QString filter;
+    qint64 minTimeMs = 500;
+};
+
+/**
+ * @brief 合成的摄像头帧：白底上放置一个旋转后的二维码
+ */
+struct Frame {
+    QString text;
+    QImage image;
+};
+
+QList<Frame> generateFrames(QRCodeGenerator& generator, double rotation, int count)
+{
+    QList<Frame> frames;
+    for (int i = 0; i < count; ++i) {
+        Frame frame;
+        frame.text = QString("BENCH-%1-0123456789").arg(i);
+        QImage symbol = generator.generateQRCode(frame.text, QSize(300, 300)).toImage();
+
+        frame.image = QImage(1280, 720, QImage::Format_RGB32);
+        frame.image.fill(Qt::white);
+        QPainter painter(&frame.image);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        painter.translate(640, 360);
+        painter.rotate(rotation);
+        painter.drawImage(QPoint(-symbol.width() / 2, -symbol.height() / 2), symbol);
+        painter.end();
+
+        frames.append(frame);
+    }
+    return frames;
+}
+
+void run(const Settings& settings, const QString& name, const std::function<void()>& op, double successRate = -1)
+{
+    if (!name.contains(settings.filter)) {
+        return;
+    }
+
+    if (settings.minTimeMs > 0) {
+        op(); // 预热
+    }
+
+    qint64 iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    do {
+        op();
+        ++iterations;
+    } while (timer.elapsed() < settings.minTimeMs);
+
+    double ns = static_cast<double>(timer.nsecsElapsed()) / iterations;
+    std::printf(R"({"name":"%s","iterations":%lld,"ns_per_op":%.1f,"ops_per_sec":%.2f)", qPrintable(name),
+                static_cast<long long>(iterations), ns, 1e9 / ns);
+    if (successRate >= 0) {
+        std::printf(R"(,"success_rate":%.4f)", successRate);
+    }
+    std::printf("}\n");
+    std::fflush(stdout);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    // 基准不需要显示窗口
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    Settings settings;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args[i] == "--filter" && i + 1 < args.size()) {
+            settings.filter = args[++i];
+        } else if (args[i] == "--min-time" && i + 1 < args.size()) {
+            settings.minTimeMs = args[++i].toLongLong();
+        } else {
+            std::cerr << "Usage: RecognizerBenchmark [--filter <substring>] [--min-time <ms per benchmark>]\n";
+            return 2;
+        }
+    }
+
+    QRCodeGenerator generator;
+    QRCodeRecognizer recognizer;
+
+    run(settings, "app/generate/QRCode/300x300", [&] { generator.generateQRCode("BENCH-GENERATE-0123456789"); });
+
+    struct Variant {
+        QString name;
+        double rotation;
+        QRCodeRecognizer::RecognitionConfig config;
+    };
+    QRCodeRecognizer::RecognitionConfig fast;
+    fast.fastMode = true;
+    QRCodeRecognizer::RecognitionConfig progressive;
+    progressive.tryHarder = true;
+    progressive.timeoutMs = 1000;
+
+    const QList<Variant> variants = {
+        {"default/upright", 0, {}},
+        {"default/rotated", 30, {}},
+        {"fast/upright", 0, fast},
+        {"progressive/rotated", 30, progressive},
+    };
+
+    bool ok = true;
+    for (const auto& variant : variants) {
+        QString name = "app/recognize/" + variant.name;
+        if (!name.contains(settings.filter)) {
+            continue;
+        }
+
+        auto frames = generateFrames(generator, variant.rotation, 8);
+        int decoded = 0;
+        for (const auto& frame : frames) {
+            auto result = recognizer.recognizeSync(frame.image, variant.config);
+            decoded += result.isValid && result.text == frame.text;
+        }
+        if (variant.rotation == 0 && decoded != frames.size()) {
+            std::cerr << qPrintable(name) << ": decoded only " << decoded << " of " << frames.size() << " frames\n";
+            ok = false;
+        }
+
+        int i = 0;
+        run(settings, name, [&] { recognizer.recognizeSync(frames[i++ % frames.size()].image, variant.config); },
+            static_cast<double>(decoded) / frames.size());
+    }
+
+    return ok ? 0 : 1;
+}
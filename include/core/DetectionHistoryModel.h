@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/QRCodeRecognizer.h"
+
+#include <QAbstractListModel>
+#include <QCache>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QTemporaryFile>
+#include <QTextStream>
+#include <QVector>
+
+/**
+ * @class DetectionHistoryModel
+ * @brief 摄像头检测历史的列表模型，适合长时间连续扫描
+ *
+ * 每个不同的内容（格式+文本）只占一行，重复检测只更新该行的次数与最后出现时间，
+ * 去重索引只保存内容的64位摘要和行号，不保存内容本身。内存中只保留最近 MAX_IN_MEMORY 行，
+ * 更早的行成批写入临时文件，视图滚动到这些行时按偏移读回（带少量缓存），再次检测到时把更新写回文件。
+ * 配合QListView只绘制可见行，历史条数不会影响界面响应速度
+ */
+class DetectionHistoryModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 一条检测记录
+     */
+    struct Entry {
+        QRCodeRecognizer::RecognitionResult result;
+        QDateTime firstSeen;    // 首次检测时间
+        QDateTime lastSeen;     // 最近一次检测时间
+        int hits = 0;           // 检测次数
+    };
+
+    explicit DetectionHistoryModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief 添加一次检测；相同内容已存在时只更新该行
+     * @param result 识别结果
+     * @param time 检测时间
+     * @return 是否为新内容
+     */
+    bool addDetection(const QRCodeRecognizer::RecognitionResult& result,
+                      const QDateTime& time = QDateTime::currentDateTime());
+
+    /**
+     * @brief 获取一行记录（可能从临时文件读回）
+     */
+    Entry entry(int row) const;
+
+    /**
+     * @brief 清空历史并删除临时文件
+     */
+    void clear();
+
+    bool isEmpty() const { return m_rowCount == 0; }
+
+    /**
+     * @brief 按行顺序把全部记录流式写出，不在内存中汇总
+     * @param out 输出流
+     * @return 写入是否成功
+     */
+    bool exportText(QTextStream& out) const;
+
+    static const int MAX_IN_MEMORY = 2000;  // 内存中保留的最近行数
+    static const int SPILL_BATCH = 500;     // 每次写入临时文件的行数
+
+private:
+    static quint64 digestOf(const QRCodeRecognizer::RecognitionResult& result);
+    static bool sameContent(const QRCodeRecognizer::RecognitionResult& a, const QRCodeRecognizer::RecognitionResult& b);
+    static QByteArray serialize(const Entry& entry);
+    static Entry deserialize(const QByteArray& line);
+
+    void spillOldest();
+    Entry readSpilled(int row) const;
+    void writeSpilled(int row, const Entry& entry);
+    Entry* recentEntry(int row);
+
+    QList<Entry> m_recent;              // 最近的行，对应行号 m_spilledCount 起
+    QMultiHash<quint64, int> m_index;   // 内容摘要 -> 行号（摘要相同时比较内容）
+    int m_rowCount = 0;
+    int m_spilledCount = 0;             // 已写入临时文件的行数
+
+    mutable QTemporaryFile m_spillFile;
+    QVector<qint64> m_spillOffsets;     // 每个已写出行（最新状态）在临时文件中的偏移
+    mutable QCache<int, Entry> m_spillCache;
+};
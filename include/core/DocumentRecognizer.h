@@ -0,0 +1,94 @@
+#pragma once
+
+#include "core/QRCodeRecognizer.h"
+#include "core/RecognizerPool.h"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+class QTextStream;
+
+/**
+ * @class DocumentRecognizer
+ * @brief 多页文档（多页TIFF、多帧GIF/ICO）的逐页识别
+ *
+ * 页由QImageReader依次读出，每页作为一个任务在线程池中并行识别；
+ * 读出但未识别完的页数有上限，内存占用与文档页数无关。
+ * 结果按页和符号报告；分布在多个页上的结构化追加序列
+ * 用ZXing::MergeStructuredAppendSequence合并为完整数据
+ */
+class DocumentRecognizer
+{
+public:
+    /**
+     * @brief 一页的识别结果
+     */
+    struct PageResult {
+        int page = 0;                                       // 页序号（从0开始）
+        QList<QRCodeRecognizer::RecognitionResult> results; // 本页识别到的符号
+        QString error;                                      // 读取或识别失败的原因
+    };
+
+    /**
+     * @brief 合并后的结构化追加数据
+     */
+    struct SequenceResult {
+        QRCodeRecognizer::RecognitionResult result;  // 合并后的完整内容
+        QList<int> pages;                            // 序列符号所在的页（从0开始）
+    };
+
+    /**
+     * @brief 一个文档的识别结果
+     */
+    struct DocumentResult {
+        QString filePath;
+        int pageCount = 0;                  // 读出的页数
+        QList<PageResult> pages;            // 按页序排列
+        QList<SequenceResult> sequences;    // 合并完成的结构化追加序列
+        QStringList incompleteSequences;    // 缺少符号而无法合并的序列说明
+        QString error;                      // 文件无法读取时的原因
+        qint64 elapsedMs = 0;
+
+        /**
+         * @brief 所有页识别到的符号总数
+         */
+        int symbolCount() const;
+    };
+
+    /**
+     * @brief 进度回调（在调用线程中调用）
+     * @param pagesRead 已处理的页数（送去识别的页和无法读取的页）
+     * @param pageCount 总页数（格式不提供页数时为0）
+     */
+    using ProgressCallback = std::function<void(int pagesRead, int pageCount)>;
+
+    DocumentRecognizer();
+    ~DocumentRecognizer();
+
+    /**
+     * @brief 识别文档的所有页，阻塞直到全部完成
+     * @param filePath 文件路径
+     * @param config 识别配置
+     * @param progress 进度回调
+     * @return 识别结果
+     */
+    DocumentResult recognizeFile(const QString& filePath,
+                                 const QRCodeRecognizer::RecognitionConfig& config = {},
+                                 const ProgressCallback& progress = {});
+
+    /**
+     * @brief 以CSV格式输出识别结果（文件、页、符号、格式、内容、结构化追加）
+     * @param out 输出流
+     * @param documents 文档识别结果
+     * @return 写入成功返回true
+     */
+    static bool writeReport(QTextStream& out, const QList<DocumentResult>& documents);
+
+private:
+    RecognizerPool m_pool;
+
+    static const int PAGES_IN_FLIGHT_PER_THREAD = 2;    // 每个线程最多积压的已读出页数
+};
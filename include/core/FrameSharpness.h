@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QImage>
+#include <QVideoFrame>
+
+/**
+ * @class FrameSharpness
+ * @brief 帧清晰度评分，用于在识别前挑选对焦最好、运动模糊最少的帧
+ *
+ * 评分基于亮度平面的梯度能量：按步长抽样计算相邻像素差的平方和，
+ * 在 GRID_SIZE x GRID_SIZE 个块中取纹理最强的 TOP_BLOCKS 个块的平均值，
+ * 因此画面中只有一小块条码时，大片平坦背景不会拉低评分。
+ * 分值只用于比较同一场景的相邻帧，不同场景之间没有可比性
+ */
+class FrameSharpness
+{
+public:
+    /**
+     * @brief 计算图像的清晰度
+     * @param image 输入图像（任意格式，非32位/灰度格式会先转换）
+     * @return 清晰度评分，图像无效时返回-1
+     */
+    static double fromImage(const QImage& image);
+
+    /**
+     * @brief 直接在视频帧的亮度平面上计算清晰度，不做格式转换
+     * @param frame 视频帧（YUV平面/半平面、YUYV/UYVY或32位RGB格式）
+     * @return 清晰度评分，帧无效、无法映射或格式不支持时返回-1
+     */
+    static double fromVideoFrame(const QVideoFrame& frame);
+
+    /**
+     * @brief 在8位亮度样本上计算清晰度
+     * @param data 第一个像素的亮度字节
+     * @param width 宽度（像素）
+     * @param height 高度（像素）
+     * @param bytesPerLine 行跨度（字节）
+     * @param pixelStride 相邻像素的亮度字节间距
+     */
+    static double fromLuminance(const uchar* data, int width, int height, int bytesPerLine, int pixelStride);
+
+    static const int GRID_SIZE = 8;     // 每个方向的块数
+    static const int TOP_BLOCKS = 16;   // 参与平均的最强纹理块数
+    static const int STEP = 4;          // 抽样步长（像素）
+};
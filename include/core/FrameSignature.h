@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QImage>
+#include <QVector>
+
+/**
+ * @class FrameSignature
+ * @brief 帧的低分辨率亮度签名，用于在识别前廉价地判断两帧是否基本相同
+ *
+ * 签名是把图像划分为 GRID_SIZE x GRID_SIZE 个块后每块的平均亮度，
+ * 块内按步长抽样，计算量与帧尺寸的四分之一成正比，远小于一次识别
+ */
+class FrameSignature
+{
+public:
+    FrameSignature() = default;
+
+    /**
+     * @brief 计算图像的签名
+     * @param image 输入图像（任意格式，非32位/灰度格式会先转换）
+     * @return 签名，图像无效时返回空签名
+     */
+    static FrameSignature fromImage(const QImage& image);
+
+    /**
+     * @brief 是否为空签名
+     */
+    bool isNull() const { return m_blocks.isEmpty(); }
+
+    /**
+     * @brief 与另一签名的平均块亮度差（0-255），任一签名为空时返回255
+     */
+    double difference(const FrameSignature& other) const;
+
+    static const int GRID_SIZE = 32;
+
+private:
+    QVector<quint8> m_blocks;   // 每块的平均亮度，按行存储
+};
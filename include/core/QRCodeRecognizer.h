@@ -13,6 +13,8 @@
 #include "ReadBarcode.h"
 #include "Quadrilateral.h"
 
+struct LoadedImage;
+
 /**
  * @class QRCodeRecognizer
  * @brief 二维码识别器类，负责从图像中识别二维码
@@ -22,6 +24,8 @@ class QRCodeRecognizer : public QObject
     Q_OBJECT
 
 public:
+    static const int MAX_DECODE_DIMENSION = 1920;   // 识别前图像的默认最大边长
+
     /**
      * @brief 识别结果结构
      */
@@ -29,20 +33,55 @@ public:
         QString text;                       // 识别到的文本
         bool isValid;                       // 是否识别成功
         ZXing::QuadrilateralI position;    // 二维码的四个角点位置
-        QString format;                     // 条码格式
+        ZXing::BarcodeFormat format;        // 条码格式
         double confidence;                  // 置信度（0-1）
+        int orientation;                    // 符号方向（度）
+        QString ecLevel;                    // 纠错等级（不适用时为空）
+        QString version;                    // 符号版本（不适用时为空）
+        bool isInverted;                    // 是否为反色符号（浅色码深色底）
+        int sequenceIndex;                  // 结构化追加序列中的序号（从0开始，不属于序列时为-1）
+        int sequenceSize;                   // 结构化追加序列的符号总数（不属于序列时为-1）
+        QString sequenceId;                 // 结构化追加序列标识
         
         RecognitionResult() 
             : isValid(false)
+            , format(ZXing::BarcodeFormat::None)
             , confidence(0.0)
+            , orientation(0)
+            , isInverted(false)
+            , sequenceIndex(-1)
+            , sequenceSize(-1)
         {}
         
         RecognitionResult(const QString& text, const ZXing::QuadrilateralI& pos, 
-                         const QString& format, double conf = 1.0)
-            : text(text), isValid(true), position(pos), format(format), confidence(conf) {}
+                         ZXing::BarcodeFormat format, double conf = 1.0)
+            : text(text), isValid(true), position(pos), format(format), confidence(conf)
+            , orientation(0), isInverted(false), sequenceIndex(-1), sequenceSize(-1) {}
         
         RecognitionResult(const RecognitionResult&) = default;
         RecognitionResult& operator=(const RecognitionResult&) = default;
+
+        /**
+         * @brief 条码格式的显示名称（仅用于界面显示与导出）
+         */
+        QString formatName() const { return QString::fromStdString(ZXing::ToString(format)); }
+
+        /**
+         * @brief 是否为结构化追加序列中的一个符号（内容只是完整数据的一部分）
+         */
+        bool isPartOfSequence() const { return sequenceSize > -1 && sequenceIndex > -1; }
+    };
+
+    /**
+     * @brief 码制方案：按业务场景预设的条码格式集合
+     * 每个启用的格式都会增加一次读取器扫描，格式越少识别越快
+     */
+    enum class SymbologyProfile {
+        All,        // 全部常用格式（默认）
+        Retail1D,   // 零售一维码（EAN/UPC）
+        Logistics,  // 物流（Code 128、ITF、Code 39、Data Matrix、PDF417、QR Code）
+        TwoD,       // 仅二维码制
+        QROnly      // 仅QR Code
     };
 
     /**
@@ -53,12 +92,24 @@ public:
         bool tryRotate;             // 是否尝试旋转图像
         bool fastMode;              // 快速模式（降低精度提高速度）
         int maxSymbols;             // 最大识别符号数量
+        bool prescreen;             // 是否先做快速预筛选（无条码结构的帧直接跳过，仅在候选区域内完整识别）
+        ZXing::BarcodeFormats formats; // 启用的条码格式（为空时等同于全部常用格式）
+        bool adaptiveFormats;       // 自适应码制：只扫描本会话中实际出现过的格式，并定期完整扫描以发现新格式
+        int timeoutMs;              // 识别时间预算（毫秒），大于0时由快到慢逐级升级识别策略，超时返回已有的最好结果；0表示不限时
+        int maxDimension;           // 识别前的最大边长，超过时先缩小；0表示按原始分辨率识别
+        int maxThreads;             // 单次识别内部使用的最大线程数；0表示由ZXing按CPU核数决定
         
         RecognitionConfig() 
             : tryHarder(false)
             , tryRotate(true)
             , fastMode(false)
             , maxSymbols(1)
+            , prescreen(false)
+            , formats(profileFormats(SymbologyProfile::All))
+            , adaptiveFormats(false)
+            , timeoutMs(0)
+            , maxDimension(MAX_DECODE_DIMENSION)
+            , maxThreads(0)
         {}
         
         RecognitionConfig(const RecognitionConfig&) = default;
@@ -81,9 +132,55 @@ public:
      * @brief 识别多种格式的条码，按流行度排序返回
      * @param image 待识别的图像
      * @param config 识别配置
+     * @param sequenceParts 不为空时追加识别到的结构化追加序列符号，供跨图像（如多页文档）合并
      * @return 按流行度排序的识别结果列表
      */
-    QList<RecognitionResult> recognizeMultiFormat(const QImage& image, const RecognitionConfig& config = {});
+    QList<RecognitionResult> recognizeMultiFormat(const QImage& image, const RecognitionConfig& config = {},
+                                                  ZXing::Barcodes* sequenceParts = nullptr);
+
+    /**
+     * @brief 把同一结构化追加序列的符号合并为一个结果（使用ZXing::MergeStructuredAppendSequence）
+     * @param parts 同一序列的符号（可来自不同图像，顺序任意，重复的序号只取一个）
+     * @return 合并后的结果；序列不完整或标识不一致时返回无效结果
+     */
+    static RecognitionResult mergeStructuredAppend(const ZXing::Barcodes& parts);
+
+    /**
+     * @brief 缩小解码的图像识别失败后，按原始分辨率重新识别
+     * 只有图像在加载时被缩小、且预筛选在缩小后的图像中找到了条码结构（条码可能太小而无法解码）时才重新解码原图；
+     * 返回的角点坐标换算到缩小后的图像坐标系
+     * @param loaded 缩小解码的图像及其来源
+     * @param config 识别配置
+     * @return 识别结果列表（不满足重试条件或仍未识别到时为空）
+     */
+    QList<RecognitionResult> recognizeFullResolution(const LoadedImage& loaded, const RecognitionConfig& config = {});
+
+    /**
+     * @brief 用快速预筛选判断图像中是否有类似条码的结构
+     * @param image 待检查的图像
+     * @return 是否找到候选区域
+     */
+    static bool hasCandidateRegions(const QImage& image);
+
+    /**
+     * @brief 按比例换算识别结果的角点坐标（如从原图坐标换算到缩小后的预览图像坐标）
+     * @param results 识别结果列表
+     * @param scaleX 水平比例
+     * @param scaleY 垂直比例
+     */
+    static void scalePositions(QList<RecognitionResult>& results, double scaleX, double scaleY);
+
+    /**
+     * @brief 获取码制方案对应的条码格式集合
+     * @param profile 码制方案
+     * @return 条码格式集合
+     */
+    static ZXing::BarcodeFormats profileFormats(SymbologyProfile profile);
+
+    /**
+     * @brief 清空自适应码制的会话统计（例如开始新的扫描会话时）
+     */
+    void resetAdaptiveFormats();
 
     /**
      * @brief 获取支持的条码格式列表，按流行度排序
@@ -107,14 +204,6 @@ public:
      */
     RecognitionResult recognizeFromPixmap(const QPixmap& pixmap, const RecognitionConfig& config = {});
 
-    /**
-     * @brief 在图像上绘制识别结果轮廓
-     * @param originalImage 原始图像
-     * @param result 识别结果
-     * @return 绘制轮廓后的图像
-     */
-    QPixmap drawContour(const QPixmap& originalImage, const RecognitionResult& result);
-
     /**
      * @brief 获取错误信息
      * @return 最后一次操作的错误信息
@@ -161,18 +250,52 @@ private:
      */
     ZXing::ReaderOptions convertConfig(const RecognitionConfig& config);
 
+    /**
+     * @brief 在时间预算内逐级升级识别策略
+     * 依次尝试 快速 → 旋转 → 反色 → 精细 → 去噪，每一级只在配置允许时启用；
+     * 找到足够的符号或预算耗尽即停止，返回符号最多的一级的结果
+     * @param imageView 待识别的图像
+     * @param options 配置允许的最完整识别选项
+     * @param timeoutMs 时间预算（毫秒）
+     * @return 识别结果
+     */
+    static ZXing::Barcodes readProgressive(const ZXing::ImageView& imageView, const ZXing::ReaderOptions& options, int timeoutMs);
+
+    /**
+     * @brief 确定本次识别实际启用的格式
+     * 自适应模式下，识别到足够多的符号后只启用本会话出现过的格式，每隔若干次仍做一次完整扫描
+     * @param config 识别配置
+     * @return 启用的条码格式
+     */
+    ZXing::BarcodeFormats selectFormats(const RecognitionConfig& config);
+
+    /**
+     * @brief 记录识别到的格式，供自适应码制使用
+     * @param results 识别结果
+     */
+    void recordFormats(const QList<RecognitionResult>& results);
+
+    /**
+     * @brief 将条码内容直接解码为QString
+     * 复用线程内的UTF-8缓冲区并直接写入QString的UTF-16存储，避免每个结果的std::string分配与二次转换
+     * @param barcode ZXing识别结果
+     * @return 条码文本
+     */
+    static QString decodeText(const ZXing::Barcode& barcode);
+
     /**
      * @brief 预处理图像（调整大小、格式转换等）
      * @param image 原始图像
-     * @return 预处理后的图像
+     * @param maxDimension 最大边长，0表示不缩放
+     * @return 预处理后的图像（灰度图像保持灰度，其他转换为32位RGB）
      */
-    QImage preprocessImage(const QImage& image);
+    QImage preprocessImage(const QImage& image, int maxDimension);
 
     /**
      * @brief 获取按流行度排序的条码格式
      * @return 格式枚举列表
      */
-    QList<ZXing::BarcodeFormat> getFormatsOrderedByPopularity() const;
+    static QList<ZXing::BarcodeFormat> getFormatsOrderedByPopularity();
 
     /**
      * @brief 计算识别结果的流行度得分
@@ -197,8 +320,16 @@ private:
     QTimer* m_processTimer;
     QMutex m_queueMutex;
     bool m_processing{false};
+
+    // 自适应码制的会话统计
+    QMutex m_formatStatsMutex;
+    ZXing::BarcodeFormats m_seenFormats;
+    int m_seenSymbols{0};
+    int m_adaptiveScans{0};
     
     // 常量
     static const int MAX_QUEUE_SIZE = 5;
     static const int PROCESSING_INTERVAL = 100; // ms
+    static const int ADAPTIVE_MIN_SYMBOLS = 5;          // 收窄格式前至少识别到的符号数
+    static const int ADAPTIVE_FULL_SCAN_INTERVAL = 15;  // 每隔多少次识别做一次完整扫描
 };
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "core/FrameSignature.h"
+#include "core/QRCodeRecognizer.h"
+
+#include <QObject>
+#include <QImage>
+#include <QThreadPool>
+#include <QTimer>
+
+/**
+ * @class RecognitionScheduler
+ * @brief 实时识别调度器：按实测识别耗时与CPU预算决定何时识别下一帧
+ *
+ * 调度器在工作线程中一次只识别一帧，空闲后才向帧源请求新的一帧，识别期间到达的帧直接丢弃而不排队，
+ * 因此识别的总是最新的画面。两次识别之间的空闲时间由平均耗时和CPU预算决定：
+ * 预算为25%、单帧耗时40ms时，每次识别后空闲120ms。
+ * 每帧识别前先计算廉价的帧签名，与上一识别帧相比没有明显变化时不再识别，
+ * 而是复用上一次的结果（成功或失败均复用），同时空闲时间逐步加倍（最长 MAX_IDLE_MS）。
+ * 模糊和重新对焦几乎不改变块亮度，因此失败结果的复用有限制：画面清晰度明显高于上一识别帧
+ * （对焦完成、运动停止）时立即重新识别，连续复用 MAX_FAILED_REUSES 次后也重新识别一次；
+ * 画面变化后立即识别；识别成功或预筛选在画面中找到类似条码的结构（条码已进入画面但尚未识别成功）时
+ * 恢复到预算允许的最高频率，画面中没有条码结构时继续退避。固定安装的扫描器在没有条码时几乎不占用CPU
+ */
+class RecognitionScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RecognitionScheduler(QObject* parent = nullptr);
+    ~RecognitionScheduler();
+
+    /**
+     * @brief 设置识别配置
+     */
+    void setConfig(const QRCodeRecognizer::RecognitionConfig& config) { m_config = config; }
+
+    /**
+     * @brief 设置CPU预算：识别占用单个核心时间的比例（0.05-1.0）
+     */
+    void setCpuBudget(double budget);
+    double cpuBudget() const { return m_cpuBudget; }
+
+    /**
+     * @brief 开始调度，立即请求第一帧
+     */
+    void start();
+
+    /**
+     * @brief 停止调度，等待正在进行的识别完成，其结果被丢弃
+     */
+    void stop();
+
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief 提交一帧；正在识别或处于空闲间隔时丢弃该帧
+     * @param image 帧图像
+     */
+    void submitFrame(const QImage& image);
+
+    /**
+     * @brief 请求的帧无法获取（如采集未就绪），稍后重新请求
+     */
+    void frameUnavailable();
+
+    /**
+     * @brief 平均单帧识别耗时（毫秒）
+     */
+    double averageLatencyMs() const { return m_latencyMs; }
+
+    /**
+     * @brief 当前两次识别之间的空闲时间（毫秒）
+     */
+    int currentIntervalMs() const;
+
+signals:
+    /**
+     * @brief 调度器准备好识别下一帧，帧源应采集一帧并调用submitFrame
+     */
+    void frameRequested();
+
+    /**
+     * @brief 一帧识别完成（结果可能无效）
+     */
+    void resultReady(const QRCodeRecognizer::RecognitionResult& result);
+
+    /**
+     * @brief 画面与上一识别帧相同，未识别而是复用了上一次的有效结果
+     */
+    void resultReused(const QRCodeRecognizer::RecognitionResult& result);
+
+private:
+    void dispatch(const QImage& image, const FrameSignature& signature);
+    bool canReuseLastResult(const QImage& image) const;
+    void reuseLastResult();
+    void backOff();
+    void onDecodeFinished(int session, const QRCodeRecognizer::RecognitionResult& result, bool hasCandidates,
+                          double sharpness, double latencyMs);
+    void onTimer();
+
+    QRCodeRecognizer* m_recognizer;     // 只在工作线程中使用，一次一帧
+    QThreadPool m_pool;
+    QTimer* m_timer;
+
+    QRCodeRecognizer::RecognitionConfig m_config;
+    FrameSignature m_lastSignature;     // 上一识别帧的签名
+    QRCodeRecognizer::RecognitionResult m_lastResult;   // 上一识别帧的结果，画面未变化时复用
+    double m_lastSharpness = -1.0;      // 上一识别帧的清晰度（识别成功时不计算）
+    int m_failedReuses = 0;             // 失败结果已连续复用的次数
+
+    double m_cpuBudget = 0.3;
+    double m_latencyMs = 0.0;           // 识别耗时的指数滑动平均
+    int m_idleMs = 0;                   // 静止或没有条码结构的画面的退避时间
+    int m_session = 0;
+    bool m_running = false;
+    bool m_busy = false;
+
+    static const int MAX_IDLE_MS = 1000;        // 静止或没有条码结构的画面最长的识别间隔
+    static const int RETRY_MS = 50;             // 帧不可用时重新请求的间隔
+    static const int MAX_FAILED_REUSES = 5;     // 失败结果最多连续复用的次数（退避后约1.5秒）
+    static constexpr double STATIC_THRESHOLD = 3.0;  // 平均块亮度差低于该值视为静止
+    static constexpr double SHARPNESS_GAIN = 1.3;    // 清晰度超过上一识别帧的该倍数时重新识别
+    static constexpr double LATENCY_SMOOTHING = 0.2;
+};
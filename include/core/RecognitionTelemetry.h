@@ -0,0 +1,134 @@
+#pragma once
+
+#include <QString>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+// ZXing includes
+#include "ReadTimings.h"
+
+/**
+ * @class RecognitionTelemetry
+ * @brief 识别性能统计，记录每次识别各阶段的耗时、丢帧数与吞吐量
+ *
+ * 所有识别器共享同一个实例。每个阶段只保留最近 WINDOW_SIZE 个样本，
+ * 百分位数在获取快照时计算，因此记录本身只是一次加锁的追加操作
+ */
+class RecognitionTelemetry
+{
+public:
+    /**
+     * @brief 单个阶段的统计结果（单位：毫秒）
+     */
+    struct StageStats {
+        QString name;       // 阶段名称
+        int count = 0;      // 窗口内的样本数
+        double mean = 0.0;  // 平均值
+        double p50 = 0.0;   // 中位数
+        double p95 = 0.0;   // 95百分位
+        double p99 = 0.0;   // 99百分位
+        double max = 0.0;   // 最大值
+    };
+
+    /**
+     * @brief 统计快照
+     */
+    struct Snapshot {
+        qint64 calls = 0;           // 识别调用次数
+        qint64 successes = 0;       // 识别到条码的次数
+        qint64 droppedFrames = 0;   // 丢弃的帧数（队列溢出或采集未就绪）
+        qint64 skippedFrames = 0;   // 画面未变化而跳过识别的帧数
+        double throughput = 0.0;    // 最近窗口内每秒识别次数
+        QList<StageStats> stages;   // 各阶段统计，按首次出现的顺序排列
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return RecognitionTelemetry实例的引用
+     */
+    static RecognitionTelemetry& instance();
+
+    /**
+     * @brief 记录一个阶段的耗时
+     * @param stage 阶段名称
+     * @param microseconds 耗时（微秒）
+     */
+    void addTiming(const QString& stage, qint64 microseconds);
+
+    /**
+     * @brief 记录ZXing内部各阶段（亮度提取、预筛选、金字塔、二值化、各读取器）的耗时
+     * @param timings 单次识别累计的耗时
+     */
+    void addReadTimings(const ZXing::ReadTimings& timings);
+
+    /**
+     * @brief 记录一次识别调用
+     * @param success 是否识别到条码
+     */
+    void addCall(bool success);
+
+    /**
+     * @brief 记录一帧被丢弃
+     */
+    void addDroppedFrame();
+
+    /**
+     * @brief 记录一帧因画面未变化而跳过识别
+     */
+    void addSkippedFrame();
+
+    /**
+     * @brief 获取当前统计快照
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief 以JSON形式导出当前统计
+     */
+    QJsonObject toJson() const;
+
+    /**
+     * @brief 将当前统计保存为JSON文件
+     * @param filePath 文件路径
+     * @return 保存成功返回true
+     */
+    bool saveJson(const QString& filePath) const;
+
+    /**
+     * @brief 清空所有统计
+     */
+    void reset();
+
+private:
+    RecognitionTelemetry();
+    ~RecognitionTelemetry() = default;
+    RecognitionTelemetry(const RecognitionTelemetry&) = delete;
+    RecognitionTelemetry& operator=(const RecognitionTelemetry&) = delete;
+
+    /**
+     * @brief 固定容量的环形样本缓冲区
+     */
+    struct Samples {
+        QVector<qint64> values;     // 样本（微秒）
+        int next = 0;               // 下一个写入位置（缓冲区已满时覆盖最老的样本）
+    };
+
+    static void append(Samples& samples, qint64 value);
+    static StageStats computeStats(const QString& name, const Samples& samples);
+
+    mutable QMutex m_mutex;
+    QStringList m_stageOrder;
+    QMap<QString, Samples> m_stages;
+    Samples m_callTimes;        // 最近调用的时间点（毫秒，相对m_clock），用于计算吞吐量
+    QElapsedTimer m_clock;
+    qint64 m_calls = 0;
+    qint64 m_successes = 0;
+    qint64 m_droppedFrames = 0;
+    qint64 m_skippedFrames = 0;
+
+    static const int WINDOW_SIZE = 1000;
+};
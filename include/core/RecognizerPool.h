@@ -0,0 +1,65 @@
+#pragma once
+
+#include "core/QRCodeRecognizer.h"
+
+#include <QList>
+#include <QMutex>
+#include <QThreadPool>
+
+#include <functional>
+
+/**
+ * @class RecognizerPool
+ * @brief 并行识别的线程池：每个工作线程使用独立的识别器（识别器本身不是线程安全的）
+ *
+ * 识别器数量与线程数相同，任何时刻每个运行中的任务都能取到一个空闲识别器。
+ * 任务之间已经并行，单次识别不再启动ZXing内部的工作线程，
+ * 提交的任务应使用workerConfig转换后的配置，否则线程数为线程池大小的平方
+ */
+class RecognizerPool
+{
+public:
+    using Task = std::function<void(QRCodeRecognizer* recognizer)>;
+
+    RecognizerPool();
+    ~RecognizerPool();
+
+    RecognizerPool(const RecognizerPool&) = delete;
+    RecognizerPool& operator=(const RecognizerPool&) = delete;
+
+    /**
+     * @brief 在线程池中执行任务，任务执行期间独占一个识别器
+     */
+    void start(const Task& task);
+
+    /**
+     * @brief 丢弃尚未开始的任务
+     */
+    void clear() { m_pool.clear(); }
+
+    /**
+     * @brief 等待所有任务完成
+     */
+    void waitForDone() { m_pool.waitForDone(); }
+
+    int maxThreadCount() const { return m_pool.maxThreadCount(); }
+
+    /**
+     * @brief 重置所有识别器的自适应码制（新的识别会话开始、没有运行中的任务时调用）
+     */
+    void resetAdaptiveFormats();
+
+    /**
+     * @brief 池中任务使用的识别配置：单次识别只使用一个线程
+     */
+    static QRCodeRecognizer::RecognitionConfig workerConfig(const QRCodeRecognizer::RecognitionConfig& config);
+
+private:
+    QRCodeRecognizer* acquireRecognizer();
+    void releaseRecognizer(QRCodeRecognizer* recognizer);
+
+    QThreadPool m_pool;
+    QList<QRCodeRecognizer*> m_recognizers;
+    QList<QRCodeRecognizer*> m_idleRecognizers;
+    QMutex m_recognizerMutex;
+};
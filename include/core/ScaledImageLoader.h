@@ -0,0 +1,89 @@
+#pragma once
+
+#include "core/QRCodeRecognizer.h"
+
+#include <QByteArray>
+#include <QImage>
+#include <QString>
+
+class QImageReader;
+
+/**
+ * @brief 按需缩小解码后的图像及其来源
+ */
+struct LoadedImage {
+    QImage image;           // 解码后的图像（可能已缩小）
+    QSize originalSize;     // 原始图像尺寸
+    QString filePath;       // 来源文件（从内存数据加载时为空）
+    int page = 0;           // 页（帧）序号，多页TIFF、多帧GIF/ICO从0开始
+    int pageCount = 1;      // 来源的总页数
+    QByteArray data;        // 来源数据（从文件加载时为空）
+    QString error;          // 加载失败的原因
+
+    bool isNull() const { return image.isNull(); }
+
+    /**
+     * @brief 解码时是否缩小过（识别失败时可考虑按原始分辨率重试）
+     */
+    bool isScaled() const { return !image.isNull() && image.size() != originalSize; }
+};
+
+/**
+ * @class ScaledImageLoader
+ * @brief 基于QImageReader的图像加载：先读取文件头得到尺寸，在解码时直接缩小
+ *
+ * JPEG解码器在设置了目标尺寸时使用DCT缩放，只解码需要的分辨率，
+ * 5000万像素的照片或600dpi的扫描件不再先完整解码成数百MB的RGBA图像再缩小。
+ * 识别时只需要亮度，批量识别可以同时要求输出灰度图像，每像素只占一个字节
+ */
+class ScaledImageLoader
+{
+public:
+    /**
+     * @brief 从文件加载
+     * @param filePath 文件路径
+     * @param maxDimension 解码后的最大边长，0表示按原始分辨率解码
+     * @param grayscale 是否输出灰度图像
+     * @param page 页（帧）序号
+     */
+    static LoadedImage fromFile(const QString& filePath,
+                                int maxDimension = QRCodeRecognizer::MAX_DECODE_DIMENSION,
+                                bool grayscale = false,
+                                int page = 0);
+
+    /**
+     * @brief 从内存数据（如网络下载的图片）加载
+     * @param data 编码后的图像数据
+     * @param maxDimension 解码后的最大边长，0表示按原始分辨率解码
+     * @param grayscale 是否输出灰度图像
+     */
+    static LoadedImage fromData(const QByteArray& data,
+                                int maxDimension = QRCodeRecognizer::MAX_DECODE_DIMENSION,
+                                bool grayscale = false);
+
+    /**
+     * @brief 读取图像文件的页数（只读取文件头，不解码）
+     * @param filePath 文件路径
+     * @return 页数，无法读取时为0
+     */
+    static int pageCount(const QString& filePath);
+
+    /**
+     * @brief 按原始分辨率重新解码同一来源（同一页）
+     * @param loaded 之前加载的结果
+     * @param grayscale 是否输出灰度图像
+     */
+    static LoadedImage reloadFullResolution(const LoadedImage& loaded, bool grayscale = false);
+
+    /**
+     * @brief 把读取器定位到指定页，之后的read()读取该页
+     * @param reader 尚未读取的读取器
+     * @param page 页（帧）序号
+     * @return 该页是否存在
+     */
+    static bool jumpToPage(QImageReader& reader, int page);
+
+private:
+    static void read(QImageReader& reader, int maxDimension, bool grayscale, LoadedImage& loaded);
+    static int pageCount(QImageReader& reader);
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "core/QRCodeRecognizer.h"
+#include "core/RecognizerPool.h"
+
+#include <QByteArray>
+#include <QImage>
+#include <QList>
+#include <QRect>
+#include <QSize>
+#include <QString>
+
+#include <functional>
+
+class QImageReader;
+
+/**
+ * @class TiledRecognizer
+ * @brief 大幅面图像（A0图纸、整面托盘墙照片、高分辨率扫描件）的分块识别
+ *
+ * 整幅图像缩小到识别尺寸后，小条码的模块只剩不到一个像素而无法识别。
+ * 分块识别按原始分辨率把图像切成互相重叠的块，每块只解码自己的区域
+ * （支持裁剪读取的格式通过QImageReader::setClipRect读取），在线程池中并行识别，
+ * 同时驻留内存的块不超过线程数；不支持裁剪读取的格式只在不超过QImageReader内存上限时整幅解码。
+ * 块的大小和重叠宽度由预期的模块尺寸决定：重叠宽度不小于最大符号的边长，任何符号都完整地落在至少一个块内；
+ * 模块较大时块在解码时缩小，使模块保持在识别所需的像素数。
+ * 各块的结果换算到整幅图像坐标，重叠区域内重复识别到的同一符号只保留一条
+ */
+class TiledRecognizer
+{
+public:
+    /**
+     * @brief 分块参数
+     */
+    struct Options {
+        int moduleSize = 3;         // 预期的最小模块尺寸（原图像素）
+        int maxSymbolModules = 160; // 最大符号的边长（模块数，含静区），决定块之间的重叠宽度
+    };
+
+    /**
+     * @brief 一个分块：原图中的区域及其解码尺寸
+     */
+    struct Tile {
+        QRect sourceRect;   // 原图坐标中的区域
+        QSize decodeSize;   // 解码后的尺寸（不大于区域尺寸）
+    };
+
+    explicit TiledRecognizer(const Options& options = {});
+    ~TiledRecognizer();
+
+    void setOptions(const Options& options) { m_options = options; }
+    Options options() const { return m_options; }
+
+    /**
+     * @brief 分块识别图像文件
+     * @param filePath 文件路径
+     * @param config 识别配置（每块的最大识别数量按配置，合并后的结果数量不限）
+     * @param page 多页文件（如TIFF）的页序号
+     * @return 整幅图像坐标中的识别结果
+     */
+    QList<QRCodeRecognizer::RecognitionResult> recognizeFile(const QString& filePath,
+                                                             const QRCodeRecognizer::RecognitionConfig& config = {},
+                                                             int page = 0);
+
+    /**
+     * @brief 分块识别内存中的编码图像数据（如网络下载的图片）
+     */
+    QList<QRCodeRecognizer::RecognitionResult> recognizeData(const QByteArray& data,
+                                                             const QRCodeRecognizer::RecognitionConfig& config = {});
+
+    /**
+     * @brief 分块识别已解码的图像（各块直接引用图像数据，不复制）
+     */
+    QList<QRCodeRecognizer::RecognitionResult> recognizeImage(const QImage& image,
+                                                              const QRCodeRecognizer::RecognitionConfig& config = {});
+
+    /**
+     * @brief 计算图像的分块布局
+     * @param imageSize 原图尺寸
+     * @return 按行排列的分块，块之间的重叠宽度不小于最大符号边长
+     */
+    QList<Tile> tileLayout(const QSize& imageSize) const;
+
+    /**
+     * @brief 上一次识别的错误信息
+     */
+    QString getLastError() const { return m_lastError; }
+
+private:
+    using TileReader = std::function<QImage(const Tile&)>;
+
+    QList<QRCodeRecognizer::RecognitionResult> recognizeEncoded(QImageReader& probe, const TileReader& readTile,
+                                                                const QRCodeRecognizer::RecognitionConfig& config);
+    QList<QRCodeRecognizer::RecognitionResult> run(const QSize& imageSize, const TileReader& readTile,
+                                                   const QRCodeRecognizer::RecognitionConfig& config);
+    static QImage readRegion(QImageReader& reader, const Tile& tile);
+    static QImage toTileImage(const QImage& image);
+    static void mergeResult(QList<QRCodeRecognizer::RecognitionResult>& merged,
+                            const QRCodeRecognizer::RecognitionResult& result);
+
+    Options m_options;
+    QString m_lastError;
+    RecognizerPool m_pool;
+
+    static const int TARGET_MODULE_PIXELS = 3;  // 解码后每个模块保留的像素数
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "core/FrameSignature.h"
+#include "core/QRCodeRecognizer.h"
+#include "core/RecognizerPool.h"
+
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+class QMediaPlayer;
+class QVideoSink;
+class QVideoFrame;
+
+/**
+ * @class VideoFileScanner
+ * @brief 离线视频文件识别：尽可能快地解码视频帧并在线程池中并行识别
+ *
+ * 帧由QMediaPlayer以高倍速播放到QVideoSink获得，格式转换和帧签名在单独的工作线程中按帧序计算，
+ * 与上一送检帧几乎相同的帧直接跳过。积压的帧过多时暂停播放，直到工作线程赶上，因此收到的帧都会处理；
+ * 但后端在高倍速下可能自行跳帧，按时间戳间隔推算的跳帧数记录在 framesDropped 中。
+ * 同一条码在视频时间上连续出现时只记录一条检测记录，并更新其最后出现时间与次数
+ */
+class VideoFileScanner : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 去重后的检测记录
+     */
+    struct Detection {
+        QRCodeRecognizer::RecognitionResult result;  // 首次识别的结果
+        qint64 firstSeenMs = 0;     // 首次出现的视频时间（毫秒）
+        qint64 lastSeenMs = 0;      // 最后出现的视频时间（毫秒）
+        int hits = 0;               // 识别到的帧数
+    };
+
+    /**
+     * @brief 扫描统计
+     */
+    struct Statistics {
+        qint64 framesReceived = 0;  // 收到的视频帧数
+        qint64 framesDecoded = 0;   // 送去识别的帧数
+        qint64 framesSkipped = 0;   // 因与上一送检帧几乎相同而跳过的帧数
+        qint64 framesDropped = 0;   // 后端未送出的帧数（由相邻帧的时间戳间隔推算）
+        qint64 elapsedMs = 0;       // 已用时间（毫秒）
+        qint64 durationMs = 0;      // 视频时长（毫秒）
+        qint64 positionMs = 0;      // 当前处理到的视频时间（毫秒）
+    };
+
+    explicit VideoFileScanner(QObject* parent = nullptr);
+    ~VideoFileScanner();
+
+    /**
+     * @brief 开始扫描视频文件
+     * @param filePath 本地视频文件路径
+     * @param config 识别配置
+     * @return 已在扫描时返回false
+     */
+    bool start(const QString& filePath, const QRCodeRecognizer::RecognitionConfig& config = {});
+
+    /**
+     * @brief 停止扫描，等待正在进行的识别完成
+     */
+    void stop();
+
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief 设置跳帧阈值：与上一送检帧的平均块亮度差低于该值的帧被跳过（0表示不跳帧）
+     */
+    void setSkipThreshold(double threshold) { m_skipThreshold = threshold; }
+
+    /**
+     * @brief 设置去重窗口：同一内容在该视频时间间隔内再次出现时合并为一条记录
+     */
+    void setDedupWindowMs(qint64 windowMs) { m_dedupWindowMs = windowMs; }
+
+    QList<Detection> detections() const { return m_detections; }
+
+    /**
+     * @brief 当前扫描统计（扫描过程中可随时调用以显示进度）
+     */
+    Statistics statistics() const;
+
+    /**
+     * @brief 将检测记录保存为CSV（视频时间、格式、内容、次数）
+     * @param filePath 文件路径
+     * @return 保存成功返回true
+     */
+    bool saveLog(const QString& filePath) const;
+
+    /**
+     * @brief 视频时间的显示格式 hh:mm:ss.zzz
+     */
+    static QString formatTimestamp(qint64 ms);
+
+signals:
+    void detectionAdded(int index);     // 新的检测记录
+    void detectionUpdated(int index);   // 已有记录再次出现
+    void finished(const VideoFileScanner::Statistics& statistics);
+    void errorOccurred(const QString& error);
+
+private slots:
+    void onVideoFrameChanged(const QVideoFrame& frame);
+
+private:
+    void countDroppedFrames(const QVideoFrame& frame);
+    void onFramePrepared(int session, const QImage& image, const FrameSignature& signature, qint64 timestampMs);
+    void submitFrame(const QImage& image, qint64 timestampMs);
+    void frameDone();
+    void handleResults(int session, qint64 timestampMs, const QList<QRCodeRecognizer::RecognitionResult>& results);
+    void checkFinished();
+    void updateThrottle();
+
+    QMediaPlayer* m_player;
+    QVideoSink* m_videoSink;
+    QThreadPool m_preparePool;  // 单线程：格式转换与帧签名，保持帧序以便与上一送检帧比较
+    RecognizerPool m_pool;
+
+    QRCodeRecognizer::RecognitionConfig m_config;
+    FrameSignature m_lastSubmitted;
+    QList<Detection> m_detections;
+    QHash<QString, QList<int>> m_detectionIndex;    // 格式+内容 -> 检测记录索引
+
+    Statistics m_statistics;
+    QElapsedTimer m_elapsed;
+    int m_session = 0;          // 每次start递增，丢弃上一次扫描迟到的结果
+    int m_inFlight = 0;         // 已收到但未处理完（转换、跳过或识别）的帧数
+    qint64 m_lastFrameEndUs = -1;   // 上一帧的结束时间戳（微秒），用于推算跳帧
+    bool m_running = false;
+    bool m_inputFinished = false;
+    bool m_throttled = false;
+    double m_skipThreshold = 2.0;
+    qint64 m_dedupWindowMs = 2000;
+
+    static constexpr double PLAYBACK_RATE = 16.0;   // 请求的播放倍速，后端不支持时由其限制
+};
@@ -3,6 +3,7 @@
 #include "gui/BaseWidget.h"
 #include "core/QRCodeRecognizer.h"
 #include <QCamera>
+#include <QCameraDevice>
 #include <QMediaCaptureSession>
 #include <QVideoWidget>
 #include <QImageCapture>
@@ -15,11 +16,17 @@
 #include <QSlider>
 #include <QTimer>
 #include <QGroupBox>
-#include <QTextEdit>
+#include <QListView>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+class DetectionHistoryModel;
+class DetectionOverlay;
+class RecognitionScheduler;
 
 /**
  * @class CameraWidget
@@ -50,6 +57,7 @@ public:
 
 public slots:
     void onRecognitionResult(const QRCodeRecognizer::RecognitionResult& result);
+    void onRecognitionResultReused(const QRCodeRecognizer::RecognitionResult& result);
 
 signals:
     void qrCodeDetected(const QString& text, const QRCodeRecognizer::RecognitionResult& result);
@@ -64,34 +72,39 @@ private slots:
     void onResolutionChanged();
     void onRecognitionSettingsChanged();
     void onVideoFrameChanged(const QVideoFrame& frame);
-    void onRecognitionTimer();
+    void onFrameRequested();
     void onCameraErrorOccurred();
 
 private:
     void setupUI();
     void setupCamera();
-    void updateCameraDevices();
+    void ensureCameraSetup();
+    void updateCameraDevices(const QList<QCameraDevice>& devices);
     void updateResolutions();
     void processVideoFrame(const QVideoFrame& frame);
     void processVideoImage(const QImage& image);
+    void onFrameScored(const QVideoFrame& frame, double sharpness);
+    QImage takeBestFrame();
+    void recognizeManualCapture(const QImage& image);
     void addResultToHistory(const QRCodeRecognizer::RecognitionResult& result);
     void drawDetectionOverlay(const QRCodeRecognizer::RecognitionResult& result);
+    int overlayTimeoutMs() const;
     void applyDefaultStyles() override;
 
 protected:
-    void resizeEvent(QResizeEvent* event) override;
+    void showEvent(QShowEvent* event) override;
 
 private:
     // Core components
     QRCodeRecognizer* m_recognizer;
     
-    // Camera components
+    // Camera components（捕获会话、图像捕获与视频sink在首次显示后才创建）
     QCamera* m_camera;
     QMediaCaptureSession* m_captureSession;
     QVideoWidget* m_videoWidget;
     QImageCapture* m_imageCapture;
     QVideoSink* m_videoSink;
-    QLabel* m_overlayLabel;  // 叠加层用于显示轮廓
+    DetectionOverlay* m_overlay;    // 叠加层，以矢量图元绘制检测轮廓
     
     // UI components - Camera controls
     QGroupBox* m_cameraGroup;
@@ -105,22 +118,27 @@ private:
     QGroupBox* m_recognitionGroup;
     QCheckBox* m_realtimeRecognitionCheckBox;
     QCheckBox* m_showOverlayCheckBox;
-    QSlider* m_recognitionIntervalSlider;
-    QLabel* m_intervalLabel;
+    QSlider* m_cpuBudgetSlider;     // 实时识别的CPU预算（10%-100%）
+    QLabel* m_cpuBudgetLabel;
     QCheckBox* m_autoSaveCheckBox;
     
     // UI components - Results
     QGroupBox* m_resultsGroup;
-    QTextEdit* m_historyTextEdit;
+    DetectionHistoryModel* m_historyModel;  // 去重后的检测历史（超出内存上限的部分写入临时文件）
+    QListView* m_historyView;
     QPushButton* m_clearHistoryButton;
     QPushButton* m_saveHistoryButton;
     QLabel* m_detectionCountLabel;
     
-    // Recognition timer and settings
-    QTimer* m_recognitionTimer;
+    // Recognition scheduler and settings
+    RecognitionScheduler* m_scheduler;
     QTimer* m_overlayTimer;  // 叠加层显示计时器
     QVideoFrame m_currentFrame;
-    QList<QRCodeRecognizer::RecognitionResult> m_detectionHistory;
+    QVideoFrame m_bestFrame;        // 当前窗口内最清晰的预览帧
+    double m_bestSharpness = -1.0;
+    QThreadPool m_sharpnessPool;    // 单线程：在GUI线程之外给预览帧评分
+    bool m_scoring = false;         // 正在评分时到达的帧不再评分
+    QElapsedTimer m_bestFrameTimer; // 最佳帧被选中的时间
     
     // State
     bool m_cameraActive;
@@ -129,4 +147,6 @@ private:
     QDateTime m_lastDetectionTime;
     QString m_lastDetectedText;
     QSize m_lastImageSize;  // 记录最后处理的图像尺寸，用于坐标转换
+
+    static const int SHARPNESS_WINDOW_MS = 300;    // 挑选最清晰帧的时间窗口
 };
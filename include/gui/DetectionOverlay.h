@@ -0,0 +1,70 @@
+#pragma once
+
+#include "core/QRCodeRecognizer.h"
+
+#include <QList>
+#include <QPointer>
+#include <QWidget>
+
+/**
+ * @class DetectionOverlay
+ * @brief 覆盖在视频/图片视图上的透明叠加层，以矢量图元绘制识别到的条码轮廓
+ *
+ * 叠加层随视图的大小和位置自动调整。识别结果只保存角点坐标，
+ * 在paintEvent中把图像坐标变换到视图坐标后直接绘制，不复制或缩放图像。
+ * 视频控件使用原生窗口渲染时子控件会被遮挡，此时使用浮动模式：
+ * 叠加层是无边框的透明工具窗口，在视图或其所在窗口移动、缩放时同步位置
+ */
+class DetectionOverlay : public QWidget
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造叠加层
+     * @param view 被覆盖的视图
+     * @param floating 是否使用浮动窗口（用于原生窗口渲染的视频控件），否则为视图的子控件
+     */
+    explicit DetectionOverlay(QWidget* view, bool floating = false);
+    ~DetectionOverlay() = default;
+
+    /**
+     * @brief 设置识别所用图像的尺寸（角点坐标所在的坐标系）
+     */
+    void setSourceSize(const QSize& size);
+
+    /**
+     * @brief 设置图像在视图中的显示尺寸，图像在视图中居中显示
+     * 未设置（无效尺寸）时按保持宽高比铺满视图计算，与视频控件的显示方式一致
+     */
+    void setDisplayedSize(const QSize& size);
+
+    /**
+     * @brief 显示一组识别结果（无效结果被忽略）
+     */
+    void setResults(const QList<QRCodeRecognizer::RecognitionResult>& results);
+
+    /**
+     * @brief 清除轮廓并隐藏叠加层
+     */
+    void clear();
+
+    bool hasResults() const { return !m_results.isEmpty(); }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    void followView();
+    QRectF imageRect() const;
+
+    QWidget* m_view;
+    QPointer<QWidget> m_window;     // 浮动模式下跟踪的顶层窗口
+    bool m_floating;
+    QSize m_sourceSize;
+    QSize m_displayedSize;
+    QList<QRCodeRecognizer::RecognitionResult> m_results;
+
+    static const int MAX_LABEL_LENGTH = 30;    // 轮廓旁文本的最大显示长度
+};
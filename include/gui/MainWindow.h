@@ -8,11 +8,14 @@
 #include <QCloseEvent>
 #include <QImage>
 #include <QPixmap>
+#include <QDockWidget>
 
 // 前向声明
 class GeneratorWidget;
 class RecognizerWidget;
 class CameraWidget;
+class VideoScanWidget;
+class StatsPanel;
 class QRCodeGenerator;
 class QRCodeRecognizer;
 
@@ -59,12 +62,16 @@ private slots:
     
     // 主题相关
     void onThemeChanged(bool isDark);
+    
+    // 标签页相关
+    void ensureTabCreated(int index);
 
 private:
     void setupUI();
     void setupMenuBar();
     void setupStatusBar();
     void setupConnections();
+    QWidget* createTabPage();
     void updateWindowTitle(const QString& subtitle = QString());
     void applyThemeStyles();
     
@@ -77,10 +84,17 @@ private:
     // UI组件
     QTabWidget* m_tabWidget;
     
-    // 功能组件
+    // 功能组件（首次切换到对应标签页时才创建，之前为nullptr）
     GeneratorWidget* m_generatorWidget;
     RecognizerWidget* m_recognizerWidget;
     CameraWidget* m_cameraWidget;
+    VideoScanWidget* m_videoScanWidget;
+    QWidget* m_generatorPage;
+    QWidget* m_recognizerPage;
+    QWidget* m_cameraPage;
+    QWidget* m_videoScanPage;
+    StatsPanel* m_statsPanel;
+    QDockWidget* m_statsDock;
     
     // 核心组件
     QRCodeGenerator* m_generator;
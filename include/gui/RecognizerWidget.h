@@ -1,12 +1,16 @@
 #pragma once
 
 #include "gui/BaseWidget.h"
+#include "core/DocumentRecognizer.h"
 #include "core/QRCodeRecognizer.h"
+#include "core/ScaledImageLoader.h"
+#include "core/TiledRecognizer.h"
 #include <QLabel>
 #include <QPushButton>
 #include <QTextEdit>
 #include <QProgressBar>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QSpinBox>
 #include <QGroupBox>
 #include <QVBoxLayout>
@@ -23,6 +27,10 @@
 #include <QNetworkReply>
 #include <QTimer>
 
+#include <memory>
+
+class DetectionOverlay;
+
 /**
  * @class RecognizerWidget
  * @brief 二维码识别界面组件
@@ -45,6 +53,13 @@ public:
      */
     QRCodeRecognizer::RecognitionConfig getConfig() const;
 
+    /**
+     * @brief 当前图片加载时被缩小且识别失败后，按原始分辨率重新识别
+     * @param config 识别配置
+     * @return 识别结果（坐标为预览图像坐标）；不需要或无法重试时为空
+     */
+    QList<QRCodeRecognizer::RecognitionResult> recognizeFullResolution(const QRCodeRecognizer::RecognitionConfig& config);
+
 public slots:
     void showRecognitionResult(const QRCodeRecognizer::RecognitionResult& result);
     void showMultiFormatResults(const QList<QRCodeRecognizer::RecognitionResult>& results);
@@ -75,13 +90,21 @@ private slots:
     void onConfigChanged();
     void onRecognitionCompleted(const QRCodeRecognizer::RecognitionResult& result, int requestId);
     void onRecognitionFailed(const QString& error, int requestId);
+    void onPageChanged(int page);
+    void onRecognizeAllPagesClicked();
 
 private:
     void setupUI();
     void updateImagePreview(const QImage& image);
     void updateResultDisplay(const QRCodeRecognizer::RecognitionResult& result);
-    void loadImageFromFile(const QString& filePath);
+    void loadImageFromFile(const QString& filePath, int page = 0);
+    void updatePageSelector();
+    void recognizeDocument(const QString& filePath, const QRCodeRecognizer::RecognitionConfig& config);
     void processImageList(const QStringList& filePaths);
+    bool isTiledMode() const;
+    QList<QRCodeRecognizer::RecognitionResult> recognizeTiled(const LoadedImage& loaded,
+                                                              const QRCodeRecognizer::RecognitionConfig& config);
+    void recognizeCurrentTiled();
     void applyDefaultStyles() override;
     
     // 主题相关辅助方法
@@ -96,10 +119,14 @@ private:
     
     // UI components - Image area
     QLabel* m_imageLabel;
+    DetectionOverlay* m_resultOverlay;  // 在预览图上绘制识别轮廓
     QScrollArea* m_imageScrollArea;
     QPushButton* m_selectImageButton;
     QPushButton* m_recognizeButton;
     QPushButton* m_multiFormatButton;  // 多格式识别按钮
+    QLabel* m_pageLabel;               // 多页文档的页选择（单页图片时隐藏）
+    QSpinBox* m_pageSpinBox;
+    QPushButton* m_allPagesButton;     // 识别多页文档的全部页
     
     // UI components - Network input
     QLineEdit* m_urlLineEdit;
@@ -112,6 +139,9 @@ private:
     QCheckBox* m_tryRotateCheckBox;
     QCheckBox* m_fastModeCheckBox;
     QSpinBox* m_maxSymbolsSpinBox;
+    QComboBox* m_profileComboBox;
+    QCheckBox* m_tiledCheckBox;         // 大幅面分块识别
+    QSpinBox* m_moduleSizeSpinBox;      // 分块识别的预期模块尺寸
     
     // UI components - Results
     QGroupBox* m_resultsGroup;
@@ -123,8 +153,9 @@ private:
     
     // Data
     QImage m_currentImage;
-    QPixmap m_currentPixmap;
-    QPixmap m_currentPixmapWithContour;  // 保存带轮廓的图像
+    LoadedImage m_loadedImage;          // 当前图片的加载信息（来源、原始尺寸），用于原始分辨率重试
+    std::unique_ptr<TiledRecognizer> m_tiledRecognizer; // 首次分块识别时创建
+    std::unique_ptr<DocumentRecognizer> m_documentRecognizer; // 首次识别多页文档时创建
     QList<QRCodeRecognizer::RecognitionResult> m_results;
     int m_requestCounter;
     
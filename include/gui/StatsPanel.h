@@ -0,0 +1,39 @@
+#pragma once
+
+#include "BaseWidget.h"
+
+class QTableWidget;
+class QTimer;
+
+/**
+ * @class StatsPanel
+ * @brief 识别性能统计面板，定期刷新各阶段耗时的百分位数、丢帧数与吞吐量
+ */
+class StatsPanel : public BaseWidget
+{
+    Q_OBJECT
+
+public:
+    explicit StatsPanel(QWidget* parent = nullptr);
+    ~StatsPanel() = default;
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private slots:
+    void refresh();
+    void onExportJson();
+    void onReset();
+
+private:
+    void setupUI();
+
+    QLabel* m_summaryLabel;
+    QTableWidget* m_stageTable;
+    QPushButton* m_exportButton;
+    QPushButton* m_resetButton;
+    QTimer* m_refreshTimer;
+
+    static const int REFRESH_INTERVAL = 1000; // ms
+};
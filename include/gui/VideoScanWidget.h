@@ -0,0 +1,55 @@
+#pragma once
+
+#include "BaseWidget.h"
+#include "core/VideoFileScanner.h"
+
+class QLineEdit;
+class QCheckBox;
+class QProgressBar;
+class QTableWidget;
+class QTimer;
+
+/**
+ * @class VideoScanWidget
+ * @brief 视频文件识别界面：离线扫描录像并显示去重后的带时间戳检测记录
+ */
+class VideoScanWidget : public BaseWidget
+{
+    Q_OBJECT
+
+public:
+    explicit VideoScanWidget(QWidget* parent = nullptr);
+    ~VideoScanWidget() = default;
+
+signals:
+    void qrCodeDetected(const QString& text, const QRCodeRecognizer::RecognitionResult& result);
+
+private slots:
+    void onBrowseClicked();
+    void onStartStopClicked();
+    void onExportClicked();
+    void onDetectionAdded(int index);
+    void onDetectionUpdated(int index);
+    void onScanFinished(const VideoFileScanner::Statistics& statistics);
+    void onScanError(const QString& error);
+    void updateProgress();
+
+private:
+    void setupUI();
+    void setDetectionRow(int row, const VideoFileScanner::Detection& detection);
+    void setRunning(bool running);
+
+    VideoFileScanner* m_scanner;
+
+    QLineEdit* m_fileEdit;
+    QPushButton* m_browseButton;
+    QPushButton* m_startStopButton;
+    QCheckBox* m_skipSimilarCheckBox;
+    QProgressBar* m_progressBar;
+    QLabel* m_statusLabel;
+    QTableWidget* m_detectionTable;
+    QPushButton* m_exportButton;
+    QTimer* m_progressTimer;
+
+    static const int PROGRESS_INTERVAL = 250; // ms
+};
@@ -44,6 +44,12 @@ public:
      */
     static QString getSaveImageFileFilter();
 
+    /**
+     * @brief 获取视频文件过滤器
+     * @return 打开视频文件对话框过滤器字符串
+     */
+    static QString getVideoFileFilter();
+
     /**
      * @brief 格式化文件大小
      * @param bytes 字节数
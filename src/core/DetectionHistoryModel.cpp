@@ -0,0 +1,255 @@
+#include "core/DetectionHistoryModel.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtEndian>
+
+#include <algorithm>
+
+DetectionHistoryModel::DetectionHistoryModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_spillCache(256)
+{
+    m_spillFile.setFileTemplate(QDir::tempPath() + "/qrcode_history_XXXXXX.jsonl");
+}
+
+int DetectionHistoryModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+QVariant DetectionHistoryModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rowCount) {
+        return QVariant();
+    }
+
+    if (role != Qt::DisplayRole && role != Qt::ToolTipRole) {
+        return QVariant();
+    }
+
+    Entry item = entry(index.row());
+    if (role == Qt::ToolTipRole) {
+        return QString("格式: %1\n首次: %2\n最后: %3\n次数: %4\n\n%5")
+            .arg(item.result.formatName())
+            .arg(item.firstSeen.toString("yyyy-MM-dd hh:mm:ss"))
+            .arg(item.lastSeen.toString("yyyy-MM-dd hh:mm:ss"))
+            .arg(item.hits)
+            .arg(item.result.text);
+    }
+
+    // 列表中只显示第一行内容，完整内容见提示
+    QString text = item.result.text.section('\n', 0, 0);
+    QString display = QString("[%1] %2  %3")
+                          .arg(item.firstSeen.toString("hh:mm:ss"))
+                          .arg(item.result.formatName())
+                          .arg(text);
+    if (item.hits > 1) {
+        display += QString("  ×%1（最后 %2）").arg(item.hits).arg(item.lastSeen.toString("hh:mm:ss"));
+    }
+    return display;
+}
+
+bool DetectionHistoryModel::addDetection(const QRCodeRecognizer::RecognitionResult& result, const QDateTime& time)
+{
+    quint64 digest = digestOf(result);
+    for (auto it = m_index.constFind(digest); it != m_index.constEnd() && it.key() == digest; ++it) {
+        int row = it.value();
+        if (Entry* recent = recentEntry(row)) {
+            if (!sameContent(recent->result, result)) {
+                continue;
+            }
+            recent->lastSeen = time;
+            ++recent->hits;
+        } else {
+            Entry spilled = readSpilled(row);
+            if (!sameContent(spilled.result, result)) {
+                continue;
+            }
+            spilled.lastSeen = time;
+            ++spilled.hits;
+            writeSpilled(row, spilled);
+        }
+        emit dataChanged(index(row), index(row));
+        return false;
+    }
+
+    Entry item;
+    item.result = result;
+    item.firstSeen = time;
+    item.lastSeen = time;
+    item.hits = 1;
+
+    beginInsertRows(QModelIndex(), m_rowCount, m_rowCount);
+    m_recent.append(item);
+    m_index.insert(digest, m_rowCount);
+    ++m_rowCount;
+    endInsertRows();
+
+    if (m_recent.size() >= MAX_IN_MEMORY) {
+        spillOldest();
+    }
+    return true;
+}
+
+DetectionHistoryModel::Entry DetectionHistoryModel::entry(int row) const
+{
+    if (row >= m_spilledCount) {
+        return m_recent.at(row - m_spilledCount);
+    }
+    return readSpilled(row);
+}
+
+void DetectionHistoryModel::clear()
+{
+    beginResetModel();
+    m_recent.clear();
+    m_index.clear();
+    m_rowCount = 0;
+    m_spilledCount = 0;
+    m_spillOffsets.clear();
+    m_spillCache.clear();
+    if (m_spillFile.isOpen()) {
+        m_spillFile.resize(0);
+    }
+    endResetModel();
+}
+
+bool DetectionHistoryModel::exportText(QTextStream& out) const
+{
+    auto write = [&out](int row, const Entry& item) {
+        out << "=== 检测 " << (row + 1) << " ===\n";
+        out << "内容: " << item.result.text << "\n";
+        out << "格式: " << item.result.formatName() << "\n";
+        out << "置信度: " << QString::number(item.result.confidence, 'f', 2) << "\n";
+        out << "首次检测: " << item.firstSeen.toString("yyyy-MM-dd hh:mm:ss") << "\n";
+        out << "最后检测: " << item.lastSeen.toString("yyyy-MM-dd hh:mm:ss") << "\n";
+        out << "检测次数: " << item.hits << "\n\n";
+    };
+
+    // 已写出的行按顺序从临时文件读取，只有更新后移到文件末尾的行需要重新定位
+    for (int row = 0; row < m_spilledCount; ++row) {
+        qint64 offset = m_spillOffsets.at(row);
+        if (m_spillFile.pos() != offset && !m_spillFile.seek(offset)) {
+            return false;
+        }
+        write(row, deserialize(m_spillFile.readLine()));
+    }
+
+    for (int i = 0; i < m_recent.size(); ++i) {
+        write(m_spilledCount + i, m_recent.at(i));
+    }
+    return out.status() == QTextStream::Ok;
+}
+
+quint64 DetectionHistoryModel::digestOf(const QRCodeRecognizer::RecognitionResult& result)
+{
+    // 内容可能很长（如整页的PDF417），索引只保存固定大小的摘要
+    QByteArray hash = QCryptographicHash::hash((result.formatName() + '\n' + result.text).toUtf8(),
+                                               QCryptographicHash::Sha1);
+    return qFromLittleEndian<quint64>(hash.constData());
+}
+
+bool DetectionHistoryModel::sameContent(const QRCodeRecognizer::RecognitionResult& a,
+                                        const QRCodeRecognizer::RecognitionResult& b)
+{
+    return a.format == b.format && a.text == b.text;
+}
+
+QByteArray DetectionHistoryModel::serialize(const Entry& entry)
+{
+    QJsonObject json;
+    json["text"] = entry.result.text;
+    json["format"] = static_cast<int>(entry.result.format);
+    json["confidence"] = entry.result.confidence;
+    json["firstSeen"] = entry.firstSeen.toMSecsSinceEpoch();
+    json["lastSeen"] = entry.lastSeen.toMSecsSinceEpoch();
+    json["hits"] = entry.hits;
+    return QJsonDocument(json).toJson(QJsonDocument::Compact) + '\n';
+}
+
+DetectionHistoryModel::Entry DetectionHistoryModel::deserialize(const QByteArray& line)
+{
+    QJsonObject json = QJsonDocument::fromJson(line).object();
+
+    Entry entry;
+    entry.result.text = json["text"].toString();
+    entry.result.isValid = true;
+    entry.result.format = static_cast<ZXing::BarcodeFormat>(json["format"].toInt());
+    entry.result.confidence = json["confidence"].toDouble();
+    entry.firstSeen = QDateTime::fromMSecsSinceEpoch(json["firstSeen"].toInteger());
+    entry.lastSeen = QDateTime::fromMSecsSinceEpoch(json["lastSeen"].toInteger());
+    entry.hits = json["hits"].toInt();
+    return entry;
+}
+
+void DetectionHistoryModel::spillOldest()
+{
+    if (!m_spillFile.isOpen() && !m_spillFile.open()) {
+        // 无法写临时文件时继续保留在内存中
+        qWarning() << "Cannot open history spill file:" << m_spillFile.errorString();
+        return;
+    }
+
+    QByteArray batch;
+    qint64 offset = m_spillFile.size();
+    int count = std::min(SPILL_BATCH, static_cast<int>(m_recent.size()));
+    for (int i = 0; i < count; ++i) {
+        QByteArray line = serialize(m_recent.at(i));
+        m_spillOffsets.append(offset);
+        offset += line.size();
+        batch += line;
+    }
+
+    if (!m_spillFile.seek(m_spillFile.size()) || m_spillFile.write(batch) != batch.size()) {
+        qWarning() << "Failed to write history spill file:" << m_spillFile.errorString();
+        m_spillOffsets.resize(m_spilledCount);
+        return;
+    }
+
+    m_recent.erase(m_recent.begin(), m_recent.begin() + count);
+    m_spilledCount += count;
+}
+
+DetectionHistoryModel::Entry DetectionHistoryModel::readSpilled(int row) const
+{
+    if (Entry* cached = m_spillCache.object(row)) {
+        return *cached;
+    }
+
+    Entry item;
+    if (m_spillFile.seek(m_spillOffsets.at(row))) {
+        item = deserialize(m_spillFile.readLine());
+    }
+    m_spillCache.insert(row, new Entry(item));
+    return item;
+}
+
+void DetectionHistoryModel::writeSpilled(int row, const Entry& entry)
+{
+    m_spillCache.insert(row, new Entry(entry));
+
+    // 新的记录不长于原记录时（通常只有次数和时间变化）用空格补齐后原位覆盖，否则追加到文件末尾
+    QByteArray line = serialize(entry);
+    qint64 offset = m_spillOffsets.at(row);
+    QByteArray previous = m_spillFile.seek(offset) ? m_spillFile.readLine() : QByteArray();
+    if (line.size() <= previous.size()) {
+        line.insert(line.size() - 1, QByteArray(previous.size() - line.size(), ' '));
+    } else {
+        offset = m_spillFile.size();
+    }
+
+    if (!m_spillFile.seek(offset) || m_spillFile.write(line) != line.size()) {
+        qWarning() << "Failed to update history spill file:" << m_spillFile.errorString();
+        return;
+    }
+    m_spillOffsets[row] = offset;
+}
+
+DetectionHistoryModel::Entry* DetectionHistoryModel::recentEntry(int row)
+{
+    return row >= m_spilledCount ? &m_recent[row - m_spilledCount] : nullptr;
+}
@@ -0,0 +1,194 @@
+#include "core/DocumentRecognizer.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QMap>
+#include <QMutex>
+#include <QSemaphore>
+#include <QTextStream>
+
+#include <algorithm>
+
+namespace {
+
+QString csvField(QString text)
+{
+    text.replace('"', "\"\"");
+    return '"' + text + '"';
+}
+
+QString pageList(const QList<int>& pages)
+{
+    QStringList numbers;
+    for (int page : pages) {
+        numbers << QString::number(page + 1);
+    }
+    return numbers.join(';');
+}
+
+} // namespace
+
+int DocumentRecognizer::DocumentResult::symbolCount() const
+{
+    int count = 0;
+    for (const auto& page : pages) {
+        count += page.results.size();
+    }
+    return count;
+}
+
+DocumentRecognizer::DocumentRecognizer() = default;
+
+DocumentRecognizer::~DocumentRecognizer() = default;
+
+DocumentRecognizer::DocumentResult DocumentRecognizer::recognizeFile(const QString& filePath,
+                                                                     const QRCodeRecognizer::RecognitionConfig& config,
+                                                                     const ProgressCallback& progress)
+{
+    DocumentResult document;
+    document.filePath = filePath;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QImageReader reader(filePath);
+    if (!reader.canRead()) {
+        document.error = QString("无法读取文件: %1").arg(reader.errorString());
+        return document;
+    }
+
+    // 不提供页数的格式（如部分GIF）一直读到没有下一帧
+    int pageCount = std::max(0, reader.imageCount());
+
+    QRCodeRecognizer::RecognitionConfig pageConfig = RecognizerPool::workerConfig(config);
+    QMap<int, PageResult> pages;
+    QMap<QString, ZXing::Barcodes> sequenceParts;  // 格式+序列标识 -> 序列符号
+    QMap<QString, QList<int>> sequencePages;
+    QMutex resultMutex;
+    QSemaphore pageSlots(PAGES_IN_FLIGHT_PER_THREAD * m_pool.maxThreadCount());
+
+    int page = 0;
+    for (; pageCount > 0 ? page < pageCount : reader.canRead(); ++page) {
+        // 支持随机访问的格式（TIFF、ICO）按页定位，其他格式每次读取后自动前进到下一帧
+        if (page > 0) {
+            reader.jumpToImage(page);
+        }
+
+        QImage image = reader.read();
+        if (image.isNull()) {
+            if (pageCount == 0) {
+                break;
+            }
+            PageResult failed;
+            failed.page = page;
+            failed.error = QString("无法读取该页: %1").arg(reader.errorString());
+            {
+                QMutexLocker locker(&resultMutex);
+                pages.insert(page, failed);
+            }
+            // 无法读取的页同样计入进度，否则进度停在该页之前
+            if (progress) {
+                progress(page + 1, pageCount);
+            }
+            continue;
+        }
+
+        // 读出的页数超过积压上限时等待工作线程
+        pageSlots.acquire();
+        m_pool.start([&pageConfig, &pages, &sequenceParts, &sequencePages, &resultMutex, &pageSlots, page, image](
+                         QRCodeRecognizer* recognizer) {
+            // 识别只需要亮度；传真页多为单色，转换为灰度后每像素一个字节
+            QImage gray = image.format() == QImage::Format_Grayscale8
+                              ? image
+                              : image.convertToFormat(QImage::Format_Grayscale8);
+
+            PageResult result;
+            result.page = page;
+            ZXing::Barcodes parts;
+            result.results = recognizer->recognizeMultiFormat(gray, pageConfig, &parts);
+            if (result.results.isEmpty()) {
+                result.error = recognizer->getLastError();
+            }
+
+            {
+                QMutexLocker locker(&resultMutex);
+                pages.insert(page, result);
+                for (const auto& part : parts) {
+                    QString key = QString::fromStdString(ZXing::ToString(part.format())) + '/' +
+                                  QString::fromStdString(part.sequenceId());
+                    sequenceParts[key].push_back(part);
+                    if (!sequencePages[key].contains(page)) {
+                        sequencePages[key].append(page);
+                    }
+                }
+            }
+            pageSlots.release();
+        });
+
+        if (progress) {
+            progress(page + 1, pageCount);
+        }
+    }
+    m_pool.waitForDone();
+
+    document.pageCount = page;
+    document.pages = pages.values();
+
+    // 结构化追加序列可能跨页，全部页识别完成后再合并
+    for (auto it = sequenceParts.constBegin(); it != sequenceParts.constEnd(); ++it) {
+        QRCodeRecognizer::RecognitionResult merged = QRCodeRecognizer::mergeStructuredAppend(it.value());
+        QList<int> partPages = sequencePages.value(it.key());
+        std::sort(partPages.begin(), partPages.end());
+
+        if (merged.isValid) {
+            SequenceResult sequence;
+            sequence.result = merged;
+            sequence.pages = partPages;
+            document.sequences.append(sequence);
+        } else {
+            const auto& first = it.value().front();
+            document.incompleteSequences.append(
+                QString("%1 序列 %2：识别到 %3 个符号，共 %4 个（页 %5）")
+                    .arg(QString::fromStdString(ZXing::ToString(first.format())))
+                    .arg(QString::fromStdString(first.sequenceId()))
+                    .arg(static_cast<int>(it.value().size()))
+                    .arg(first.sequenceSize() > 0 ? QString::number(first.sequenceSize()) : QString("未知"))
+                    .arg(pageList(partPages)));
+        }
+    }
+
+    document.elapsedMs = timer.elapsed();
+    return document;
+}
+
+bool DocumentRecognizer::writeReport(QTextStream& out, const QList<DocumentResult>& documents)
+{
+    out << "文件,页,符号,格式,内容,结构化追加\n";
+    for (const auto& document : documents) {
+        QString fileName = csvField(QFileInfo(document.filePath).fileName());
+        if (!document.error.isEmpty()) {
+            out << fileName << ",,,," << csvField(document.error) << ",\n";
+            continue;
+        }
+
+        for (const auto& page : document.pages) {
+            for (int i = 0; i < page.results.size(); ++i) {
+                const auto& result = page.results[i];
+                QString sequence = result.isPartOfSequence()
+                                       ? QString("%1/%2").arg(result.sequenceIndex + 1).arg(result.sequenceSize)
+                                       : QString();
+                out << fileName << ',' << (page.page + 1) << ',' << (i + 1) << ','
+                    << result.formatName() << ',' << csvField(result.text) << ',' << sequence << '\n';
+            }
+        }
+
+        // 合并后的序列：页列出所有符号所在的页
+        for (const auto& sequence : document.sequences) {
+            out << fileName << ',' << csvField(pageList(sequence.pages)) << ",,"
+                << sequence.result.formatName() << ',' << csvField(sequence.result.text) << ','
+                << QString("合并 %1 个符号").arg(sequence.result.sequenceSize) << '\n';
+        }
+    }
+    return out.status() == QTextStream::Ok;
+}
@@ -0,0 +1,136 @@
+#include "core/FrameSharpness.h"
+
+#include <QVideoFrameFormat>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+double FrameSharpness::fromImage(const QImage& image)
+{
+    if (image.isNull()) {
+        return -1.0;
+    }
+
+    QImage source = image;
+    if (source.format() == QImage::Format_Grayscale8) {
+        return fromLuminance(source.constBits(), source.width(), source.height(), source.bytesPerLine(), 1);
+    }
+    if (source.depth() != 32) {
+        source = source.convertToFormat(QImage::Format_RGB32);
+    }
+
+    // 32位像素以绿色分量近似亮度，绿色在内存中的位置取决于字节序
+    const int greenOffset = Q_BYTE_ORDER == Q_LITTLE_ENDIAN ? 1 : 2;
+    return fromLuminance(source.constBits() + greenOffset, source.width(), source.height(), source.bytesPerLine(), 4);
+}
+
+double FrameSharpness::fromVideoFrame(const QVideoFrame& frame)
+{
+    if (!frame.isValid()) {
+        return -1.0;
+    }
+
+    // 亮度字节在第0平面中的偏移与间距；16位格式取高字节
+    int offset = 0;
+    int pixelStride = 1;
+    switch (frame.pixelFormat()) {
+    case QVideoFrameFormat::Format_YUV420P:
+    case QVideoFrameFormat::Format_YUV422P:
+    case QVideoFrameFormat::Format_YV12:
+    case QVideoFrameFormat::Format_NV12:
+    case QVideoFrameFormat::Format_NV21:
+    case QVideoFrameFormat::Format_IMC1:
+    case QVideoFrameFormat::Format_IMC2:
+    case QVideoFrameFormat::Format_IMC3:
+    case QVideoFrameFormat::Format_IMC4:
+    case QVideoFrameFormat::Format_Y8:
+        break;
+    case QVideoFrameFormat::Format_P010:
+    case QVideoFrameFormat::Format_P016:
+    case QVideoFrameFormat::Format_Y16:
+        offset = 1;
+        pixelStride = 2;
+        break;
+    case QVideoFrameFormat::Format_YUYV:
+        pixelStride = 2;
+        break;
+    case QVideoFrameFormat::Format_UYVY:
+        offset = 1;
+        pixelStride = 2;
+        break;
+    case QVideoFrameFormat::Format_BGRA8888:
+    case QVideoFrameFormat::Format_BGRX8888:
+    case QVideoFrameFormat::Format_RGBA8888:
+    case QVideoFrameFormat::Format_RGBX8888:
+        // 以绿色分量近似亮度
+        offset = 1;
+        pixelStride = 4;
+        break;
+    case QVideoFrameFormat::Format_ARGB8888:
+    case QVideoFrameFormat::Format_XRGB8888:
+    case QVideoFrameFormat::Format_ABGR8888:
+    case QVideoFrameFormat::Format_XBGR8888:
+        offset = 2;
+        pixelStride = 4;
+        break;
+    default:
+        return -1.0;
+    }
+
+    QVideoFrame mapped(frame);
+    if (!mapped.map(QVideoFrame::ReadOnly)) {
+        return -1.0;
+    }
+
+    double sharpness = -1.0;
+    if (mapped.bits(0)) {
+        sharpness = fromLuminance(mapped.bits(0) + offset, mapped.width(), mapped.height(),
+                                  mapped.bytesPerLine(0), pixelStride);
+    }
+    mapped.unmap();
+    return sharpness;
+}
+
+double FrameSharpness::fromLuminance(const uchar* data, int width, int height, int bytesPerLine, int pixelStride)
+{
+    if (!data || width < GRID_SIZE * STEP || height < GRID_SIZE * STEP) {
+        return -1.0;
+    }
+
+    std::vector<double> blocks(GRID_SIZE * GRID_SIZE, 0.0);
+    for (int by = 0; by < GRID_SIZE; ++by) {
+        // 每块最后一行/列不作为起点，保证相邻像素仍在图像内
+        int y0 = by * height / GRID_SIZE;
+        int y1 = std::min((by + 1) * height / GRID_SIZE, height - 1);
+        for (int bx = 0; bx < GRID_SIZE; ++bx) {
+            int x0 = bx * width / GRID_SIZE;
+            int x1 = std::min((bx + 1) * width / GRID_SIZE, width - 1);
+
+            quint64 energy = 0;
+            quint32 count = 0;
+            for (int y = y0, row = 0; y < y1; y += STEP, ++row) {
+                for (int x = x0, column = 0; x < x1; x += STEP, ++column) {
+                    // 抽样点在网格内错开，避免与条码模块宽度同周期时恰好全部落在同色区域内
+                    int px = std::min(x + row % STEP, x1 - 1);
+                    int py = std::min(y + column % STEP, y1 - 1);
+                    const uchar* line = data + static_cast<qsizetype>(py) * bytesPerLine;
+                    int center = line[px * pixelStride];
+                    int dx = line[(px + 1) * pixelStride] - center;
+                    int dy = line[bytesPerLine + px * pixelStride] - center;
+                    energy += dx * dx + dy * dy;
+                    ++count;
+                }
+            }
+            blocks[by * GRID_SIZE + bx] = count ? static_cast<double>(energy) / count : 0.0;
+        }
+    }
+
+    // 只统计纹理最强的块，条码所在区域决定评分
+    std::partial_sort(blocks.begin(), blocks.begin() + TOP_BLOCKS, blocks.end(), std::greater<double>());
+    double sum = 0.0;
+    for (int i = 0; i < TOP_BLOCKS; ++i) {
+        sum += blocks[i];
+    }
+    return sum / TOP_BLOCKS;
+}
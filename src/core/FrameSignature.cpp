@@ -0,0 +1,60 @@
+#include "core/FrameSignature.h"
+
+#include <cstdlib>
+
+FrameSignature FrameSignature::fromImage(const QImage& image)
+{
+    FrameSignature signature;
+    if (image.isNull() || image.width() < GRID_SIZE || image.height() < GRID_SIZE) {
+        return signature;
+    }
+
+    // 摄像头与视频帧通常已是32位格式，只有其他格式才需要整帧转换
+    QImage source = image;
+    bool gray = source.format() == QImage::Format_Grayscale8;
+    if (!gray && source.depth() != 32) {
+        source = source.convertToFormat(QImage::Format_RGB32);
+    }
+
+    const int step = 2; // 块内每隔一行一列抽样
+    signature.m_blocks.resize(GRID_SIZE * GRID_SIZE);
+    for (int by = 0; by < GRID_SIZE; ++by) {
+        int y0 = by * source.height() / GRID_SIZE;
+        int y1 = (by + 1) * source.height() / GRID_SIZE;
+        for (int bx = 0; bx < GRID_SIZE; ++bx) {
+            int x0 = bx * source.width() / GRID_SIZE;
+            int x1 = (bx + 1) * source.width() / GRID_SIZE;
+
+            quint32 sum = 0;
+            quint32 count = 0;
+            for (int y = y0; y < y1; y += step) {
+                const uchar* line = source.constScanLine(y);
+                for (int x = x0; x < x1; x += step) {
+                    if (gray) {
+                        sum += line[x];
+                    } else {
+                        QRgb pixel = reinterpret_cast<const QRgb*>(line)[x];
+                        // 与ZXing相同的整数亮度近似
+                        sum += (306 * qRed(pixel) + 601 * qGreen(pixel) + 117 * qBlue(pixel) + 512) >> 10;
+                    }
+                    ++count;
+                }
+            }
+            signature.m_blocks[by * GRID_SIZE + bx] = static_cast<quint8>(count ? sum / count : 0);
+        }
+    }
+    return signature;
+}
+
+double FrameSignature::difference(const FrameSignature& other) const
+{
+    if (isNull() || other.isNull() || m_blocks.size() != other.m_blocks.size()) {
+        return 255.0;
+    }
+
+    int total = 0;
+    for (int i = 0; i < m_blocks.size(); ++i) {
+        total += std::abs(int(m_blocks[i]) - int(other.m_blocks[i]));
+    }
+    return static_cast<double>(total) / m_blocks.size();
+}
@@ -1,12 +1,21 @@
 #include "core/QRCodeRecognizer.h"
+#include "core/RecognitionTelemetry.h"
+#include "core/ScaledImageLoader.h"
 #include <QDebug>
-#include <QPainter>
 #include <QDateTime>
 #include <QApplication>
+#include <QElapsedTimer>
 
 // ZXing includes
 #include "ImageView.h"
+#include "Prescreen.h"
 #include "BarcodeFormat.h"
+#include "Utf.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
 
 QRCodeRecognizer::QRCodeRecognizer(QObject* parent)
     : QObject(parent)
@@ -44,6 +53,7 @@ void QRCodeRecognizer::recognizeAsync(const QImage& image, int requestId, const
     // 限制队列大小
     if (m_requestQueue.size() >= MAX_QUEUE_SIZE) {
         m_requestQueue.dequeue(); // 移除最老的请求
+        RecognitionTelemetry::instance().addDroppedFrame();
     }
     
     AsyncRequest request;
@@ -70,58 +80,6 @@ QRCodeRecognizer::RecognitionResult QRCodeRecognizer::recognizeFromPixmap(const
     return recognizeSync(pixmap.toImage(), config);
 }
 
-QPixmap QRCodeRecognizer::drawContour(const QPixmap& originalImage, const RecognitionResult& result)
-{
-    if (originalImage.isNull() || !result.isValid) {
-        return originalImage;
-    }
-
-    QPixmap resultImage = originalImage;
-    QPainter painter(&resultImage);
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    // 设置绘制样式
-    QPen pen(Qt::red, 3);
-    painter.setPen(pen);
-    painter.setBrush(Qt::NoBrush);
-
-    // 绘制二维码轮廓
-    const auto& pos = result.position;
-    QPolygon polygon;
-    polygon << QPoint(pos.topLeft().x, pos.topLeft().y)
-            << QPoint(pos.topRight().x, pos.topRight().y)
-            << QPoint(pos.bottomRight().x, pos.bottomRight().y)
-            << QPoint(pos.bottomLeft().x, pos.bottomLeft().y);
-    
-    painter.drawPolygon(polygon);
-
-    // 绘制角点
-    painter.setBrush(Qt::red);
-    int pointSize = 8;
-    for (const auto& point : {pos.topLeft(), pos.topRight(), pos.bottomRight(), pos.bottomLeft()}) {
-        painter.drawEllipse(QPoint(point.x, point.y), pointSize/2, pointSize/2);
-    }
-
-    // 绘制识别信息
-    if (!result.text.isEmpty()) {
-        painter.setPen(Qt::white);
-        painter.setBrush(QColor(0, 0, 0, 180));
-        
-        QFontMetrics fm(painter.font());
-        QString displayText = result.text.length() > 50 ? 
-                             result.text.left(47) + "..." : result.text;
-        QRect textRect = fm.boundingRect(displayText);
-        textRect.adjust(-5, -2, 5, 2);
-        textRect.moveTopLeft(QPoint(pos.topLeft().x, pos.topLeft().y - textRect.height() - 5));
-        
-        painter.drawRect(textRect);
-        painter.setPen(Qt::white);
-        painter.drawText(textRect, Qt::AlignCenter, displayText);
-    }
-
-    return resultImage;
-}
-
 QString QRCodeRecognizer::getLastError() const
 {
     return m_lastError;
@@ -145,6 +103,9 @@ void QRCodeRecognizer::processRecognitionQueue()
     
     AsyncRequest request = m_requestQueue.dequeue();
     locker.unlock();
+
+    // 记录请求在队列中的等待时间
+    RecognitionTelemetry::instance().addTiming("queueWait", (QDateTime::currentMSecsSinceEpoch() - request.timestamp) * 1000);
     
     m_processing = true;
     
@@ -178,27 +139,15 @@ ZXing::ReaderOptions QRCodeRecognizer::convertConfig(const RecognitionConfig& co
 {
     ZXing::ReaderOptions options;
     
-    // 设置支持所有主要条码格式
-    options.setFormats(ZXing::BarcodeFormat::QRCode | 
-                      ZXing::BarcodeFormat::MicroQRCode |
-                      ZXing::BarcodeFormat::DataMatrix |
-                      ZXing::BarcodeFormat::PDF417 |
-                      ZXing::BarcodeFormat::Code128 |
-                      ZXing::BarcodeFormat::Code39 |
-                      ZXing::BarcodeFormat::Code93 |
-                      ZXing::BarcodeFormat::Codabar |
-                      ZXing::BarcodeFormat::EAN8 |
-                      ZXing::BarcodeFormat::EAN13 |
-                      ZXing::BarcodeFormat::UPCA |
-                      ZXing::BarcodeFormat::UPCE |
-                      ZXing::BarcodeFormat::ITF |
-                      ZXing::BarcodeFormat::Aztec |
-                      ZXing::BarcodeFormat::MaxiCode);
+    // 设置启用的条码格式
+    options.setFormats(selectFormats(config));
     
     // 设置其他选项
     options.setTryHarder(config.tryHarder);
     options.setTryRotate(config.tryRotate);
     options.setMaxNumberOfSymbols(config.maxSymbols);
+    options.setPrescreen(config.prescreen);
+    options.setMaxThreads(static_cast<uint8_t>(std::clamp(config.maxThreads, 0, 255)));
     
     // 根据快速模式调整其他参数
     if (config.fastMode) {
@@ -209,28 +158,230 @@ ZXing::ReaderOptions QRCodeRecognizer::convertConfig(const RecognitionConfig& co
     return options;
 }
 
-QImage QRCodeRecognizer::preprocessImage(const QImage& image)
+ZXing::Barcodes QRCodeRecognizer::readProgressive(const ZXing::ImageView& imageView, const ZXing::ReaderOptions& options, int timeoutMs)
 {
-    QImage processed = image;
-    
-    // 转换为合适的格式
-    if (processed.format() != QImage::Format_RGBX8888 && 
-        processed.format() != QImage::Format_RGB32) {
-        processed = processed.convertToFormat(QImage::Format_RGBX8888);
+    auto deadline = ZXing::Deadline::In(std::chrono::milliseconds(timeoutMs));
+
+    // 升级阶梯：每一级在上一级的基础上多开启一项更耗时的策略，上限为配置本身允许的策略
+    auto stage = ZXing::ReaderOptions(options).setDeadline(deadline).setTryRotate(false).setTryInvert(false).setTryHarder(false);
+#ifdef ZXING_EXPERIMENTAL_API
+    stage.setTryDenoise(false);
+#endif
+    std::vector<ZXing::ReaderOptions> stages{stage};
+    if (options.tryRotate())
+        stages.push_back(stage.setTryRotate(true));
+    if (options.tryInvert())
+        stages.push_back(stage.setTryInvert(true));
+    if (options.tryHarder())
+        stages.push_back(stage.setTryHarder(true));
+#ifdef ZXING_EXPERIMENTAL_API
+    if (options.tryHarder())
+        stages.push_back(stage.setTryDenoise(true));
+#endif
+
+    // 后面的级别是前面级别的超集，超时中断时可能只返回部分结果，因此保留符号最多的一级
+    ZXing::Barcodes best;
+    int wanted = options.maxNumberOfSymbols();
+    for (const auto& stageOptions : stages) {
+        if (deadline.expired())
+            break;
+        auto barcodes = ZXing::ReadBarcodes(imageView, stageOptions);
+        if (barcodes.size() > best.size())
+            best = std::move(barcodes);
+        if (wanted > 0 && static_cast<int>(best.size()) >= wanted)
+            break;
+    }
+    return best;
+}
+
+ZXing::BarcodeFormats QRCodeRecognizer::profileFormats(SymbologyProfile profile)
+{
+    using ZXing::BarcodeFormat;
+
+    switch (profile) {
+        case SymbologyProfile::Retail1D:
+            return BarcodeFormat::EAN13 | BarcodeFormat::EAN8 | BarcodeFormat::UPCA | BarcodeFormat::UPCE;
+        case SymbologyProfile::Logistics:
+            return BarcodeFormat::Code128 | BarcodeFormat::ITF | BarcodeFormat::Code39 |
+                   BarcodeFormat::DataMatrix | BarcodeFormat::PDF417 | BarcodeFormat::QRCode;
+        case SymbologyProfile::TwoD:
+            return BarcodeFormat::QRCode | BarcodeFormat::MicroQRCode | BarcodeFormat::DataMatrix |
+                   BarcodeFormat::PDF417 | BarcodeFormat::Aztec | BarcodeFormat::MaxiCode;
+        case SymbologyProfile::QROnly:
+            return BarcodeFormat::QRCode;
+        case SymbologyProfile::All:
+        default: {
+            ZXing::BarcodeFormats formats;
+            for (auto format : getFormatsOrderedByPopularity())
+                formats |= format;
+            return formats;
+        }
+    }
+}
+
+void QRCodeRecognizer::resetAdaptiveFormats()
+{
+    QMutexLocker locker(&m_formatStatsMutex);
+    m_seenFormats = {};
+    m_seenSymbols = 0;
+    m_adaptiveScans = 0;
+}
+
+ZXing::BarcodeFormats QRCodeRecognizer::selectFormats(const RecognitionConfig& config)
+{
+    // 空集合在ZXing中表示任意格式，这里统一为全部常用格式
+    auto formats = config.formats.empty() ? profileFormats(SymbologyProfile::All) : config.formats;
+    if (!config.adaptiveFormats) {
+        return formats;
     }
+
+    QMutexLocker locker(&m_formatStatsMutex);
+    // 样本不足或到了定期完整扫描的时机，使用全部已配置格式
+    if (m_seenSymbols < ADAPTIVE_MIN_SYMBOLS || ++m_adaptiveScans % ADAPTIVE_FULL_SCAN_INTERVAL == 0) {
+        return formats;
+    }
+
+    auto narrowed = formats & m_seenFormats;
+    return narrowed.empty() ? formats : narrowed;
+}
+
+void QRCodeRecognizer::recordFormats(const QList<RecognitionResult>& results)
+{
+    QMutexLocker locker(&m_formatStatsMutex);
+    for (const auto& result : results) {
+        if (result.isValid) {
+            m_seenFormats |= result.format;
+            ++m_seenSymbols;
+        }
+    }
+}
+
+QString QRCodeRecognizer::decodeText(const ZXing::Barcode& barcode)
+{
+    // 批量识别时每个线程只保留一个缓冲区，其容量在结果之间复用
+    thread_local std::string utf8;
+    utf8.clear();
+    barcode.appendText(utf8);
+
+    // UTF-16码元数不超过UTF-8字节数
+    QString text(static_cast<qsizetype>(utf8.size()), Qt::Uninitialized);
+    auto length = ZXing::Utf8ToUtf16(utf8, reinterpret_cast<char16_t*>(text.data()));
+    text.truncate(static_cast<qsizetype>(length));
+    return text;
+}
+
+QImage QRCodeRecognizer::preprocessImage(const QImage& image, int maxDimension)
+{
+    QImage processed = image;
     
-    // 如果图像太大，进行缩放以提高处理速度
-    const int maxDimension = 1920;
-    if (processed.width() > maxDimension || processed.height() > maxDimension) {
+    // 如果图像太大，先缩放以提高处理速度（缩放后再转换格式，只转换需要的像素）
+    if (maxDimension > 0 && (processed.width() > maxDimension || processed.height() > maxDimension)) {
         processed = processed.scaled(maxDimension, maxDimension, 
                                    Qt::KeepAspectRatio, 
                                    Qt::SmoothTransformation);
     }
     
+    // 转换为合适的格式（灰度图像直接作为亮度使用）
+    if (processed.format() != QImage::Format_Grayscale8 &&
+        processed.format() != QImage::Format_RGBX8888 && 
+        processed.format() != QImage::Format_RGB32) {
+        processed = processed.convertToFormat(QImage::Format_RGBX8888);
+    }
+    
     return processed;
 }
 
-QList<QRCodeRecognizer::RecognitionResult> QRCodeRecognizer::recognizeMultiFormat(const QImage& image, const RecognitionConfig& config)
+bool QRCodeRecognizer::hasCandidateRegions(const QImage& image)
+{
+    if (image.isNull()) {
+        return false;
+    }
+
+    QImage source = image.format() == QImage::Format_Grayscale8 ? image
+                                                                : image.convertToFormat(QImage::Format_Grayscale8);
+    ZXing::ImageView imageView(source.constBits(), source.width(), source.height(),
+                               ZXing::ImageFormat::Lum, static_cast<int>(source.bytesPerLine()));
+    return !ZXing::FindCandidateRegions(imageView).empty();
+}
+
+QList<QRCodeRecognizer::RecognitionResult> QRCodeRecognizer::recognizeFullResolution(const LoadedImage& loaded, const RecognitionConfig& config)
+{
+    // 没有缩小过，或缩小后的图像中连条码结构都没有，原图也不会识别成功
+    if (!loaded.isScaled() || !hasCandidateRegions(loaded.image)) {
+        return {};
+    }
+
+    LoadedImage full = ScaledImageLoader::reloadFullResolution(loaded, true);
+    if (full.isNull()) {
+        m_lastError = QString("无法按原始分辨率加载图像: %1").arg(full.error);
+        return {};
+    }
+
+    RecognitionConfig fullConfig = config;
+    fullConfig.maxDimension = 0;
+    QList<RecognitionResult> results = recognizeMultiFormat(full.image, fullConfig);
+
+    // 角点坐标换算到调用方持有的缩小图像坐标系
+    scalePositions(results, static_cast<double>(loaded.image.width()) / full.image.width(),
+                   static_cast<double>(loaded.image.height()) / full.image.height());
+    return results;
+}
+
+QRCodeRecognizer::RecognitionResult QRCodeRecognizer::mergeStructuredAppend(const ZXing::Barcodes& parts)
+{
+    // 序号必须覆盖 0..n-1 且不重复，否则合并出的内容会缺段（PDF417可能不声明总数，此时按最大序号判断）
+    int count = 0;
+    for (const auto& part : parts) {
+        if (!part.isPartOfSequence()) {
+            return RecognitionResult();
+        }
+        count = std::max({count, part.sequenceSize(), part.sequenceIndex() + 1});
+    }
+
+    // 同一符号可能被识别多次（如多页重复打印），每个序号只保留一个
+    std::vector<bool> present(count, false);
+    ZXing::Barcodes unique;
+    for (const auto& part : parts) {
+        if (!present[part.sequenceIndex()]) {
+            present[part.sequenceIndex()] = true;
+            unique.push_back(part);
+        }
+    }
+    if (count == 0 || static_cast<int>(unique.size()) != count) {
+        return RecognitionResult();
+    }
+
+    ZXing::Barcode merged = ZXing::MergeStructuredAppendSequence(unique);
+    if (!merged.isValid()) {
+        return RecognitionResult();
+    }
+
+    RecognitionResult result;
+    result.text = decodeText(merged);
+    result.isValid = true;
+    result.format = merged.format();
+    result.confidence = 1.0;
+    result.ecLevel = QString::fromStdString(merged.ecLevel());
+    result.version = QString::fromStdString(merged.version());
+    result.sequenceSize = count;
+    result.sequenceId = QString::fromStdString(merged.sequenceId());
+    return result;
+}
+
+void QRCodeRecognizer::scalePositions(QList<RecognitionResult>& results, double scaleX, double scaleY)
+{
+    auto toScaled = [scaleX, scaleY](const ZXing::PointI& p) {
+        return ZXing::PointI(static_cast<int>(p.x * scaleX), static_cast<int>(p.y * scaleY));
+    };
+    for (auto& result : results) {
+        const auto& pos = result.position;
+        result.position = ZXing::QuadrilateralI(toScaled(pos.topLeft()), toScaled(pos.topRight()),
+                                                toScaled(pos.bottomRight()), toScaled(pos.bottomLeft()));
+    }
+}
+
+QList<QRCodeRecognizer::RecognitionResult> QRCodeRecognizer::recognizeMultiFormat(const QImage& image, const RecognitionConfig& config,
+                                                                                  ZXing::Barcodes* sequenceParts)
 {
     QList<RecognitionResult> results;
     
@@ -239,27 +390,40 @@ QList<QRCodeRecognizer::RecognitionResult> QRCodeRecognizer::recognizeMultiForma
         return results;
     }
 
+    auto& telemetry = RecognitionTelemetry::instance();
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
     try {
         // 预处理图像
-        QImage processedImage = preprocessImage(image);
+        QImage processedImage = preprocessImage(image, config.maxDimension);
+        telemetry.addTiming("preprocess", totalTimer.nsecsElapsed() / 1000);
         
         // 计算缩放比例（用于坐标转换）
         double scaleX = static_cast<double>(image.width()) / processedImage.width();
         double scaleY = static_cast<double>(image.height()) / processedImage.height();
         
         // 创建ZXing的ImageView
-        ZXing::ImageView imageView(processedImage.bits(), 
+        ZXing::ImageView imageView(processedImage.constBits(), 
                                   processedImage.width(), 
                                   processedImage.height(),
-                                  ZXing::ImageFormat::RGBA);
+                                  processedImage.format() == QImage::Format_Grayscale8 ? ZXing::ImageFormat::Lum
+                                                                                       : ZXing::ImageFormat::RGBA,
+                                  static_cast<int>(processedImage.bytesPerLine()));
 
         // 设置识别选项
         ZXing::ReaderOptions options = convertConfig(config);
+        ZXing::ReadTimings timings;
+        options.setTimings(&timings);
         
-        // 执行识别
-        auto zxingResults = ZXing::ReadBarcodes(imageView, options);
+        // 执行识别（设置了时间预算时由快到慢逐级升级）
+        auto zxingResults = config.timeoutMs > 0 ? readProgressive(imageView, options, config.timeoutMs)
+                                                 : ZXing::ReadBarcodes(imageView, options);
+        telemetry.addReadTimings(timings);
         
         if (zxingResults.empty()) {
+            telemetry.addTiming("total", totalTimer.nsecsElapsed() / 1000);
+            telemetry.addCall(false);
             m_lastError = "未找到任何条码";
             return results;
         }
@@ -268,7 +432,7 @@ QList<QRCodeRecognizer::RecognitionResult> QRCodeRecognizer::recognizeMultiForma
         for (const auto& barcode : zxingResults) {
             if (barcode.isValid()) {
                 RecognitionResult result;
-                result.text = QString::fromUtf8(barcode.text().c_str());
+                result.text = decodeText(barcode);
                 result.isValid = true;
                 
                 // 获取原始位置并缩放到原图坐标系
@@ -287,18 +451,28 @@ QList<QRCodeRecognizer::RecognitionResult> QRCodeRecognizer::recognizeMultiForma
                 // 构造缩放后的四边形
                 ZXing::QuadrilateralI scaledPosition(topLeft, topRight, bottomRight, bottomLeft);
                 result.position = scaledPosition;
-                result.format = QString::fromStdString(ToString(barcode.format()));
+                result.format = barcode.format();
                 result.confidence = 1.0; // ZXing不直接提供置信度
+                result.orientation = barcode.orientation();
+                result.ecLevel = QString::fromStdString(barcode.ecLevel());
+                result.version = QString::fromStdString(barcode.version());
+                result.isInverted = barcode.isInverted();
+                result.sequenceIndex = barcode.sequenceIndex();
+                result.sequenceSize = barcode.sequenceSize();
+                result.sequenceId = QString::fromStdString(barcode.sequenceId());
                 
                 results.append(result);
+                if (sequenceParts && barcode.isPartOfSequence()) {
+                    sequenceParts->push_back(barcode);
+                }
             }
         }
         
-        // 按流行度排序
-        std::sort(results.begin(), results.end(), [this](const RecognitionResult& a, const RecognitionResult& b) {
+        // 按流行度排序（直接比较格式枚举，比较过程中不分配内存；得分相同的结果保持识别顺序）
+        std::stable_sort(results.begin(), results.end(), [this](const RecognitionResult& a, const RecognitionResult& b) {
             // 首先按流行度得分排序，然后按置信度
-            int scoreA = getFormatPopularityScore(ZXing::BarcodeFormatFromString(a.format.toStdString()));
-            int scoreB = getFormatPopularityScore(ZXing::BarcodeFormatFromString(b.format.toStdString()));
+            int scoreA = getFormatPopularityScore(a.format);
+            int scoreB = getFormatPopularityScore(b.format);
             
             if (scoreA != scoreB) {
                 return scoreA > scoreB; // 得分高的排在前面
@@ -306,10 +480,18 @@ QList<QRCodeRecognizer::RecognitionResult> QRCodeRecognizer::recognizeMultiForma
             return a.confidence > b.confidence; // 置信度高的排在前面
         });
         
+        if (config.adaptiveFormats) {
+            recordFormats(results);
+        }
+
+        telemetry.addTiming("total", totalTimer.nsecsElapsed() / 1000);
+        telemetry.addCall(!results.isEmpty());
+
         m_lastError.clear();
         return results;
     }
     catch (const std::exception& e) {
+        telemetry.addCall(false);
         m_lastError = QString("识别异常: %1").arg(e.what());
         qDebug() << m_lastError;
         return results;
@@ -337,7 +519,7 @@ QStringList QRCodeRecognizer::getSupportedFormats() const
     };
 }
 
-QList<ZXing::BarcodeFormat> QRCodeRecognizer::getFormatsOrderedByPopularity() const
+QList<ZXing::BarcodeFormat> QRCodeRecognizer::getFormatsOrderedByPopularity()
 {
     return {
         ZXing::BarcodeFormat::QRCode,        // 100分 - 最流行
@@ -0,0 +1,194 @@
+#include "core/RecognitionScheduler.h"
+#include "core/FrameSharpness.h"
+#include "core/RecognitionTelemetry.h"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+RecognitionScheduler::RecognitionScheduler(QObject* parent)
+    : QObject(parent)
+    , m_recognizer(new QRCodeRecognizer())
+    , m_timer(new QTimer(this))
+{
+    m_pool.setMaxThreadCount(1);
+
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &RecognitionScheduler::onTimer);
+}
+
+RecognitionScheduler::~RecognitionScheduler()
+{
+    stop();
+    delete m_recognizer;
+}
+
+void RecognitionScheduler::setCpuBudget(double budget)
+{
+    m_cpuBudget = std::clamp(budget, 0.05, 1.0);
+}
+
+void RecognitionScheduler::start()
+{
+    if (m_running) {
+        return;
+    }
+
+    ++m_session;
+    m_running = true;
+    m_busy = false;
+    m_lastSignature = FrameSignature();
+    m_lastResult = QRCodeRecognizer::RecognitionResult();
+    m_lastSharpness = -1.0;
+    m_failedReuses = 0;
+    m_idleMs = 0;
+    m_recognizer->resetAdaptiveFormats();
+
+    emit frameRequested();
+}
+
+void RecognitionScheduler::stop()
+{
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    m_timer->stop();
+    ++m_session;
+    m_pool.waitForDone();
+    m_busy = false;
+}
+
+int RecognitionScheduler::currentIntervalMs() const
+{
+    // 识别占用时间 / (识别时间 + 空闲时间) = 预算
+    int budgetIdle = static_cast<int>(m_latencyMs * (1.0 / m_cpuBudget - 1.0));
+    return std::max(budgetIdle, m_idleMs);
+}
+
+void RecognitionScheduler::submitFrame(const QImage& image)
+{
+    if (!m_running || image.isNull()) {
+        return;
+    }
+
+    if (m_busy || m_timer->isActive()) {
+        // 从不排队：识别或空闲期间到达的帧直接丢弃，空闲结束后重新请求最新的一帧
+        RecognitionTelemetry::instance().addDroppedFrame();
+        return;
+    }
+
+    // 与上一识别帧（无论是否识别成功）相比没有明显变化时，不再识别
+    FrameSignature signature = FrameSignature::fromImage(image);
+    if (signature.difference(m_lastSignature) < STATIC_THRESHOLD && canReuseLastResult(image)) {
+        reuseLastResult();
+        return;
+    }
+
+    dispatch(image, signature);
+}
+
+void RecognitionScheduler::frameUnavailable()
+{
+    if (m_running && !m_busy && !m_timer->isActive()) {
+        m_timer->start(RETRY_MS);
+    }
+}
+
+bool RecognitionScheduler::canReuseLastResult(const QImage& image) const
+{
+    if (m_lastResult.isValid) {
+        return true;
+    }
+
+    // 失败的结果可能来自模糊的帧：模糊与对焦后的清晰帧块亮度几乎相同，签名无法区分
+    if (m_failedReuses >= MAX_FAILED_REUSES) {
+        return false;
+    }
+    return m_lastSharpness < 0 || FrameSharpness::fromImage(image) <= m_lastSharpness * SHARPNESS_GAIN;
+}
+
+void RecognitionScheduler::reuseLastResult()
+{
+    RecognitionTelemetry::instance().addSkippedFrame();
+    if (!m_lastResult.isValid) {
+        ++m_failedReuses;
+    }
+
+    // 静止画面逐步退避，画面变化后由下一次识别恢复
+    backOff();
+
+    if (m_lastResult.isValid) {
+        emit resultReused(m_lastResult);
+    }
+
+    if (m_running) {
+        m_timer->start(currentIntervalMs());
+    }
+}
+
+void RecognitionScheduler::backOff()
+{
+    m_idleMs = std::min(std::max(2 * m_idleMs, RETRY_MS), MAX_IDLE_MS);
+}
+
+void RecognitionScheduler::dispatch(const QImage& image, const FrameSignature& signature)
+{
+    // 签名只在识别时更新，缓慢的累积变化最终也会触发识别
+    m_lastSignature = signature;
+
+    m_busy = true;
+    int session = m_session;
+    QRCodeRecognizer::RecognitionConfig config = m_config;
+    m_pool.start([this, image, session, config]() {
+        QElapsedTimer timer;
+        timer.start();
+        QRCodeRecognizer::RecognitionResult result = m_recognizer->recognizeSync(image, config);
+        // 识别失败时用预筛选判断画面中是否有条码结构（条码正在进入画面、对焦或运动模糊）
+        bool hasCandidates = result.isValid || QRCodeRecognizer::hasCandidateRegions(image);
+        double latencyMs = timer.nsecsElapsed() / 1e6;
+        // 失败帧的清晰度作为基准：静止画面变清晰后重新识别
+        double sharpness = result.isValid ? -1.0 : FrameSharpness::fromImage(image);
+
+        QMetaObject::invokeMethod(this, [this, session, result, hasCandidates, sharpness, latencyMs]() {
+            onDecodeFinished(session, result, hasCandidates, sharpness, latencyMs);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void RecognitionScheduler::onDecodeFinished(int session, const QRCodeRecognizer::RecognitionResult& result,
+                                            bool hasCandidates, double sharpness, double latencyMs)
+{
+    if (session != m_session) {
+        return; // 已停止或重新开始
+    }
+
+    m_busy = false;
+    m_latencyMs = m_latencyMs > 0 ? m_latencyMs + LATENCY_SMOOTHING * (latencyMs - m_latencyMs) : latencyMs;
+
+    m_lastResult = result;
+    m_lastSharpness = sharpness;
+    m_failedReuses = 0;
+
+    // 画面中有条码（或类似条码的结构）时恢复到预算允许的最高频率，否则继续退避：
+    // 画面变化的帧总会被识别，但空场景中的晃动不会让调度器全速运行
+    if (hasCandidates) {
+        m_idleMs = 0;
+    } else {
+        backOff();
+    }
+
+    emit resultReady(result);
+
+    if (m_running) {
+        m_timer->start(currentIntervalMs());
+    }
+}
+
+void RecognitionScheduler::onTimer()
+{
+    if (m_running && !m_busy) {
+        emit frameRequested();
+    }
+}
@@ -0,0 +1,204 @@
+#include "core/RecognitionTelemetry.h"
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+qint64 toMicroseconds(ZXing::ReadTimings::Duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+}
+
+RecognitionTelemetry::RecognitionTelemetry()
+{
+    m_clock.start();
+}
+
+RecognitionTelemetry& RecognitionTelemetry::instance()
+{
+    static RecognitionTelemetry instance;
+    return instance;
+}
+
+void RecognitionTelemetry::append(Samples& samples, qint64 value)
+{
+    if (samples.values.size() < WINDOW_SIZE) {
+        samples.values.append(value);
+    } else {
+        samples.values[samples.next] = value;
+        samples.next = (samples.next + 1) % WINDOW_SIZE;
+    }
+}
+
+void RecognitionTelemetry::addTiming(const QString& stage, qint64 microseconds)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_stages.find(stage);
+    if (it == m_stages.end()) {
+        m_stageOrder.append(stage);
+        it = m_stages.insert(stage, Samples());
+    }
+    append(*it, microseconds);
+}
+
+void RecognitionTelemetry::addReadTimings(const ZXing::ReadTimings& timings)
+{
+    addTiming("lumExtraction", toMicroseconds(timings.lumExtraction));
+    if (timings.prescreen.count() > 0) {
+        addTiming("prescreen", toMicroseconds(timings.prescreen));
+    }
+    addTiming("pyramid", toMicroseconds(timings.pyramid));
+    if (timings.binarize.count() > 0) {
+        addTiming("binarize", toMicroseconds(timings.binarize));
+    }
+    for (const auto& reader : timings.readers) {
+        // 一维读取器负责所有启用的一维格式，统一显示为"1D"
+        bool linear = (reader.formats & ZXing::BarcodeFormat::MatrixCodes).empty();
+        QString name = linear ? QString("1D") : QString::fromStdString(ZXing::ToString(reader.formats));
+        addTiming("reader/" + name, toMicroseconds(reader.time));
+        // 二维码和DataMatrix读取器还记录了各阶段的耗时
+        const auto& stages = reader.stages;
+        if (stages.detect.count() > 0) {
+            addTiming("reader/" + name + "/detect", toMicroseconds(stages.detect));
+            addTiming("reader/" + name + "/sample", toMicroseconds(stages.sample));
+            addTiming("reader/" + name + "/decode", toMicroseconds(stages.decode));
+            addTiming("reader/" + name + "/errorCorrection", toMicroseconds(stages.errorCorrection));
+        }
+    }
+}
+
+void RecognitionTelemetry::addCall(bool success)
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_calls;
+    if (success) {
+        ++m_successes;
+    }
+    append(m_callTimes, m_clock.elapsed());
+}
+
+void RecognitionTelemetry::addDroppedFrame()
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_droppedFrames;
+}
+
+void RecognitionTelemetry::addSkippedFrame()
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_skippedFrames;
+}
+
+RecognitionTelemetry::StageStats RecognitionTelemetry::computeStats(const QString& name, const Samples& samples)
+{
+    StageStats stats;
+    stats.name = name;
+    stats.count = samples.values.size();
+    if (stats.count == 0) {
+        return stats;
+    }
+
+    QVector<qint64> sorted = samples.values;
+    std::sort(sorted.begin(), sorted.end());
+
+    // 最近秩法：第p百分位取排序后第ceil(p*n)个样本
+    auto percentile = [&sorted](double p) {
+        int rank = static_cast<int>(std::ceil(p * sorted.size()));
+        return sorted[std::clamp(rank - 1, 0, static_cast<int>(sorted.size()) - 1)] / 1000.0;
+    };
+
+    qint64 sum = 0;
+    for (qint64 value : sorted) {
+        sum += value;
+    }
+    stats.mean = sum / 1000.0 / stats.count;
+    stats.p50 = percentile(0.50);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    stats.max = sorted.last() / 1000.0;
+    return stats;
+}
+
+RecognitionTelemetry::Snapshot RecognitionTelemetry::snapshot() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    Snapshot snapshot;
+    snapshot.calls = m_calls;
+    snapshot.successes = m_successes;
+    snapshot.droppedFrames = m_droppedFrames;
+    snapshot.skippedFrames = m_skippedFrames;
+
+    // 窗口内最早与最近一次调用之间的平均速率
+    const auto& times = m_callTimes.values;
+    if (times.size() >= 2) {
+        qint64 newest = times[(m_callTimes.next + times.size() - 1) % times.size()];
+        qint64 oldest = times[m_callTimes.next % times.size()];
+        if (newest > oldest) {
+            snapshot.throughput = (times.size() - 1) * 1000.0 / (newest - oldest);
+        }
+    }
+
+    for (const QString& stage : m_stageOrder) {
+        snapshot.stages.append(computeStats(stage, m_stages.value(stage)));
+    }
+    return snapshot;
+}
+
+QJsonObject RecognitionTelemetry::toJson() const
+{
+    Snapshot current = snapshot();
+
+    QJsonArray stages;
+    for (const auto& stage : current.stages) {
+        QJsonObject entry;
+        entry["name"] = stage.name;
+        entry["count"] = stage.count;
+        entry["meanMs"] = stage.mean;
+        entry["p50Ms"] = stage.p50;
+        entry["p95Ms"] = stage.p95;
+        entry["p99Ms"] = stage.p99;
+        entry["maxMs"] = stage.max;
+        stages.append(entry);
+    }
+
+    QJsonObject json;
+    json["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    json["calls"] = current.calls;
+    json["successes"] = current.successes;
+    json["droppedFrames"] = current.droppedFrames;
+    json["skippedFrames"] = current.skippedFrames;
+    json["throughput"] = current.throughput;
+    json["windowSize"] = WINDOW_SIZE;
+    json["stages"] = stages;
+    return json;
+}
+
+bool RecognitionTelemetry::saveJson(const QString& filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented)) >= 0;
+}
+
+void RecognitionTelemetry::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_stageOrder.clear();
+    m_stages.clear();
+    m_callTimes = Samples();
+    m_calls = 0;
+    m_successes = 0;
+    m_droppedFrames = 0;
+    m_skippedFrames = 0;
+}
@@ -0,0 +1,50 @@
+#include "core/RecognizerPool.h"
+
+RecognizerPool::RecognizerPool()
+{
+    for (int i = 0; i < m_pool.maxThreadCount(); ++i) {
+        m_recognizers.append(new QRCodeRecognizer());
+    }
+    m_idleRecognizers = m_recognizers;
+}
+
+RecognizerPool::~RecognizerPool()
+{
+    m_pool.waitForDone();
+    qDeleteAll(m_recognizers);
+}
+
+void RecognizerPool::start(const Task& task)
+{
+    m_pool.start([this, task]() {
+        QRCodeRecognizer* recognizer = acquireRecognizer();
+        task(recognizer);
+        releaseRecognizer(recognizer);
+    });
+}
+
+void RecognizerPool::resetAdaptiveFormats()
+{
+    for (auto* recognizer : m_recognizers) {
+        recognizer->resetAdaptiveFormats();
+    }
+}
+
+QRCodeRecognizer::RecognitionConfig RecognizerPool::workerConfig(const QRCodeRecognizer::RecognitionConfig& config)
+{
+    QRCodeRecognizer::RecognitionConfig worker = config;
+    worker.maxThreads = 1;
+    return worker;
+}
+
+QRCodeRecognizer* RecognizerPool::acquireRecognizer()
+{
+    QMutexLocker locker(&m_recognizerMutex);
+    return m_idleRecognizers.takeLast();
+}
+
+void RecognizerPool::releaseRecognizer(QRCodeRecognizer* recognizer)
+{
+    QMutexLocker locker(&m_recognizerMutex);
+    m_idleRecognizers.append(recognizer);
+}
@@ -0,0 +1,86 @@
+#include "core/ScaledImageLoader.h"
+
+#include <QBuffer>
+#include <QImageReader>
+
+#include <algorithm>
+
+LoadedImage ScaledImageLoader::fromFile(const QString& filePath, int maxDimension, bool grayscale, int page)
+{
+    LoadedImage loaded;
+    loaded.filePath = filePath;
+    loaded.page = page;
+
+    QImageReader reader(filePath);
+    read(reader, maxDimension, grayscale, loaded);
+    return loaded;
+}
+
+LoadedImage ScaledImageLoader::fromData(const QByteArray& data, int maxDimension, bool grayscale)
+{
+    LoadedImage loaded;
+    loaded.data = data;
+
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    read(reader, maxDimension, grayscale, loaded);
+    return loaded;
+}
+
+LoadedImage ScaledImageLoader::reloadFullResolution(const LoadedImage& loaded, bool grayscale)
+{
+    return loaded.filePath.isEmpty() ? fromData(loaded.data, 0, grayscale)
+                                     : fromFile(loaded.filePath, 0, grayscale, loaded.page);
+}
+
+int ScaledImageLoader::pageCount(const QString& filePath)
+{
+    QImageReader reader(filePath);
+    return reader.canRead() ? pageCount(reader) : 0;
+}
+
+int ScaledImageLoader::pageCount(QImageReader& reader)
+{
+    // 单帧格式返回0或1
+    return std::max(1, reader.imageCount());
+}
+
+bool ScaledImageLoader::jumpToPage(QImageReader& reader, int page)
+{
+    if (page <= 0 || reader.jumpToImage(page)) {
+        return true;
+    }
+
+    // 不支持随机访问的格式（如GIF）依次读过前面的帧
+    for (int i = 0; i < page && reader.canRead(); ++i) {
+        reader.read();
+    }
+    return reader.canRead();
+}
+
+void ScaledImageLoader::read(QImageReader& reader, int maxDimension, bool grayscale, LoadedImage& loaded)
+{
+    loaded.pageCount = pageCount(reader);
+    jumpToPage(reader, loaded.page);
+
+    // 只读取文件头即可得到尺寸，在解码前决定目标尺寸
+    QSize size = reader.size();
+    if (maxDimension > 0 && size.isValid() &&
+        (size.width() > maxDimension || size.height() > maxDimension)) {
+        // 支持缩放的格式（如JPEG）在解码时缩小，其他格式由QImageReader解码后缩放
+        reader.setScaledSize(size.scaled(maxDimension, maxDimension, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        loaded.error = reader.errorString();
+        return;
+    }
+
+    loaded.originalSize = size.isValid() ? size : image.size();
+    loaded.image = grayscale && image.format() != QImage::Format_Grayscale8
+                       ? image.convertToFormat(QImage::Format_Grayscale8)
+                       : image;
+}
@@ -0,0 +1,276 @@
+#include "core/TiledRecognizer.h"
+#include "core/RecognitionTelemetry.h"
+#include "core/ScaledImageLoader.h"
+
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QImageReader>
+#include <QMutex>
+#include <QPolygon>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+QRect boundingRect(const ZXing::QuadrilateralI& position)
+{
+    QPolygon polygon;
+    for (const auto& point : position) {
+        polygon << QPoint(point.x, point.y);
+    }
+    return polygon.boundingRect();
+}
+
+/**
+ * @brief 各块在一个方向上的起点：步长为块大小减重叠宽度，最后一块与图像边缘对齐
+ */
+QList<int> tileStarts(int length, int tileSize, int step)
+{
+    QList<int> starts;
+    for (int start = 0;; start += step) {
+        if (start + tileSize >= length) {
+            starts.append(std::max(0, length - tileSize));
+            break;
+        }
+        starts.append(start);
+    }
+    return starts;
+}
+
+} // namespace
+
+TiledRecognizer::TiledRecognizer(const Options& options)
+    : m_options(options)
+{
+}
+
+TiledRecognizer::~TiledRecognizer() = default;
+
+QList<TiledRecognizer::Tile> TiledRecognizer::tileLayout(const QSize& imageSize) const
+{
+    QList<Tile> tiles;
+    if (imageSize.isEmpty()) {
+        return tiles;
+    }
+
+    // 模块大于目标像素数时按比例缩小解码，模块较小时按原始分辨率解码
+    int moduleSize = std::max(1, m_options.moduleSize);
+    double scale = std::min(1.0, static_cast<double>(TARGET_MODULE_PIXELS) / moduleSize);
+
+    // 重叠宽度不小于最大符号的边长；块的解码尺寸与整幅识别的尺寸上限一致
+    int overlap = std::max(1, m_options.maxSymbolModules) * moduleSize;
+    int tileSize = static_cast<int>(QRCodeRecognizer::MAX_DECODE_DIMENSION / scale);
+    tileSize = std::max(tileSize, 2 * overlap);
+    int step = tileSize - overlap;
+
+    for (int y : tileStarts(imageSize.height(), tileSize, step)) {
+        for (int x : tileStarts(imageSize.width(), tileSize, step)) {
+            Tile tile;
+            tile.sourceRect = QRect(x, y, std::min(tileSize, imageSize.width()), std::min(tileSize, imageSize.height()));
+            tile.decodeSize = QSize(std::max(1, static_cast<int>(std::lround(tile.sourceRect.width() * scale))),
+                                    std::max(1, static_cast<int>(std::lround(tile.sourceRect.height() * scale))));
+            tiles.append(tile);
+        }
+    }
+    return tiles;
+}
+
+QList<QRCodeRecognizer::RecognitionResult> TiledRecognizer::recognizeFile(const QString& filePath,
+                                                                          const QRCodeRecognizer::RecognitionConfig& config,
+                                                                          int page)
+{
+    // 探测与各块的读取器都要先定位到同一页
+    QImageReader probe(filePath);
+    if (!ScaledImageLoader::jumpToPage(probe, page)) {
+        m_lastError = QString("无法读取第 %1 页: %2").arg(page + 1).arg(probe.errorString());
+        return {};
+    }
+    return recognizeEncoded(probe, [filePath, page](const Tile& tile) {
+        QImageReader reader(filePath);
+        return ScaledImageLoader::jumpToPage(reader, page) ? readRegion(reader, tile) : QImage();
+    }, config);
+}
+
+QList<QRCodeRecognizer::RecognitionResult> TiledRecognizer::recognizeData(const QByteArray& data,
+                                                                          const QRCodeRecognizer::RecognitionConfig& config)
+{
+    QBuffer probeBuffer;
+    probeBuffer.setData(data);
+    probeBuffer.open(QIODevice::ReadOnly);
+    QImageReader probe(&probeBuffer);
+    return recognizeEncoded(probe, [data](const Tile& tile) {
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+        QImageReader reader(&buffer);
+        return readRegion(reader, tile);
+    }, config);
+}
+
+QList<QRCodeRecognizer::RecognitionResult> TiledRecognizer::recognizeImage(const QImage& image,
+                                                                           const QRCodeRecognizer::RecognitionConfig& config)
+{
+    if (image.isNull()) {
+        m_lastError = "图像无效";
+        return {};
+    }
+
+    QImage source = toTileImage(image);
+    return run(source.size(), [&source](const Tile& tile) {
+        // 块直接引用整幅图像的数据，只有需要缩小时才产生新的图像
+        const QRect& rect = tile.sourceRect;
+        QImage view(source.constBits() + rect.y() * source.bytesPerLine() + rect.x(),
+                    rect.width(), rect.height(), source.bytesPerLine(), QImage::Format_Grayscale8);
+        return view.size() == tile.decodeSize
+                   ? view
+                   : view.scaled(tile.decodeSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }, config);
+}
+
+QList<QRCodeRecognizer::RecognitionResult> TiledRecognizer::recognizeEncoded(QImageReader& probe, const TileReader& readTile,
+                                                                             const QRCodeRecognizer::RecognitionConfig& config)
+{
+    QSize size = probe.size();
+    if (size.isValid() && probe.supportsOption(QImageIOHandler::ClipRect)) {
+        return run(size, readTile, config);
+    }
+
+    if (!size.isValid()) {
+        m_lastError = QString("无法获取图像尺寸: %1").arg(probe.errorString());
+        return {};
+    }
+
+    // 不支持裁剪读取的格式只能整幅解码一次，各块引用同一幅灰度图像。
+    // 分块识别针对的正是超大图像，整幅解码（按每像素4字节估算）超过内存上限时拒绝识别
+    int limitMb = QImageReader::allocationLimit();
+    if (limitMb > 0 && qint64(size.width()) * size.height() * 4 > qint64(limitMb) * 1024 * 1024) {
+        m_lastError = QString("图像过大（%1x%2），该格式不支持分块读取，整幅解码超过%3MB内存上限")
+                          .arg(size.width())
+                          .arg(size.height())
+                          .arg(limitMb);
+        return {};
+    }
+
+    QImage image = probe.read();
+    if (image.isNull()) {
+        m_lastError = QString("无法加载图像: %1").arg(probe.errorString());
+        return {};
+    }
+    image.convertTo(QImage::Format_Grayscale8);
+    return recognizeImage(image, config);
+}
+
+QImage TiledRecognizer::readRegion(QImageReader& reader, const Tile& tile)
+{
+    // 裁剪区域以原图坐标表示，缩放作用于裁剪后的区域
+    reader.setClipRect(tile.sourceRect);
+    if (tile.decodeSize != tile.sourceRect.size()) {
+        reader.setScaledSize(tile.decodeSize);
+    }
+    return toTileImage(reader.read());
+}
+
+QList<QRCodeRecognizer::RecognitionResult> TiledRecognizer::run(const QSize& imageSize, const TileReader& readTile,
+                                                                const QRCodeRecognizer::RecognitionConfig& config)
+{
+    QList<Tile> tiles = tileLayout(imageSize);
+    if (tiles.isEmpty()) {
+        m_lastError = "图像无效";
+        return {};
+    }
+
+    // 块已按识别尺寸解码，识别时不再缩放
+    QRCodeRecognizer::RecognitionConfig tileConfig = RecognizerPool::workerConfig(config);
+    tileConfig.maxDimension = 0;
+
+    auto& telemetry = RecognitionTelemetry::instance();
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    QList<QRCodeRecognizer::RecognitionResult> merged;
+    int failedTiles = 0;
+    QMutex resultMutex;
+
+    for (const Tile& tile : tiles) {
+        m_pool.start([&readTile, &tileConfig, &telemetry, &merged, &failedTiles, &resultMutex, tile](
+                         QRCodeRecognizer* recognizer) {
+            QElapsedTimer readTimer;
+            readTimer.start();
+            QImage image = readTile(tile);
+            telemetry.addTiming("tile_read", readTimer.nsecsElapsed() / 1000);
+
+            if (image.isNull()) {
+                QMutexLocker locker(&resultMutex);
+                ++failedTiles;
+                return;
+            }
+
+            QList<QRCodeRecognizer::RecognitionResult> results = recognizer->recognizeMultiFormat(image, tileConfig);
+
+            // 块坐标 -> 整幅图像坐标
+            const QRect& rect = tile.sourceRect;
+            double scaleX = static_cast<double>(rect.width()) / image.width();
+            double scaleY = static_cast<double>(rect.height()) / image.height();
+            auto toSource = [&rect, scaleX, scaleY](const ZXing::PointI& p) {
+                return ZXing::PointI(rect.x() + static_cast<int>(p.x * scaleX), rect.y() + static_cast<int>(p.y * scaleY));
+            };
+
+            QMutexLocker locker(&resultMutex);
+            for (auto result : results) {
+                const auto& pos = result.position;
+                result.position = ZXing::QuadrilateralI(toSource(pos.topLeft()), toSource(pos.topRight()),
+                                                        toSource(pos.bottomRight()), toSource(pos.bottomLeft()));
+                mergeResult(merged, result);
+            }
+        });
+    }
+    m_pool.waitForDone();
+    telemetry.addTiming("tiled_total", totalTimer.nsecsElapsed() / 1000);
+
+    // 各块完成的顺序不确定，按位置（自上而下、自左而右）排列结果
+    std::sort(merged.begin(), merged.end(), [](const QRCodeRecognizer::RecognitionResult& a,
+                                               const QRCodeRecognizer::RecognitionResult& b) {
+        QRect ra = boundingRect(a.position);
+        QRect rb = boundingRect(b.position);
+        return ra.top() != rb.top() ? ra.top() < rb.top() : ra.left() < rb.left();
+    });
+
+    if (failedTiles == tiles.size()) {
+        m_lastError = "无法读取图像分块";
+    } else if (merged.isEmpty()) {
+        m_lastError = "未找到任何条码";
+    } else {
+        m_lastError.clear();
+    }
+    return merged;
+}
+
+QImage TiledRecognizer::toTileImage(const QImage& image)
+{
+    // 识别只需要亮度，块以灰度保存，每像素一个字节
+    return image.isNull() || image.format() == QImage::Format_Grayscale8
+               ? image
+               : image.convertToFormat(QImage::Format_Grayscale8);
+}
+
+void TiledRecognizer::mergeResult(QList<QRCodeRecognizer::RecognitionResult>& merged,
+                                  const QRCodeRecognizer::RecognitionResult& result)
+{
+    // 重叠区域内的符号会被相邻的块各识别一次：内容相同且位置相交的视为同一符号，保留轮廓较完整（较大）的一个。
+    // 内容相同但位置不相交的是不同的符号（如托盘墙上重复的标签），各自保留
+    QRect box = boundingRect(result.position);
+    for (auto& existing : merged) {
+        if (existing.format != result.format || existing.text != result.text) {
+            continue;
+        }
+        QRect existingBox = boundingRect(existing.position);
+        if (existingBox.intersects(box)) {
+            if (box.width() * box.height() > existingBox.width() * existingBox.height()) {
+                existing = result;
+            }
+            return;
+        }
+    }
+    merged.append(result);
+}
@@ -0,0 +1,264 @@
+#include "core/VideoFileScanner.h"
+
+#include <QFile>
+#include <QMediaPlayer>
+#include <QStringConverter>
+#include <QTextStream>
+#include <QTime>
+#include <QUrl>
+#include <QVideoFrame>
+#include <QVideoSink>
+
+#include <algorithm>
+
+VideoFileScanner::VideoFileScanner(QObject* parent)
+    : QObject(parent)
+    , m_player(new QMediaPlayer(this))
+    , m_videoSink(new QVideoSink(this))
+{
+    m_preparePool.setMaxThreadCount(1);
+    m_player->setVideoOutput(m_videoSink);
+
+    connect(m_videoSink, &QVideoSink::videoFrameChanged, this, &VideoFileScanner::onVideoFrameChanged);
+
+    connect(m_player, &QMediaPlayer::mediaStatusChanged, this,
+            [this](QMediaPlayer::MediaStatus status) {
+                if (m_running && (status == QMediaPlayer::EndOfMedia || status == QMediaPlayer::InvalidMedia)) {
+                    m_inputFinished = true;
+                    checkFinished();
+                }
+            });
+
+    connect(m_player, &QMediaPlayer::errorOccurred, this,
+            [this](QMediaPlayer::Error error, const QString& errorString) {
+                Q_UNUSED(error)
+                if (m_running) {
+                    emit errorOccurred(QString("视频解码失败: %1").arg(errorString));
+                    m_inputFinished = true;
+                    checkFinished();
+                }
+            });
+}
+
+VideoFileScanner::~VideoFileScanner()
+{
+    stop();
+}
+
+bool VideoFileScanner::start(const QString& filePath, const QRCodeRecognizer::RecognitionConfig& config)
+{
+    if (m_running) {
+        return false;
+    }
+
+    ++m_session;
+    m_config = RecognizerPool::workerConfig(config);
+    m_lastSubmitted = FrameSignature();
+    m_detections.clear();
+    m_detectionIndex.clear();
+    m_statistics = Statistics();
+    m_inFlight = 0;
+    m_lastFrameEndUs = -1;
+    m_inputFinished = false;
+    m_throttled = false;
+    m_running = true;
+    m_elapsed.start();
+
+    m_pool.resetAdaptiveFormats();
+
+    // 不设置音频输出，播放器只解码视频
+    m_player->setSource(QUrl::fromLocalFile(filePath));
+    m_player->setPlaybackRate(PLAYBACK_RATE);
+    m_player->play();
+    return true;
+}
+
+void VideoFileScanner::stop()
+{
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    m_player->stop();
+
+    // 丢弃排队的帧并等待正在处理的帧完成，其结果因会话号变化而被忽略
+    m_preparePool.clear();
+    m_preparePool.waitForDone();
+    m_pool.clear();
+    m_pool.waitForDone();
+    ++m_session;
+    m_inFlight = 0;
+    m_statistics.elapsedMs = m_elapsed.elapsed();
+}
+
+VideoFileScanner::Statistics VideoFileScanner::statistics() const
+{
+    Statistics statistics = m_statistics;
+    statistics.durationMs = m_player->duration();
+    if (m_running) {
+        statistics.elapsedMs = m_elapsed.elapsed();
+    }
+    return statistics;
+}
+
+void VideoFileScanner::onVideoFrameChanged(const QVideoFrame& frame)
+{
+    if (!m_running || !frame.isValid()) {
+        return;
+    }
+
+    ++m_statistics.framesReceived;
+    countDroppedFrames(frame);
+
+    // 帧时间戳为微秒，无效时使用播放位置
+    qint64 timestampMs = frame.startTime() >= 0 ? frame.startTime() / 1000 : m_player->position();
+
+    // 格式转换和签名不在GUI线程中计算；单线程按到达顺序处理，结果也按帧序返回
+    ++m_inFlight;
+    updateThrottle();
+
+    int session = m_session;
+    m_preparePool.start([this, frame, session, timestampMs]() {
+        QImage image = frame.toImage();
+        FrameSignature signature = FrameSignature::fromImage(image);
+
+        QMetaObject::invokeMethod(this, [this, session, image, signature, timestampMs]() {
+            onFramePrepared(session, image, signature, timestampMs);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void VideoFileScanner::countDroppedFrames(const QVideoFrame& frame)
+{
+    // 相邻帧的时间戳间隔超过一帧时长时，中间的帧被后端跳过
+    qint64 startUs = frame.startTime();
+    qint64 endUs = frame.endTime();
+    if (startUs >= 0 && endUs > startUs && m_lastFrameEndUs >= 0 && startUs > m_lastFrameEndUs) {
+        qint64 frameUs = endUs - startUs;
+        m_statistics.framesDropped += (startUs - m_lastFrameEndUs + frameUs / 2) / frameUs;
+    }
+    if (endUs > startUs) {
+        m_lastFrameEndUs = endUs;
+    }
+}
+
+void VideoFileScanner::onFramePrepared(int session, const QImage& image, const FrameSignature& signature,
+                                       qint64 timestampMs)
+{
+    if (session != m_session) {
+        return; // 已停止或重新开始的扫描
+    }
+
+    if (image.isNull()) {
+        frameDone();
+        return;
+    }
+
+    // 与上一送检帧几乎相同（静止的传送带、重复帧）时跳过
+    if (m_skipThreshold > 0 && signature.difference(m_lastSubmitted) < m_skipThreshold) {
+        ++m_statistics.framesSkipped;
+        frameDone();
+        return;
+    }
+    m_lastSubmitted = signature;
+
+    submitFrame(image, timestampMs);
+}
+
+void VideoFileScanner::submitFrame(const QImage& image, qint64 timestampMs)
+{
+    ++m_statistics.framesDecoded;
+
+    int session = m_session;
+    QRCodeRecognizer::RecognitionConfig config = m_config;
+    m_pool.start([this, image, timestampMs, session, config](QRCodeRecognizer* recognizer) {
+        QList<QRCodeRecognizer::RecognitionResult> results = recognizer->recognizeMultiFormat(image, config);
+
+        QMetaObject::invokeMethod(this, [this, session, timestampMs, results]() {
+            handleResults(session, timestampMs, results);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void VideoFileScanner::handleResults(int session, qint64 timestampMs, const QList<QRCodeRecognizer::RecognitionResult>& results)
+{
+    if (session != m_session) {
+        return; // 已停止或重新开始的扫描
+    }
+
+    m_statistics.positionMs = std::max(m_statistics.positionMs, timestampMs);
+
+    for (const auto& result : results) {
+        QString key = result.formatName() + '\n' + result.text;
+        QList<int>& indexes = m_detectionIndex[key];
+
+        // 结果可能乱序到达，因此按时间窗口两侧匹配已有记录
+        int match = -1;
+        for (int index : indexes) {
+            const Detection& detection = m_detections[index];
+            if (timestampMs >= detection.firstSeenMs - m_dedupWindowMs &&
+                timestampMs <= detection.lastSeenMs + m_dedupWindowMs) {
+                match = index;
+                break;
+            }
+        }
+
+        if (match < 0) {
+            Detection detection;
+            detection.result = result;
+            detection.firstSeenMs = timestampMs;
+            detection.lastSeenMs = timestampMs;
+            detection.hits = 1;
+            m_detections.append(detection);
+            indexes.append(m_detections.size() - 1);
+            emit detectionAdded(m_detections.size() - 1);
+        } else {
+            Detection& detection = m_detections[match];
+            detection.firstSeenMs = std::min(detection.firstSeenMs, timestampMs);
+            detection.lastSeenMs = std::max(detection.lastSeenMs, timestampMs);
+            ++detection.hits;
+            emit detectionUpdated(match);
+        }
+    }
+
+    frameDone();
+}
+
+void VideoFileScanner::frameDone()
+{
+    --m_inFlight;
+    updateThrottle();
+    checkFinished();
+}
+
+void VideoFileScanner::updateThrottle()
+{
+    if (!m_running || m_inputFinished) {
+        return;
+    }
+
+    // 每个线程最多积压两帧；积压减半后继续播放
+    int threads = m_pool.maxThreadCount();
+    if (!m_throttled && m_inFlight >= 2 * threads) {
+        m_throttled = true;
+        m_player->pause();
+    } else if (m_throttled && m_inFlight <= threads) {
+        m_throttled = false;
+        m_player->play();
+    }
+}
+
+void VideoFileScanner::checkFinished()
+{
+    if (!m_running || !m_inputFinished || m_inFlight > 0) {
+        return;
+    }
+
+    m_running = false;
+    m_statistics.elapsedMs = m_elapsed.elapsed();
+    m_statistics.durationMs = m_player->duration();
+    m_player->stop();
+
+    emit finished(m_statistics);
+}
@@ -1,6 +1,11 @@
 #include "gui/CameraWidget.h"
+#include "gui/DetectionOverlay.h"
 #include "utils/AppUtils.h"
 #include "utils/AppSettings.h"
+#include "core/DetectionHistoryModel.h"
+#include "core/FrameSharpness.h"
+#include "core/RecognitionScheduler.h"
+#include "core/RecognitionTelemetry.h"
 #include <QApplication>
 #include <QAudioOutput>
 #include <QCameraDevice>
@@ -12,29 +17,26 @@
 #include <QFileInfo>
 #include <QMediaDevices>
 #include <QMessageBox>
-#include <QPainter>
 #include <QPalette>
-#include <QPixmap>
+#include <QScrollBar>
+#include <QSignalBlocker>
 #include <QStringConverter>
 #include <QTextStream>
 
 CameraWidget::CameraWidget(QWidget* parent)
     : BaseWidget(parent), m_recognizer(new QRCodeRecognizer(this)), m_camera(nullptr),
-      m_captureSession(new QMediaCaptureSession(this)), m_videoWidget(new QVideoWidget(this)),
-      m_imageCapture(new QImageCapture(this)), m_videoSink(new QVideoSink(this)),
-      m_overlayLabel(new QLabel(m_videoWidget)), m_recognitionTimer(new QTimer(this)),
-      m_overlayTimer(new QTimer(this)), m_cameraActive(false), m_realtimeRecognition(true),
+      m_captureSession(nullptr), m_videoWidget(new QVideoWidget(this)),
+      m_imageCapture(nullptr), m_videoSink(nullptr),
+      m_overlay(new DetectionOverlay(m_videoWidget, true)), m_historyModel(new DetectionHistoryModel(this)),
+      m_scheduler(new RecognitionScheduler(this)),
+      m_overlayTimer(new QTimer(this)),
+      m_cameraActive(false), m_realtimeRecognition(true),
       m_detectionCount(0), m_lastImageSize(1280, 720) // 默认图像尺寸
 {
+    m_sharpnessPool.setMaxThreadCount(1);
+
+    // 摄像头后端与设备枚举较慢，推迟到控件首次显示之后（见showEvent）
     setupUI();
-    setupCamera();
-    //     1.先设置windowFlag，setWindowFlags(Qt::FramelessWindowHint | Qt::Tool | Qt::SubWindow);
-    // 设置叠加层
-    m_overlayLabel->setWindowFlags(Qt::FramelessWindowHint | Qt::Tool | Qt::SubWindow);
-    m_overlayLabel->setAttribute(Qt::WA_TransparentForMouseEvents, true);
-    m_overlayLabel->setAttribute(Qt::WA_TranslucentBackground, true);
-    m_overlayLabel->setAutoFillBackground(false);
-    m_overlayLabel->hide(); // 默认隐藏
 
     // 连接识别器信号 - 修复参数不匹配问题
     connect(m_recognizer, &QRCodeRecognizer::recognitionCompleted, this,
@@ -43,29 +45,7 @@ CameraWidget::CameraWidget(QWidget* parent)
                 Q_UNUSED(requestId) // 忽略请求ID
                 onRecognitionResult(result);
             });
-    QTimer* cout = new QTimer(this);
-    cout->setInterval(1000);
-    cout->callOnTimeout(
-        [this]()
-        {
-            // 获取CameraWidget的全局位置
-            QPoint cameraGlobalPos = this->mapToGlobal(QPoint(0, 0));
-            // 获取视频控件的全局位置
-            QPoint videoGlobalPos = m_videoWidget->mapToGlobal(QPoint(0, 0));
-            // 获取叠加层的全局位置
-            QPoint overlayGlobalPos = m_overlayLabel->mapToGlobal(QPoint(0, 0));
-
-            // 设置叠加层全局位置与视频控件一致
-            m_overlayLabel->move(videoGlobalPos);
-            m_overlayLabel->resize(m_videoWidget->size());
-
-            qDebug() << "Camera global pos:" << cameraGlobalPos.x() << cameraGlobalPos.y()
-                     << "Video global pos:" << videoGlobalPos.x() << videoGlobalPos.y()
-                     << "Overlay global pos:" << overlayGlobalPos.x() << overlayGlobalPos.y()
-                     << "Overlay local pos:" << m_overlayLabel->x() << m_overlayLabel->y()
-                     << "Overlay adjusted to video position";
-        });
-    cout->start(); // 启动定时器
+
     // 连接识别失败信号用于调试
     connect(m_recognizer, &QRCodeRecognizer::recognitionFailed, this,
             [this](const QString& error, int requestId)
@@ -79,39 +59,26 @@ CameraWidget::CameraWidget(QWidget* parent)
                 }
             });
 
-    // 连接定时器信号
-    connect(m_recognitionTimer, &QTimer::timeout, this, &CameraWidget::onRecognitionTimer);
-
-    // 添加捕获会话状态监控
-    connect(m_captureSession, &QMediaCaptureSession::videoOutputChanged, this,
-            []() { qDebug() << "Video output changed"; });
-
-    // 添加权限检查（Windows可能需要）
-    qDebug() << "Checking camera permissions...";
-    auto devices = QMediaDevices::videoInputs();
-    if (!devices.isEmpty())
-    {
-        qDebug() << "Camera devices available:" << devices.size();
-    }
-    else
-    {
-        qDebug() << "No camera devices found - may need permissions";
-    }
-
-    // 设置识别定时器
-    m_recognitionTimer->setSingleShot(false);
-    m_recognitionTimer->setInterval(500); // 默认500ms识别一次，与滑块初始值同步
+    // 实时识别由调度器按识别耗时和CPU预算驱动：调度器空闲时请求一帧，识别完成后返回结果
+    QRCodeRecognizer::RecognitionConfig config;
+    config.tryHarder = false; // 实时识别使用快速模式
+    config.tryRotate = true;
+    config.fastMode = true;
+    config.maxSymbols = 1;
+    config.prescreen = true; // 大多数帧不含条码，先快速预筛选
+    config.adaptiveFormats = true; // 只扫描本会话实际出现的码制，定期完整扫描
+    m_scheduler->setConfig(config);
+    m_scheduler->setCpuBudget(m_cpuBudgetSlider->value() / 10.0);
+    connect(m_scheduler, &RecognitionScheduler::frameRequested, this, &CameraWidget::onFrameRequested);
+    connect(m_scheduler, &RecognitionScheduler::resultReady, this, &CameraWidget::onRecognitionResult);
+    connect(m_scheduler, &RecognitionScheduler::resultReused, this, &CameraWidget::onRecognitionResultReused);
 
     // 设置叠加层计时器
     m_overlayTimer->setSingleShot(true); // 单次触发
     connect(m_overlayTimer, &QTimer::timeout, this,
             [this]()
             {
-                if (m_overlayLabel)
-                {
-                    m_overlayLabel->hide();
-                    qDebug() << "Overlay hidden by timer";
-                }
+                m_overlay->clear();
             });
 
     qDebug() << "CameraWidget initialized";
@@ -120,10 +87,14 @@ CameraWidget::CameraWidget(QWidget* parent)
 CameraWidget::~CameraWidget()
 {
     stopCamera();
+    m_sharpnessPool.waitForDone();
 }
 
 void CameraWidget::startCamera()
 {
+    // 用户在延迟初始化完成前点击启动时，立即完成初始化
+    ensureCameraSetup();
+
     if (!m_camera)
     {
         emit cameraError("未找到可用的摄像头设备");
@@ -153,6 +124,9 @@ void CameraWidget::startCamera()
         qDebug() << "Camera active before start:" << m_camera->isActive();
         qDebug() << "Camera error:" << m_camera->error();
 
+        // 每次开始扫描都是新的会话，重新学习实际出现的码制
+        m_recognizer->resetAdaptiveFormats();
+
         // 启动摄像头
         m_camera->start();
         m_cameraActive = true;
@@ -163,11 +137,11 @@ void CameraWidget::startCamera()
         qDebug() << "Camera started successfully";
         qDebug() << "Camera active after start:" << m_camera->isActive();
 
-        // 启动实时识别定时器（如果启用）
+        // 启动实时识别调度（如果启用）
         if (m_realtimeRecognitionCheckBox->isChecked())
         {
-            m_recognitionTimer->start();
-            qDebug() << "Recognition timer started";
+            m_scheduler->start();
+            qDebug() << "Recognition scheduler started";
         }
 
         // 强制更新视频widget
@@ -192,7 +166,8 @@ void CameraWidget::stopCamera()
         m_camera->stop();
     }
 
-    m_recognitionTimer->stop();
+    m_scheduler->stop();
+    m_bestFrame = QVideoFrame();
     m_cameraActive = false;
     m_cameraToggleButton->setText("启动摄像头");
     m_captureButton->setEnabled(false);
@@ -213,7 +188,7 @@ void CameraWidget::onRecognitionResult(const QRCodeRecognizer::RecognitionResult
 
     if (result.isValid)
     {
-        qDebug() << "QR Code detected! Text:" << result.text << "Format:" << result.format;
+        qDebug() << "QR Code detected! Text:" << result.text << "Format:" << result.formatName();
 
         // 避免重复检测相同内容
         QDateTime now = QDateTime::currentDateTime();
@@ -230,9 +205,6 @@ void CameraWidget::onRecognitionResult(const QRCodeRecognizer::RecognitionResult
 
         if (m_showOverlayCheckBox->isChecked())
         {
-            // 先隐藏之前的叠加层，再绘制新的
-            m_overlayTimer->stop();
-            m_overlayLabel->hide();
             drawDetectionOverlay(result);
         }
 
@@ -259,6 +231,20 @@ void CameraWidget::onRecognitionResult(const QRCodeRecognizer::RecognitionResult
     }
 }
 
+void CameraWidget::onRecognitionResultReused(const QRCodeRecognizer::RecognitionResult& result)
+{
+    // 画面未变化，条码仍在视野中：视为同一次检测的延续，不再记录历史
+    if (result.text == m_lastDetectedText)
+    {
+        m_lastDetectionTime = QDateTime::currentDateTime();
+    }
+
+    if (m_overlay->hasResults())
+    {
+        m_overlayTimer->start(overlayTimeoutMs());
+    }
+}
+
 void CameraWidget::onCameraToggleClicked()
 {
     if (m_cameraActive)
@@ -289,6 +275,15 @@ void CameraWidget::onCaptureClicked()
         return;
     }
 
+    // 最近窗口内有清晰的预览帧时直接识别，避免对焦中或晃动时捕获到模糊画面
+    QImage bestFrame = takeBestFrame();
+    if (!bestFrame.isNull())
+    {
+        qDebug() << "Using sharpest recent frame for manual recognition, sharpness:" << m_bestSharpness;
+        recognizeManualCapture(bestFrame);
+        return;
+    }
+
     if (!m_imageCapture || !m_imageCapture->isReadyForCapture())
     {
         QMessageBox::warning(this, "警告", "图像捕获设备未准备就绪！\n请稍后再试。");
@@ -317,25 +312,7 @@ void CameraWidget::onCaptureClicked()
 
                     if (!image.isNull())
                     {
-                        QRCodeRecognizer::RecognitionConfig config;
-                        config.tryHarder = true; // 手动捕获时使用更高精度
-                        config.tryRotate = true;
-                        config.fastMode = false;
-
-                        qDebug() << "Starting manual synchronous recognition...";
-                        auto result = m_recognizer->recognizeSync(image, config);
-                        qDebug() << "Manual recognition result - valid:" << result.isValid;
-
-                        if (result.isValid)
-                        {
-                            qDebug() << "Manual recognition successful:" << result.text;
-                            onRecognitionResult(result);
-                        }
-                        else
-                        {
-                            qDebug() << "Manual recognition failed";
-                            QMessageBox::information(this, "结果", "当前画面中未检测到二维码");
-                        }
+                        recognizeManualCapture(image);
                     }
                     else
                     {
@@ -352,17 +329,40 @@ void CameraWidget::onCaptureClicked()
     m_imageCapture->capture();
 }
 
+void CameraWidget::recognizeManualCapture(const QImage& image)
+{
+    QRCodeRecognizer::RecognitionConfig config;
+    config.tryHarder = true; // 手动捕获时使用更高精度
+    config.tryRotate = true;
+    config.fastMode = false;
+    config.timeoutMs = AppSettings::instance().getRecognitionTimeout();
+
+    qDebug() << "Starting manual synchronous recognition...";
+    auto result = m_recognizer->recognizeSync(image, config);
+    qDebug() << "Manual recognition result - valid:" << result.isValid;
+
+    if (result.isValid)
+    {
+        qDebug() << "Manual recognition successful:" << result.text;
+        onRecognitionResult(result);
+    }
+    else
+    {
+        qDebug() << "Manual recognition failed";
+        QMessageBox::information(this, "结果", "当前画面中未检测到二维码");
+    }
+}
+
 void CameraWidget::onClearHistoryClicked()
 {
-    m_historyTextEdit->clear();
-    m_detectionHistory.clear();
+    m_historyModel->clear();
     m_detectionCount = 0;
     m_detectionCountLabel->setText("检测次数: 0");
 }
 
 void CameraWidget::onSaveHistoryClicked()
 {
-    if (m_detectionHistory.isEmpty())
+    if (m_historyModel->isEmpty())
     {
         QMessageBox::warning(this, "警告", "没有检测历史可保存！");
         return;
@@ -385,15 +385,12 @@ void CameraWidget::onSaveHistoryClicked()
             out << "摄像头二维码检测历史\n";
             out << "生成时间: " << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")
                 << "\n";
-            out << "检测总数: " << m_detectionHistory.size() << "\n\n";
+            out << "检测总数: " << m_historyModel->rowCount() << "\n\n";
 
-            for (int i = 0; i < m_detectionHistory.size(); ++i)
+            // 逐条写出，已写入临时文件的旧记录按顺序读回
+            if (!m_historyModel->exportText(out))
             {
-                const auto& result = m_detectionHistory[i];
-                out << "=== 检测 " << (i + 1) << " ===\n";
-                out << "内容: " << result.text << "\n";
-                out << "格式: " << result.format << "\n";
-                out << "置信度: " << QString::number(result.confidence, 'f', 2) << "\n\n";
+                QMessageBox::warning(this, "保存失败", QString("写入文件失败: %1").arg(fileName));
             }
         }
     }
@@ -401,6 +398,11 @@ void CameraWidget::onSaveHistoryClicked()
 
 void CameraWidget::onCameraDeviceChanged()
 {
+    if (!m_captureSession)
+    {
+        return; // 摄像头尚未初始化
+    }
+
     int index = m_deviceCombo->currentIndex();
     if (index >= 0)
     {
@@ -455,16 +457,17 @@ void CameraWidget::onRecognitionSettingsChanged()
 {
     m_realtimeRecognition = m_realtimeRecognitionCheckBox->isChecked();
 
+    int budgetPercent = m_cpuBudgetSlider->value() * 10;
+    m_scheduler->setCpuBudget(budgetPercent / 100.0);
+    m_cpuBudgetLabel->setText(QString("%1%").arg(budgetPercent));
+
     if (m_realtimeRecognition && m_cameraActive)
     {
-        int interval = m_recognitionIntervalSlider->value() * 100; // 转换为毫秒
-        m_recognitionTimer->setInterval(interval);
-        m_recognitionTimer->start();
-        m_intervalLabel->setText(QString("%1ms").arg(interval));
+        m_scheduler->start();
     }
     else
     {
-        m_recognitionTimer->stop();
+        m_scheduler->stop();
     }
 }
 
@@ -487,45 +490,82 @@ void CameraWidget::onVideoFrameChanged(const QVideoFrame& frame)
         qDebug() << "First valid frame received!"
                  << "Format:" << frame.pixelFormat() << "Size:" << frame.size();
     }
+
+    if (!m_cameraActive)
+    {
+        return;
+    }
+
+    // 映射和评分在工作线程中进行，上一帧尚未评完时跳过本帧，评分不会积压也不占用GUI线程
+    if (m_scoring)
+    {
+        return;
+    }
+
+    m_scoring = true;
+    m_sharpnessPool.start([this, frame]() {
+        double sharpness = FrameSharpness::fromVideoFrame(frame);
+        QMetaObject::invokeMethod(this, [this, frame, sharpness]() {
+            onFrameScored(frame, sharpness);
+        }, Qt::QueuedConnection);
+    });
 }
 
-void CameraWidget::onRecognitionTimer()
+void CameraWidget::onFrameScored(const QVideoFrame& frame, double sharpness)
 {
-    // 在新的方法中，我们不依赖videoFrame，而是主动捕获图像
-    if (m_cameraActive && m_realtimeRecognition && m_imageCapture)
+    m_scoring = false;
+
+    // 只保留短窗口内最清晰的一帧，等到需要识别时再转换为图像
+    if (!m_cameraActive || sharpness < 0)
     {
-        static int timerCount = 0;
-        timerCount++;
-        if (timerCount % 10 == 0)
-        { // 每10次打印一次
-            qDebug() << "Recognition timer triggered:" << timerCount
-                     << "Camera active:" << m_cameraActive
-                     << "Realtime enabled:" << m_realtimeRecognition;
-        }
+        return; // 格式不支持时识别退回到图像捕获
+    }
 
-        // 主动捕获图像进行识别
-        if (m_imageCapture->isReadyForCapture())
-        {
-            m_imageCapture->capture();
-        }
-        else
+    if (!m_bestFrame.isValid() || m_bestFrameTimer.elapsed() > SHARPNESS_WINDOW_MS ||
+        sharpness >= m_bestSharpness)
+    {
+        m_bestFrame = frame;
+        m_bestSharpness = sharpness;
+        m_bestFrameTimer.start();
+    }
+}
+
+QImage CameraWidget::takeBestFrame()
+{
+    QImage image;
+    if (m_bestFrame.isValid() && m_bestFrameTimer.elapsed() <= SHARPNESS_WINDOW_MS)
+    {
+        image = m_bestFrame.toImage();
+    }
+
+    // 每个窗口的最佳帧只使用一次，下一次识别从之后到达的帧中重新挑选
+    m_bestFrame = QVideoFrame();
+    return image;
+}
+
+void CameraWidget::onFrameRequested()
+{
+    if (m_cameraActive && m_realtimeRecognition)
+    {
+        // 优先使用最近窗口内最清晰的预览帧，模糊的帧不会送去识别
+        QImage bestFrame = takeBestFrame();
+        if (!bestFrame.isNull())
         {
-            if (timerCount % 20 == 0)
-            {
-                qDebug() << "Image capture not ready";
-            }
+            processVideoImage(bestFrame);
+            return;
         }
     }
+
+    // 没有可用的预览帧时，调度器空闲时才采集，采集到的帧总是最新画面
+    if (m_cameraActive && m_realtimeRecognition && m_imageCapture && m_imageCapture->isReadyForCapture())
+    {
+        m_imageCapture->capture();
+    }
     else
     {
-        static int skipCount = 0;
-        skipCount++;
-        if (skipCount % 20 == 0)
-        { // 每20次跳过打印一次
-            qDebug() << "Skipping recognition - Camera active:" << m_cameraActive
-                     << "Realtime enabled:" << m_realtimeRecognition
-                     << "ImageCapture available:" << (m_imageCapture != nullptr);
-        }
+        // 采集未就绪，本次识别周期的帧被丢弃，稍后重新请求
+        RecognitionTelemetry::instance().addDroppedFrame();
+        m_scheduler->frameUnavailable();
     }
 }
 
@@ -568,14 +608,6 @@ void CameraWidget::setupUI()
 
     cameraLayout->addWidget(m_videoWidget);
 
-    // 设置叠加层位置与视频控件重叠
-    m_overlayLabel->setParent(m_videoWidget);
-    m_overlayLabel->resize(m_videoWidget->size());
-    m_overlayLabel->move(0, 0);
-    m_overlayLabel->raise(); // 确保叠加层在最上面
-    m_overlayLabel->setAlignment(Qt::AlignTop | Qt::AlignLeft);
-    m_overlayLabel->setScaledContents(false);
-
     // 摄像头状态和控制
     m_cameraStatusLabel = createLabel("摄像头未启动");
     // 根据主题设置状态标签颜色
@@ -629,17 +661,18 @@ void CameraWidget::setupUI()
     m_autoSaveCheckBox->setChecked(true);
     recognitionLayout->addWidget(m_autoSaveCheckBox);
 
-    // 识别间隔设置
-    QHBoxLayout* intervalLayout = createHBoxLayout(nullptr, 0);
-    intervalLayout->addWidget(createLabel("识别间隔:"));
-    m_recognitionIntervalSlider = new QSlider(Qt::Horizontal);
-    m_recognitionIntervalSlider->setRange(1, 20); // 100ms - 2000ms
-    m_recognitionIntervalSlider->setValue(5);     // 默认500ms
-    intervalLayout->addWidget(m_recognitionIntervalSlider);
-    m_intervalLabel = createLabel("500ms");
-    m_intervalLabel->setMinimumWidth(50);
-    intervalLayout->addWidget(m_intervalLabel);
-    recognitionLayout->addLayout(intervalLayout);
+    // CPU预算设置：实时识别占用单个核心时间的比例，识别频率由实测耗时自动决定
+    QHBoxLayout* budgetLayout = createHBoxLayout(nullptr, 0);
+    budgetLayout->addWidget(createLabel("CPU预算:"));
+    m_cpuBudgetSlider = new QSlider(Qt::Horizontal);
+    m_cpuBudgetSlider->setRange(1, 10); // 10% - 100%
+    m_cpuBudgetSlider->setValue(3);     // 默认30%
+    m_cpuBudgetSlider->setToolTip("实时识别最多占用一个CPU核心的比例；画面静止时会自动降低识别频率");
+    budgetLayout->addWidget(m_cpuBudgetSlider);
+    m_cpuBudgetLabel = createLabel("30%");
+    m_cpuBudgetLabel->setMinimumWidth(50);
+    budgetLayout->addWidget(m_cpuBudgetLabel);
+    recognitionLayout->addLayout(budgetLayout);
 
     rightLayout->addWidget(m_recognitionGroup);
 
@@ -653,11 +686,15 @@ void CameraWidget::setupUI()
     m_detectionCountLabel->setStyleSheet(QString("font-weight: bold; color: %1;").arg(countColor));
     resultsLayout->addWidget(m_detectionCountLabel);
 
-    m_historyTextEdit = new QTextEdit();
-    m_historyTextEdit->setMaximumHeight(200);
-    m_historyTextEdit->setReadOnly(true);
-    m_historyTextEdit->setPlaceholderText("检测到的二维码将显示在这里...");
-    resultsLayout->addWidget(m_historyTextEdit);
+    // 列表视图只绘制可见行，长时间扫描积累大量记录也不会变慢
+    m_historyView = new QListView();
+    m_historyView->setModel(m_historyModel);
+    m_historyView->setMaximumHeight(200);
+    m_historyView->setUniformItemSizes(true);
+    m_historyView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_historyView->setTextElideMode(Qt::ElideRight);
+    m_historyView->setToolTip("检测到的二维码将显示在这里，悬停查看完整内容");
+    resultsLayout->addWidget(m_historyView);
 
     QHBoxLayout* historyButtonLayout = createHBoxLayout(nullptr, 0);
     m_clearHistoryButton = createButton("清空历史");
@@ -686,14 +723,31 @@ void CameraWidget::setupUI()
             &CameraWidget::onResolutionChanged);
     connect(m_realtimeRecognitionCheckBox, &QCheckBox::toggled, this,
             &CameraWidget::onRecognitionSettingsChanged);
-    connect(m_recognitionIntervalSlider, &QSlider::valueChanged, this,
+    connect(m_cpuBudgetSlider, &QSlider::valueChanged, this,
             &CameraWidget::onRecognitionSettingsChanged);
 }
 
+void CameraWidget::ensureCameraSetup()
+{
+    if (!m_captureSession)
+    {
+        setupCamera();
+    }
+}
+
 void CameraWidget::setupCamera()
 {
     qDebug() << "Setting up camera...";
 
+    // 创建捕获会话时才加载多媒体后端
+    m_captureSession = new QMediaCaptureSession(this);
+    m_imageCapture = new QImageCapture(this);
+    m_videoSink = new QVideoSink(this);
+
+    // 添加捕获会话状态监控
+    connect(m_captureSession, &QMediaCaptureSession::videoOutputChanged, this,
+            []() { qDebug() << "Video output changed"; });
+
     // 在Qt 6中，我们需要选择使用QVideoWidget还是QVideoSink
     // 为了获取视频帧进行识别，我们使用QVideoSink，然后手动显示
 
@@ -703,6 +757,9 @@ void CameraWidget::setupCamera()
     // 然后设置视频输出用于显示 - 这会覆盖sink设置，但我们稍后处理
     m_captureSession->setVideoOutput(m_videoWidget);
 
+    // 预览控件自带的sink不会与显示冲突，用它观察每一帧并评估清晰度
+    connect(m_videoWidget->videoSink(), &QVideoSink::videoFrameChanged, this, &CameraWidget::onVideoFrameChanged);
+
     // 设置图像捕获
     m_captureSession->setImageCapture(m_imageCapture);
 
@@ -710,60 +767,61 @@ void CameraWidget::setupCamera()
     qDebug() << "Video output:" << m_captureSession->videoOutput();
     qDebug() << "Video sink:" << m_captureSession->videoSink();
 
-    updateCameraDevices();
+    // 设备只枚举一次；填充列表时屏蔽信号，避免在此处额外创建一个摄像头实例
+    auto devices = QMediaDevices::videoInputs();
+    {
+        QSignalBlocker blocker(m_deviceCombo);
+        updateCameraDevices(devices);
+    }
 
-    if (isCameraAvailable())
+    if (!devices.isEmpty())
     {
         // 立即初始化第一个摄像头设备
-        auto devices = QMediaDevices::videoInputs();
-        if (!devices.isEmpty())
+        qDebug() << "Available cameras:" << devices.size();
+        for (const auto& device : devices)
         {
-            qDebug() << "Available cameras:" << devices.size();
-            for (const auto& device : devices)
-            {
-                qDebug() << "Camera:" << device.description() << "ID:" << device.id();
-            }
+            qDebug() << "Camera:" << device.description() << "ID:" << device.id();
+        }
 
-            m_camera = new QCamera(devices[0], this);
-            m_captureSession->setCamera(m_camera);
+        m_camera = new QCamera(devices[0], this);
+        m_captureSession->setCamera(m_camera);
 
-            // 连接摄像头错误信号
-            connect(m_camera, &QCamera::errorOccurred, this, &CameraWidget::onCameraErrorOccurred);
-            connect(m_camera, &QCamera::activeChanged, this,
-                    [this](bool active)
+        // 连接摄像头错误信号
+        connect(m_camera, &QCamera::errorOccurred, this, &CameraWidget::onCameraErrorOccurred);
+        connect(m_camera, &QCamera::activeChanged, this,
+                [this](bool active)
+                {
+                    qDebug() << "Camera active changed:" << active;
+                    if (active)
                     {
-                        qDebug() << "Camera active changed:" << active;
-                        if (active)
-                        {
-                            m_cameraStatusLabel->setText("摄像头运行中...");
-                        }
-                    });
-
-            // 重要：由于QVideoWidget和QVideoSink冲突，我们使用ImageCapture获取帧
-            connect(m_imageCapture, &QImageCapture::imageCaptured, this,
-                    [this](int id, const QImage& image)
+                        m_cameraStatusLabel->setText("摄像头运行中...");
+                    }
+                });
+
+        // 重要：由于QVideoWidget和QVideoSink冲突，我们使用ImageCapture获取帧
+        connect(m_imageCapture, &QImageCapture::imageCaptured, this,
+                [this](int id, const QImage& image)
+                {
+                    Q_UNUSED(id)
+                    static int captureCount = 0;
+                    captureCount++;
+                    if (captureCount % 10 == 0)
                     {
-                        Q_UNUSED(id)
-                        static int captureCount = 0;
-                        captureCount++;
-                        if (captureCount % 10 == 0)
-                        {
-                            qDebug()
-                                << "Image captured:" << captureCount << "Size:" << image.size();
-                        }
-
-                        if (!image.isNull())
-                        {
-                            // 创建一个假的QVideoFrame来保持接口一致性
-                            // 注意：这里我们直接处理QImage
-                            processVideoImage(image);
-                        }
-                    });
+                        qDebug()
+                            << "Image captured:" << captureCount << "Size:" << image.size();
+                    }
 
-            updateResolutions();
-            m_cameraStatusLabel->setText("摄像头已准备就绪");
-            qDebug() << "Camera setup completed";
-        }
+                    if (!image.isNull())
+                    {
+                        // 创建一个假的QVideoFrame来保持接口一致性
+                        // 注意：这里我们直接处理QImage
+                        processVideoImage(image);
+                    }
+                });
+
+        updateResolutions();
+        m_cameraStatusLabel->setText("摄像头已准备就绪");
+        qDebug() << "Camera setup completed";
     }
     else
     {
@@ -773,11 +831,10 @@ void CameraWidget::setupCamera()
     }
 }
 
-void CameraWidget::updateCameraDevices()
+void CameraWidget::updateCameraDevices(const QList<QCameraDevice>& devices)
 {
     m_deviceCombo->clear();
 
-    auto devices = QMediaDevices::videoInputs();
     for (const auto& device : devices)
     {
         m_deviceCombo->addItem(device.description());
@@ -834,239 +891,45 @@ void CameraWidget::processVideoImage(const QImage& image)
                      << "Image format:" << image.format() << "Image bytes:" << image.sizeInBytes();
         }
 
-        QRCodeRecognizer::RecognitionConfig config;
-        config.tryHarder = false; // 实时识别使用快速模式
-        config.tryRotate = true;
-        config.fastMode = true;
-        config.maxSymbols = 1;
-
-        // 异步识别以避免阻塞UI
-        static int requestId = 0;
-        requestId++;
-
-        if (processCount % 20 == 0)
-        {
-            qDebug() << "Sending recognition request:" << requestId;
-        }
-
-        m_recognizer->recognizeAsync(image, requestId, config);
+        // 交给调度器在工作线程中识别，避免阻塞UI
+        m_scheduler->submitFrame(image);
     }
 }
 
 void CameraWidget::addResultToHistory(const QRCodeRecognizer::RecognitionResult& result)
 {
-    // 检查是否已存在相同的内容（自动去重）
-    bool isDuplicate = false;
-    for (const auto& existingResult : m_detectionHistory)
-    {
-        if (existingResult.text == result.text && existingResult.format == result.format)
-        {
-            isDuplicate = true;
-            break;
-        }
-    }
+    // 仅当视图已在底部时才跟随新记录滚动，避免打断用户查看旧记录
+    QScrollBar* scrollBar = m_historyView->verticalScrollBar();
+    bool atBottom = scrollBar->value() == scrollBar->maximum();
 
-    // 如果不是重复内容，添加到历史记录
-    if (!isDuplicate)
-    {
-        m_detectionHistory.append(result);
-
-        QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
-        
-        // 检测系统主题以调整HTML样式
-        QPalette palette = QApplication::palette();
-        bool isDarkTheme = palette.color(QPalette::Window).lightness() < 128;
-        
-        QString bgColor = isDarkTheme ? "#2d5a2d" : "#e8f5e8";
-        QString borderColor = isDarkTheme ? "#4CAF50" : "#4CAF50";
-        QString textColor = isDarkTheme ? "#ffffff" : "#000000";
-        
-        QString resultHtml =
-            QString("<div style='margin: 5px 0; padding: 8px; background-color: "
-                    "%4; border-radius: 4px; border-left: 4px solid %5; color: %6;'>"
-                    "<b>[%1]</b> 检测到二维码（新）<br/>"
-                    "<b>内容:</b> %2<br/>"
-                    "<b>格式:</b> %3"
-                    "</div>")
-                .arg(timestamp)
-                .arg(result.text.toHtmlEscaped())
-                .arg(result.format)
-                .arg(bgColor, borderColor, textColor);
-
-        m_historyTextEdit->append(resultHtml);
-
-        // 自动滚动到底部
-        QTextCursor cursor = m_historyTextEdit->textCursor();
-        cursor.movePosition(QTextCursor::End);
-        m_historyTextEdit->setTextCursor(cursor);
-    }
-    else
+    // 模型按内容去重：新内容追加一行，重复内容只更新该行的次数
+    if (m_historyModel->addDetection(result) && atBottom)
     {
-        // 重复内容，只在界面提示
-        QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
-        
-        // 检测系统主题以调整HTML样式
-        QPalette palette = QApplication::palette();
-        bool isDarkTheme = palette.color(QPalette::Window).lightness() < 128;
-        
-        QString bgColor = isDarkTheme ? "#404040" : "#f0f0f0";
-        QString borderColor = isDarkTheme ? "#999999" : "#999999";
-        QString textColor = isDarkTheme ? "#cccccc" : "#666666";
-        
-        QString resultHtml = QString("<div style='margin: 2px 0; padding: 4px; background-color: "
-                                     "%4; border-radius: 4px; border-left: 2px solid %5; color: %6;'>"
-                                     "<small><b>[%1]</b> 重复检测到相同内容</small>"
-                                     "</div>")
-                                 .arg(timestamp)
-                                 .arg(bgColor, borderColor, textColor);
-
-        m_historyTextEdit->append(resultHtml);
-
-        // 自动滚动到底部
-        QTextCursor cursor = m_historyTextEdit->textCursor();
-        cursor.movePosition(QTextCursor::End);
-        m_historyTextEdit->setTextCursor(cursor);
+        m_historyView->scrollToBottom();
     }
 }
+
+int CameraWidget::overlayTimeoutMs() const
+{
+    // 当前识别间隔的2倍 + 1秒，确保持续到下一次识别
+    int recognitionInterval = m_scheduler->currentIntervalMs() + static_cast<int>(m_scheduler->averageLatencyMs());
+    return recognitionInterval * 2 + 1000;
+}
+
 void CameraWidget::drawDetectionOverlay(const QRCodeRecognizer::RecognitionResult& result)
 {
     if (!result.isValid || !m_showOverlayCheckBox->isChecked())
     {
-        m_overlayLabel->hide();
+        m_overlay->clear();
         return;
     }
 
-    // 创建透明背景的QPixmap用于绘制轮廓
-    QPixmap overlayPixmap(m_videoWidget->size());
-    overlayPixmap.fill(Qt::transparent);
-
-    // 确保QPixmap有alpha通道
-    if (overlayPixmap.hasAlphaChannel())
-    {
-        qDebug() << "Overlay pixmap has alpha channel";
-    }
-    else
-    {
-        qDebug() << "Creating pixmap with alpha channel";
-        overlayPixmap = QPixmap(m_videoWidget->size());
-        overlayPixmap.fill(QColor(0, 0, 0, 0)); // 完全透明
-    }
-
-    QPainter painter(&overlayPixmap);
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    // 绘制二维码轮廓
-    const auto& pos = result.position;
-
-    // 计算视频控件的实际显示区域
-    QSize videoSize = m_videoWidget->size();
-
-    // 获取当前摄像头图像的尺寸
-    QSize imageSize = m_lastImageSize;
-
-    // 计算从图像坐标系到视频控件坐标系的缩放比例
-    double scaleX = static_cast<double>(videoSize.width()) / imageSize.width();
-    double scaleY = static_cast<double>(videoSize.height()) / imageSize.height();
-
-    // 保持宽高比，选择较小的缩放比例
-    double scale = qMin(scaleX, scaleY);
-
-    // 计算居中偏移
-    int offsetX = (videoSize.width() - imageSize.width() * scale) / 2;
-    int offsetY = (videoSize.height() - imageSize.height() * scale) / 2;
-
-    // 转换坐标到视频控件坐标系
-    auto transformPoint = [scale, offsetX, offsetY](const ZXing::PointI& p) -> QPoint
-    { return QPoint(p.x * scale + offsetX, p.y * scale + offsetY); };
-
-    // 绘制轮廓边框
-    QPen pen(Qt::red, 3);
-    painter.setPen(pen);
-    painter.setBrush(Qt::NoBrush);
-
-    // 绘制四边形轮廓
-    QPolygon polygon;
-    polygon << transformPoint(pos.topLeft()) << transformPoint(pos.topRight())
-            << transformPoint(pos.bottomRight()) << transformPoint(pos.bottomLeft());
-
-    painter.drawPolygon(polygon);
-
-    // 绘制角点
-    painter.setBrush(Qt::red);
-    int pointSize = 8;
-    for (const auto& point : {pos.topLeft(), pos.topRight(), pos.bottomRight(), pos.bottomLeft()})
-    {
-        QPoint transformedPoint = transformPoint(point);
-        painter.drawEllipse(transformedPoint, pointSize / 2, pointSize / 2);
-    }
-
-    // 绘制识别信息背景和文本
-    if (!result.text.isEmpty())
-    {
-        QFont font = painter.font();
-        font.setPointSize(12);
-        font.setBold(true);
-        painter.setFont(font);
-
-        QFontMetrics fm(font);
-        QString displayText =
-            result.text.length() > 30 ? result.text.left(27) + "..." : result.text;
-        QRect textRect = fm.boundingRect(displayText);
-        textRect.adjust(-8, -4, 8, 4);
-
-        // 将文本放在轮廓上方（使用转换后的坐标）
-        QPoint topLeftTransformed = transformPoint(pos.topLeft());
-        textRect.moveTopLeft(
-            QPoint(topLeftTransformed.x(), topLeftTransformed.y() - textRect.height() - 10));
-
-        // 确保文本不超出视频边界
-        if (textRect.left() < 0)
-            textRect.moveLeft(5);
-        if (textRect.right() > videoSize.width())
-            textRect.moveRight(videoSize.width() - 5);
-        if (textRect.top() < 0)
-        {
-            QPoint bottomLeftTransformed = transformPoint(pos.bottomLeft());
-            textRect.moveTop(bottomLeftTransformed.y() + 10);
-        }
-
-        // 绘制半透明背景
-        painter.setBrush(QColor(0, 0, 0, 180));
-        painter.setPen(Qt::NoPen);
-        painter.drawRoundedRect(textRect, 4, 4);
-
-        // 绘制文本
-        painter.setPen(Qt::white);
-        painter.drawText(textRect, Qt::AlignCenter, displayText);
-    }
-
-    // 设置叠加层图像并显示
-    m_overlayLabel->setPixmap(overlayPixmap);
-
-    // 确保叠加层位置与视频控件全局位置一致
-    QPoint videoGlobalPos = m_videoWidget->mapToGlobal(QPoint(0, 0));
-    m_overlayLabel->move(videoGlobalPos);
-    m_overlayLabel->resize(m_videoWidget->size());
-
-    m_overlayLabel->show();
-
-    qDebug() << "Overlay settings - Size:" << m_overlayLabel->size()
-             << "Video size:" << m_videoWidget->size() << "Pixmap size:" << overlayPixmap.size()
-             << "Has alpha:" << overlayPixmap.hasAlphaChannel();
+    // 叠加层只记录角点，在绘制时按视频控件的显示区域变换坐标
+    m_overlay->setSourceSize(m_lastImageSize);
+    m_overlay->setResults({result});
 
     // 智能叠加层超时：持续到下一次识别成功或超时
-    // 停止之前的计时器
-    m_overlayTimer->stop();
-
-    // 计算超时时间：识别间隔的2倍 + 1秒，确保持续到下一次识别
-    int recognitionInterval = m_recognitionIntervalSlider->value() * 100; // 毫秒
-    int overlayTimeout = recognitionInterval * 2 + 1000;                  // 识别间隔的2倍 + 1秒
-
-    // 设置新的超时
-    m_overlayTimer->start(overlayTimeout);
-
-    qDebug() << "Drew detection overlay for result:" << result.text
-             << "Overlay timeout set to:" << overlayTimeout << "ms";
+    m_overlayTimer->start(overlayTimeoutMs());
 }
 
 void CameraWidget::applyDefaultStyles()
@@ -1081,25 +944,18 @@ void CameraWidget::applyDefaultStyles()
     
     // 应用特定样式
     setStyleSheet(styleSheet() + QString("QVideoWidget { border: 2px solid %1; border-radius: 8px; }"
-                                        "QTextEdit { border: 1px solid %1; border-radius: 4px; }")
+                                        "QListView { border: 1px solid %1; border-radius: 4px; }")
                                         .arg(borderColor));
 }
 
-void CameraWidget::resizeEvent(QResizeEvent* event)
+void CameraWidget::showEvent(QShowEvent* event)
 {
-    BaseWidget::resizeEvent(event);
+    BaseWidget::showEvent(event);
 
-    // 确保叠加层与视频控件大小一致并位置正确
-    if (m_overlayLabel && m_videoWidget)
+    // 首次显示时先让界面完成绘制，再在事件循环的下一轮初始化摄像头
+    if (!m_captureSession)
     {
-        // 获取视频控件的全局位置
-        QPoint videoGlobalPos = m_videoWidget->mapToGlobal(QPoint(0, 0));
-
-        // 设置叠加层全局位置与视频控件一致
-        m_overlayLabel->move(videoGlobalPos);
-        m_overlayLabel->resize(m_videoWidget->size());
-
-        qDebug() << "Resize event - Overlay repositioned to video position:" << videoGlobalPos
-                 << "Size:" << m_overlayLabel->size() << "Video size:" << m_videoWidget->size();
+        m_cameraStatusLabel->setText("正在检测摄像头设备...");
+        QTimer::singleShot(0, this, &CameraWidget::ensureCameraSetup);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,202 @@
+#include "gui/DetectionOverlay.h"
+
+#include <QEvent>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPolygonF>
+
+DetectionOverlay::DetectionOverlay(QWidget* view, bool floating)
+    : QWidget(view, floating ? Qt::FramelessWindowHint | Qt::Tool : Qt::WindowFlags())
+    , m_view(view)
+    , m_floating(floating)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents, true);
+    setAttribute(Qt::WA_NoSystemBackground, true);
+    setAutoFillBackground(false);
+    if (m_floating) {
+        setAttribute(Qt::WA_TranslucentBackground, true);
+        setAttribute(Qt::WA_ShowWithoutActivating, true);
+    }
+
+    // 视图移动或缩放时由事件驱动同步位置，不需要定时校正
+    m_view->installEventFilter(this);
+    hide();
+}
+
+void DetectionOverlay::setSourceSize(const QSize& size)
+{
+    if (m_sourceSize != size) {
+        m_sourceSize = size;
+        update();
+    }
+}
+
+void DetectionOverlay::setDisplayedSize(const QSize& size)
+{
+    if (m_displayedSize != size) {
+        m_displayedSize = size;
+        update();
+    }
+}
+
+void DetectionOverlay::setResults(const QList<QRCodeRecognizer::RecognitionResult>& results)
+{
+    m_results.clear();
+    for (const auto& result : results) {
+        if (result.isValid) {
+            m_results.append(result);
+        }
+    }
+
+    if (m_results.isEmpty()) {
+        clear();
+        return;
+    }
+
+    followView();
+    if (m_view->isVisible()) {
+        raise();
+        show();
+    }
+    update();
+}
+
+void DetectionOverlay::clear()
+{
+    m_results.clear();
+    hide();
+}
+
+void DetectionOverlay::followView()
+{
+    if (!m_floating) {
+        setGeometry(m_view->contentsRect());
+        return;
+    }
+
+    // 视图可能在构造后才被放入主窗口，因此在每次同步时确认所跟踪的顶层窗口
+    QWidget* window = m_view->window();
+    if (window != m_window) {
+        if (m_window) {
+            m_window->removeEventFilter(this);
+        }
+        m_window = window;
+        m_window->installEventFilter(this);
+    }
+
+    QRect contents = m_view->contentsRect();
+    setGeometry(QRect(m_view->mapToGlobal(contents.topLeft()), contents.size()));
+}
+
+bool DetectionOverlay::eventFilter(QObject* watched, QEvent* event)
+{
+    switch (event->type()) {
+    case QEvent::Resize:
+    case QEvent::Move:
+        if (watched == m_view || (m_floating && watched == m_window.data())) {
+            followView();
+        }
+        break;
+    case QEvent::Hide:
+        // 浮动窗口不会随视图自动隐藏（如切换标签页）
+        if (m_floating && watched == m_view) {
+            hide();
+        }
+        break;
+    case QEvent::Show:
+        if (m_floating && watched == m_view && hasResults()) {
+            followView();
+            show();
+        }
+        break;
+    default:
+        break;
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+QRectF DetectionOverlay::imageRect() const
+{
+    if (m_sourceSize.isEmpty()) {
+        return QRectF();
+    }
+
+    QSizeF displayed = m_displayedSize.isValid()
+                           ? QSizeF(m_displayedSize)
+                           : QSizeF(m_sourceSize).scaled(QSizeF(size()), Qt::KeepAspectRatio);
+
+    QRectF rect(QPointF(0, 0), displayed);
+    rect.moveCenter(QRectF(this->rect()).center());
+    return rect;
+}
+
+void DetectionOverlay::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event)
+
+    QRectF target = imageRect();
+    if (m_results.isEmpty() || target.isEmpty()) {
+        return;
+    }
+
+    // 图像坐标 -> 视图坐标
+    double scale = target.width() / m_sourceSize.width();
+    auto toView = [&target, scale](const ZXing::PointI& p) {
+        return QPointF(target.left() + p.x * scale, target.top() + p.y * scale);
+    };
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    QFont font = painter.font();
+    font.setPointSize(12);
+    font.setBold(true);
+    painter.setFont(font);
+    QFontMetrics fm(font);
+
+    for (const auto& result : m_results) {
+        const auto& pos = result.position;
+        QPolygonF polygon;
+        polygon << toView(pos.topLeft()) << toView(pos.topRight())
+                << toView(pos.bottomRight()) << toView(pos.bottomLeft());
+
+        // 轮廓与角点
+        painter.setPen(QPen(Qt::red, 3));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawPolygon(polygon);
+
+        painter.setBrush(Qt::red);
+        for (const QPointF& corner : polygon) {
+            painter.drawEllipse(corner, 4.0, 4.0);
+        }
+
+        if (result.text.isEmpty()) {
+            continue;
+        }
+
+        // 文本放在轮廓上方，超出视图时移到下方并限制在视图内
+        QString displayText = result.text.length() > MAX_LABEL_LENGTH
+                                  ? result.text.left(MAX_LABEL_LENGTH - 3) + "..."
+                                  : result.text;
+        QRectF textRect = fm.boundingRect(displayText);
+        textRect.adjust(-8, -4, 8, 4);
+        QRectF bounds = polygon.boundingRect();
+        textRect.moveBottomLeft(QPointF(bounds.left(), bounds.top() - 10));
+        if (textRect.top() < 0) {
+            textRect.moveTop(bounds.bottom() + 10);
+        }
+        if (textRect.right() > width()) {
+            textRect.moveRight(width() - 5);
+        }
+        if (textRect.left() < 0) {
+            textRect.moveLeft(5);
+        }
+
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(0, 0, 0, 180));
+        painter.drawRoundedRect(textRect, 4, 4);
+
+        painter.setPen(Qt::white);
+        painter.drawText(textRect, Qt::AlignCenter, displayText);
+    }
+}
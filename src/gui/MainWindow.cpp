@@ -2,7 +2,9 @@
 #include "gui/GeneratorWidget.h"
 #include "gui/RecognizerWidget.h"
 #include "gui/CameraWidget.h"
+#include "gui/VideoScanWidget.h"
 #include "gui/SettingsDialog.h"
+#include "gui/StatsPanel.h"
 #include "core/QRCodeGenerator.h"
 #include "core/QRCodeRecognizer.h"
 #include "utils/AppUtils.h"
@@ -28,6 +30,13 @@ MainWindow::MainWindow(QWidget* parent)
     , m_generatorWidget(nullptr)
     , m_recognizerWidget(nullptr)
     , m_cameraWidget(nullptr)
+    , m_videoScanWidget(nullptr)
+    , m_generatorPage(nullptr)
+    , m_recognizerPage(nullptr)
+    , m_cameraPage(nullptr)
+    , m_videoScanPage(nullptr)
+    , m_statsPanel(nullptr)
+    , m_statsDock(nullptr)
     , m_generator(new QRCodeGenerator())
     , m_recognizer(new QRCodeRecognizer(this))
     , m_hasUnsavedChanges(false)
@@ -42,6 +51,9 @@ MainWindow::MainWindow(QWidget* parent)
     loadSettings();
     updateWindowTitle();
     
+    // 只构建当前标签页，其余标签页在首次切换到时构建
+    ensureTabCreated(m_tabWidget->currentIndex());
+    
     // 连接主题变化信号
     connect(ThemeManager::instance(), &ThemeManager::themeChanged,
             this, &MainWindow::onThemeChanged);
@@ -217,6 +229,10 @@ void MainWindow::onRecognizeMultiFormat(const QImage& image)
     // 使用多格式识别
     QRCodeRecognizer::RecognitionConfig config = m_recognizerWidget->getConfig();
     auto results = m_recognizer->recognizeMultiFormat(image, config);
+    if (results.isEmpty()) {
+        // 图片在加载时被缩小，条码可能太小而无法解码
+        results = m_recognizerWidget->recognizeFullResolution(config);
+    }
     
     if (results.isEmpty()) {
         m_recognizerWidget->showError("未识别到任何条码格式");
@@ -261,20 +277,30 @@ void MainWindow::setupUI()
     m_tabWidget->setTabPosition(QTabWidget::North);
     m_tabWidget->setMovable(true);
     
-    // 创建生成器页面
-    m_generatorWidget = new GeneratorWidget();
-    m_tabWidget->addTab(m_generatorWidget, "二维码生成");
+    // 各标签页先放置空容器，实际页面在首次激活时创建（见ensureTabCreated）
+    m_generatorPage = createTabPage();
+    m_tabWidget->addTab(m_generatorPage, "二维码生成");
+    
+    m_recognizerPage = createTabPage();
+    m_tabWidget->addTab(m_recognizerPage, "二维码识别");
     
-    // 创建识别器页面
-    m_recognizerWidget = new RecognizerWidget();
-    m_tabWidget->addTab(m_recognizerWidget, "二维码识别");
+    m_cameraPage = createTabPage();
+    m_tabWidget->addTab(m_cameraPage, "摄像头识别");
     
-    // 创建摄像头页面
-    m_cameraWidget = new CameraWidget();
-    m_tabWidget->addTab(m_cameraWidget, "摄像头识别");
+    m_videoScanPage = createTabPage();
+    m_tabWidget->addTab(m_videoScanPage, "视频文件识别");
     
     mainLayout->addWidget(m_tabWidget);
     
+    // 创建性能统计停靠面板（默认隐藏，可从“视图”菜单打开）
+    m_statsPanel = new StatsPanel();
+    m_statsDock = new QDockWidget("识别性能统计", this);
+    m_statsDock->setObjectName("statsDock");
+    m_statsDock->setWidget(m_statsPanel);
+    m_statsDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea | Qt::BottomDockWidgetArea);
+    addDockWidget(Qt::RightDockWidgetArea, m_statsDock);
+    m_statsDock->hide();
+    
     // 应用主题样式
     applyThemeStyles();
 }
@@ -386,6 +412,10 @@ void MainWindow::setupMenuBar()
     exitAction->setShortcut(QKeySequence::Quit);
     connect(exitAction, &QAction::triggered, this, &MainWindow::onExit);
     
+    // 视图菜单
+    QMenu* viewMenu = m_menuBar->addMenu("视图(&V)");
+    viewMenu->addAction(m_statsDock->toggleViewAction());
+    
     // 工具菜单
     QMenu* toolsMenu = m_menuBar->addMenu("工具(&T)");
     
@@ -415,24 +445,44 @@ void MainWindow::setupStatusBar()
 
 void MainWindow::setupConnections()
 {
-    // 连接生成器信号
-    if (m_generatorWidget) {
+    // 切换标签页时按需构建页面
+    connect(m_tabWidget, &QTabWidget::currentChanged,
+            this, &MainWindow::ensureTabCreated);
+}
+
+QWidget* MainWindow::createTabPage()
+{
+    QWidget* page = new QWidget();
+    QVBoxLayout* layout = new QVBoxLayout(page);
+    layout->setContentsMargins(0, 0, 0, 0);
+    return page;
+}
+
+void MainWindow::ensureTabCreated(int index)
+{
+    // 标签页可以拖动排序，因此按容器而不是按索引识别页面
+    QWidget* page = m_tabWidget->widget(index);
+    
+    if (page == m_generatorPage && !m_generatorWidget) {
+        m_generatorWidget = new GeneratorWidget();
+        page->layout()->addWidget(m_generatorWidget);
+        
         connect(m_generatorWidget, &GeneratorWidget::generateRequested,
                 this, &MainWindow::onGenerateQRCode);
         connect(m_generatorWidget, &GeneratorWidget::saveRequested,
                 this, &MainWindow::onSaveQRCode);
-    }
-    
-    // 连接识别器信号
-    if (m_recognizerWidget) {
+    } else if (page == m_recognizerPage && !m_recognizerWidget) {
+        m_recognizerWidget = new RecognizerWidget();
+        page->layout()->addWidget(m_recognizerWidget);
+        
         connect(m_recognizerWidget, &RecognizerWidget::recognizeRequested,
                 this, &MainWindow::onRecognizeQRCode);
         connect(m_recognizerWidget, &RecognizerWidget::multiFormatRecognizeRequested,
                 this, &MainWindow::onRecognizeMultiFormat);
-    }
-    
-    // 连接摄像头信号
-    if (m_cameraWidget) {
+    } else if (page == m_cameraPage && !m_cameraWidget) {
+        m_cameraWidget = new CameraWidget();
+        page->layout()->addWidget(m_cameraWidget);
+        
         connect(m_cameraWidget, &CameraWidget::qrCodeDetected,
                 this, [this](const QString& text, const auto& result) {
                     Q_UNUSED(result)
@@ -440,6 +490,15 @@ void MainWindow::setupConnections()
                 });
         connect(m_cameraWidget, &CameraWidget::cameraError,
                 this, &MainWindow::onCameraError);
+    } else if (page == m_videoScanPage && !m_videoScanWidget) {
+        m_videoScanWidget = new VideoScanWidget();
+        page->layout()->addWidget(m_videoScanWidget);
+        
+        connect(m_videoScanWidget, &VideoScanWidget::qrCodeDetected,
+                this, [this](const QString& text, const auto& result) {
+                    Q_UNUSED(result)
+                    onQRCodeDetected(text);
+                });
     }
 }
 
@@ -1,4 +1,5 @@
 #include "gui/RecognizerWidget.h"
+#include "gui/DetectionOverlay.h"
 #include "utils/AppUtils.h"
 #include "utils/AppSettings.h"
 #include <QApplication>
@@ -38,6 +39,15 @@ void RecognizerWidget::setConfig(const QRCodeRecognizer::RecognitionConfig& conf
     m_fastModeCheckBox->setChecked(config.fastMode);
     m_maxSymbolsSpinBox->setValue(config.maxSymbols);
 
+    // 选中与格式集合一致的码制方案（自定义集合保持当前选择）
+    for (int i = 0; i < m_profileComboBox->count(); ++i) {
+        auto profile = static_cast<QRCodeRecognizer::SymbologyProfile>(m_profileComboBox->itemData(i).toInt());
+        if (QRCodeRecognizer::profileFormats(profile) == config.formats) {
+            m_profileComboBox->setCurrentIndex(i);
+            break;
+        }
+    }
+
     m_recognizer->setConfig(config);
 }
 
@@ -48,25 +58,103 @@ QRCodeRecognizer::RecognitionConfig RecognizerWidget::getConfig() const
     config.tryRotate = m_tryRotateCheckBox->isChecked();
     config.fastMode = m_fastModeCheckBox->isChecked();
     config.maxSymbols = m_maxSymbolsSpinBox->value();
+    config.formats = QRCodeRecognizer::profileFormats(
+        static_cast<QRCodeRecognizer::SymbologyProfile>(m_profileComboBox->currentData().toInt()));
+    config.timeoutMs = AppSettings::instance().getRecognitionTimeout();
     return config;
 }
 
+QList<QRCodeRecognizer::RecognitionResult> RecognizerWidget::recognizeFullResolution(
+    const QRCodeRecognizer::RecognitionConfig& config)
+{
+    // 只对从文件或网络数据缩小解码的当前图片重试
+    if (m_loadedImage.isNull() || m_loadedImage.image.cacheKey() != m_currentImage.cacheKey())
+    {
+        return {};
+    }
+
+    m_statusLabel->setText("以原始分辨率重新识别...");
+    QApplication::processEvents();
+    return m_recognizer->recognizeFullResolution(m_loadedImage, config);
+}
+
+bool RecognizerWidget::isTiledMode() const
+{
+    return m_tiledCheckBox->isChecked();
+}
+
+QList<QRCodeRecognizer::RecognitionResult> RecognizerWidget::recognizeTiled(
+    const LoadedImage& loaded, const QRCodeRecognizer::RecognitionConfig& config)
+{
+    if (!m_tiledRecognizer)
+    {
+        m_tiledRecognizer = std::make_unique<TiledRecognizer>();
+    }
+
+    TiledRecognizer::Options options;
+    options.moduleSize = m_moduleSizeSpinBox->value();
+    m_tiledRecognizer->setOptions(options);
+
+    // 从来源按原始分辨率分块读取；没有来源（已解码的图像）时直接在图像上分块
+    QList<QRCodeRecognizer::RecognitionResult> results;
+    if (!loaded.filePath.isEmpty())
+    {
+        results = m_tiledRecognizer->recognizeFile(loaded.filePath, config, loaded.page);
+    }
+    else if (!loaded.data.isEmpty())
+    {
+        results = m_tiledRecognizer->recognizeData(loaded.data, config);
+    }
+    else
+    {
+        results = m_tiledRecognizer->recognizeImage(loaded.image, config);
+    }
+
+    // 原图坐标 -> 加载的（可能已缩小的）图像坐标
+    if (loaded.isScaled())
+    {
+        QRCodeRecognizer::scalePositions(
+            results, static_cast<double>(loaded.image.width()) / loaded.originalSize.width(),
+            static_cast<double>(loaded.image.height()) / loaded.originalSize.height());
+    }
+    return results;
+}
+
+void RecognizerWidget::recognizeCurrentTiled()
+{
+    // 当前图片不是从文件或网络加载的（没有来源）时在当前图像上分块
+    LoadedImage loaded = m_loadedImage;
+    if (loaded.isNull() || loaded.image.cacheKey() != m_currentImage.cacheKey())
+    {
+        loaded = LoadedImage();
+        loaded.image = m_currentImage;
+        loaded.originalSize = m_currentImage.size();
+    }
+
+    m_progressBar->setVisible(true);
+    m_progressBar->setRange(0, 0); // 不确定进度
+    m_statusLabel->setText(QString("正在分块识别 (%1x%2)...")
+                               .arg(loaded.originalSize.width())
+                               .arg(loaded.originalSize.height()));
+    QApplication::processEvents();
+
+    QRCodeRecognizer::RecognitionConfig config = getConfig();
+    auto results = recognizeTiled(loaded, config);
+    if (results.isEmpty())
+    {
+        showError(m_tiledRecognizer->getLastError());
+        return;
+    }
+    showMultiFormatResults(results);
+}
+
 void RecognizerWidget::showRecognitionResult(const QRCodeRecognizer::RecognitionResult& result)
 {
     updateResultDisplay(result);
     
-    // 在原图像上绘制识别轮廓
-    if (result.isValid && !m_currentPixmap.isNull()) {
-        QPixmap contourImage = m_recognizer->drawContour(m_currentPixmap, result);
-        
-        // 更新显示的图像
-        QPixmap displayPixmap = contourImage.scaled(m_imageLabel->size(), 
-                                                   Qt::KeepAspectRatio, 
-                                                   Qt::SmoothTransformation);
-        m_imageLabel->setPixmap(displayPixmap);
-        
-        // 保存带轮廓的图像，用于后续操作
-        m_currentPixmapWithContour = contourImage;
+    // 在预览图上叠加识别轮廓（矢量绘制，不重绘或缩放图像）
+    if (result.isValid && !m_currentImage.isNull()) {
+        m_resultOverlay->setResults({result});
     }
     
     m_statusLabel->setText("识别完成");
@@ -108,24 +196,15 @@ void RecognizerWidget::showMultiFormatResults(
             i == 0 ? "🥇" : (i == 1 ? "🥈" : (i == 2 ? "🥉" : QString("第%1位").arg(i + 1)));
 
         m_resultsTextEdit->append(
-            QString("  %1 <b>%2</b>: %3").arg(rank).arg(result.format).arg(result.text));
+            QString("  %1 <b>%2</b>: %3").arg(rank).arg(result.formatName()).arg(result.text));
     }
 
     // 更新单个结果显示（显示最流行的）
     updateResultDisplay(results.first());
     
-    // 在原图像上绘制识别轮廓（显示最流行的结果）
-    if (!results.isEmpty() && results.first().isValid && !m_currentPixmap.isNull()) {
-        QPixmap contourImage = m_recognizer->drawContour(m_currentPixmap, results.first());
-        
-        // 更新显示的图像
-        QPixmap displayPixmap = contourImage.scaled(m_imageLabel->size(), 
-                                                   Qt::KeepAspectRatio, 
-                                                   Qt::SmoothTransformation);
-        m_imageLabel->setPixmap(displayPixmap);
-        
-        // 保存带轮廓的图像
-        m_currentPixmapWithContour = contourImage;
+    // 在预览图上叠加所有识别结果的轮廓
+    if (!m_currentImage.isNull()) {
+        m_resultOverlay->setResults(results);
     }
     
     m_statusLabel->setText(QString("识别完成 - 找到%1种格式").arg(results.size()));
@@ -211,6 +290,12 @@ void RecognizerWidget::onRecognizeClicked()
         return;
     }
 
+    if (isTiledMode())
+    {
+        recognizeCurrentTiled();
+        return;
+    }
+
     m_progressBar->setVisible(true);
     m_progressBar->setRange(0, 0); // 不确定进度
     m_statusLabel->setText("正在识别...");
@@ -228,6 +313,12 @@ void RecognizerWidget::onMultiFormatClicked()
         return;
     }
 
+    if (isTiledMode())
+    {
+        recognizeCurrentTiled();
+        return;
+    }
+
     m_progressBar->setVisible(true);
     m_progressBar->setRange(0, 0); // 不确定进度
     m_statusLabel->setText("正在识别多种格式...");
@@ -275,7 +366,7 @@ void RecognizerWidget::onSaveResultsClicked()
                 const auto& result = m_results[i];
                 out << "=== 结果 " << (i + 1) << " ===\n";
                 out << "内容: " << result.text << "\n";
-                out << "格式: " << result.format << "\n";
+                out << "格式: " << result.formatName() << "\n";
                 out << "置信度: " << QString::number(result.confidence, 'f', 2) << "\n\n";
             }
 
@@ -307,6 +398,12 @@ void RecognizerWidget::onRecognitionFailed(const QString& error, int requestId)
 {
     if (requestId == m_requestCounter)
     {
+        auto results = recognizeFullResolution(getConfig());
+        if (!results.isEmpty())
+        {
+            showRecognitionResult(results.first());
+            return;
+        }
         showError(error);
     }
 }
@@ -348,6 +445,7 @@ void RecognizerWidget::setupUI()
                                 "    font-size: 14px;"
                                 "}").arg(borderColor, backgroundColor, textColor));
     m_imageScrollArea->setWidget(m_imageLabel);
+    m_resultOverlay = new DetectionOverlay(m_imageLabel);
     m_imageScrollArea->setWidgetResizable(true);
     imageLayout->addWidget(m_imageScrollArea);
 
@@ -368,6 +466,19 @@ void RecognizerWidget::setupUI()
     buttonLayout->addWidget(m_selectImageButton);
     buttonLayout->addWidget(m_recognizeButton);
     buttonLayout->addWidget(m_multiFormatButton);
+
+    // 多页TIFF、多帧GIF/ICO：选择预览和识别的页，或一次识别全部页
+    m_pageLabel = createLabel("页:");
+    m_pageSpinBox = new QSpinBox();
+    m_allPagesButton = createButton("识别全部页");
+    m_allPagesButton->setToolTip("并行识别文档的所有页，按页报告结果并合并跨页的结构化追加序列");
+    buttonLayout->addWidget(m_pageLabel);
+    buttonLayout->addWidget(m_pageSpinBox);
+    buttonLayout->addWidget(m_allPagesButton);
+    m_pageLabel->setVisible(false);
+    m_pageSpinBox->setVisible(false);
+    m_allPagesButton->setVisible(false);
+
     buttonLayout->addStretch();
     imageLayout->addLayout(buttonLayout);
 
@@ -425,6 +536,34 @@ void RecognizerWidget::setupUI()
     maxSymbolsLayout->addStretch();
     configLayout->addLayout(maxSymbolsLayout);
 
+    // 码制方案：只启用业务中实际使用的格式可显著提高识别速度
+    QHBoxLayout* profileLayout = createHBoxLayout(nullptr, 0);
+    profileLayout->addWidget(createLabel("码制方案:"));
+    m_profileComboBox = new QComboBox();
+    m_profileComboBox->addItem("全部格式", static_cast<int>(QRCodeRecognizer::SymbologyProfile::All));
+    m_profileComboBox->addItem("零售一维码", static_cast<int>(QRCodeRecognizer::SymbologyProfile::Retail1D));
+    m_profileComboBox->addItem("物流", static_cast<int>(QRCodeRecognizer::SymbologyProfile::Logistics));
+    m_profileComboBox->addItem("仅二维码制", static_cast<int>(QRCodeRecognizer::SymbologyProfile::TwoD));
+    m_profileComboBox->addItem("仅QR Code", static_cast<int>(QRCodeRecognizer::SymbologyProfile::QROnly));
+    profileLayout->addWidget(m_profileComboBox);
+    profileLayout->addStretch();
+    configLayout->addLayout(profileLayout);
+
+    // 大幅面分块识别：按原始分辨率分块并行识别，用于缩小后条码过小的图纸和扫描件
+    QHBoxLayout* tiledLayout = createHBoxLayout(nullptr, 0);
+    m_tiledCheckBox = new QCheckBox("大幅面分块识别");
+    m_tiledCheckBox->setToolTip("按原始分辨率把图片分成重叠的块并行识别，适用于A0图纸、托盘墙照片等含有小条码的大图");
+    tiledLayout->addWidget(m_tiledCheckBox);
+    tiledLayout->addWidget(createLabel("模块尺寸(像素):"));
+    m_moduleSizeSpinBox = new QSpinBox();
+    m_moduleSizeSpinBox->setRange(1, 32);
+    m_moduleSizeSpinBox->setValue(TiledRecognizer::Options().moduleSize);
+    m_moduleSizeSpinBox->setToolTip("原图中最小条码的单个模块（最窄条）的像素数，决定分块大小和重叠宽度");
+    m_moduleSizeSpinBox->setEnabled(false);
+    tiledLayout->addWidget(m_moduleSizeSpinBox);
+    tiledLayout->addStretch();
+    configLayout->addLayout(tiledLayout);
+
     rightLayout->addWidget(m_configGroup);
 
     // 结果区域
@@ -466,6 +605,10 @@ void RecognizerWidget::setupUI()
     connect(m_recognizeButton, &QPushButton::clicked, this, &RecognizerWidget::onRecognizeClicked);
     connect(m_multiFormatButton, &QPushButton::clicked, this,
             &RecognizerWidget::onMultiFormatClicked);
+    connect(m_pageSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this,
+            &RecognizerWidget::onPageChanged);
+    connect(m_allPagesButton, &QPushButton::clicked, this,
+            &RecognizerWidget::onRecognizeAllPagesClicked);
     connect(m_clearResultsButton, &QPushButton::clicked, this,
             &RecognizerWidget::onClearResultsClicked);
     connect(m_saveResultsButton, &QPushButton::clicked, this,
@@ -485,6 +628,9 @@ void RecognizerWidget::setupUI()
     connect(m_fastModeCheckBox, &QCheckBox::toggled, this, &RecognizerWidget::onConfigChanged);
     connect(m_maxSymbolsSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this,
             &RecognizerWidget::onConfigChanged);
+    connect(m_profileComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            &RecognizerWidget::onConfigChanged);
+    connect(m_tiledCheckBox, &QCheckBox::toggled, m_moduleSizeSpinBox, &QSpinBox::setEnabled);
 }
 
 void RecognizerWidget::updateImagePreview(const QImage& image)
@@ -495,12 +641,16 @@ void RecognizerWidget::updateImagePreview(const QImage& image)
     }
 
     m_currentImage = image;
-    m_currentPixmap = QPixmap::fromImage(image);
 
-    // 缩放显示
-    QPixmap displayPixmap =
-        m_currentPixmap.scaled(m_imageLabel->size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    // 缩放显示：只把缩放后的图像转换为QPixmap，标签居中显示在内容区域内
+    QPixmap displayPixmap = QPixmap::fromImage(
+        image.scaled(m_imageLabel->contentsRect().size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
     m_imageLabel->setPixmap(displayPixmap);
+
+    // 新图片的轮廓坐标以原图尺寸为准，叠加层按显示尺寸变换
+    m_resultOverlay->clear();
+    m_resultOverlay->setSourceSize(image.size());
+    m_resultOverlay->setDisplayedSize(displayPixmap.size());
     m_recognizeButton->setEnabled(true);
     m_multiFormatButton->setEnabled(true);
 
@@ -525,18 +675,30 @@ void RecognizerWidget::updateResultDisplay(const QRCodeRecognizer::RecognitionRe
     QString bgColor = isDarkTheme ? "#404040" : "#f0f0f0";
     QString textColor = isDarkTheme ? "#ffffff" : "#000000";
     
+    // 符号细节：版本、纠错等级、方向、反色（仅显示可用的项）
+    QStringList details;
+    if (!result.version.isEmpty())
+        details << QString("版本 %1").arg(result.version);
+    if (!result.ecLevel.isEmpty())
+        details << QString("纠错 %1").arg(result.ecLevel);
+    details << QString("方向 %1°").arg(result.orientation);
+    if (result.isInverted)
+        details << "反色";
+
     QString resultHtml = QString("<div style='margin: 5px 0; padding: 8px; background-color: "
                                  "%5; border-radius: 4px; color: %6;'>"
                                  "<b>[%1]</b> 识别成功<br/>"
                                  "<b>内容:</b> %2<br/>"
                                  "<b>格式:</b> %3<br/>"
-                                 "<b>置信度:</b> %4"
+                                 "<b>置信度:</b> %4<br/>"
+                                 "<b>符号:</b> %7"
                                  "</div>")
                              .arg(timestamp)
                              .arg(result.text.toHtmlEscaped())
-                             .arg(result.format)
+                             .arg(result.formatName())
                              .arg(QString::number(result.confidence, 'f', 2))
-                             .arg(bgColor, textColor);
+                             .arg(bgColor, textColor)
+                             .arg(details.join(" · ").toHtmlEscaped());
 
     m_resultsTextEdit->append(resultHtml);
 
@@ -553,12 +715,16 @@ void RecognizerWidget::updateResultDisplay(const QRCodeRecognizer::RecognitionRe
     }
 }
 
-void RecognizerWidget::loadImageFromFile(const QString& filePath)
+void RecognizerWidget::loadImageFromFile(const QString& filePath, int page)
 {
-    QImage image(filePath);
-    if (!image.isNull())
+    // 超过识别尺寸的图片在解码时直接缩小（JPEG使用DCT缩放），不解码完整分辨率
+    LoadedImage loaded = ScaledImageLoader::fromFile(
+        filePath, QRCodeRecognizer::MAX_DECODE_DIMENSION, false, page);
+    if (!loaded.isNull())
     {
-        updateImagePreview(image);
+        m_loadedImage = loaded;
+        updateImagePreview(loaded.image);
+        updatePageSelector();
     }
     else
     {
@@ -566,6 +732,162 @@ void RecognizerWidget::loadImageFromFile(const QString& filePath)
     }
 }
 
+void RecognizerWidget::updatePageSelector()
+{
+    bool multiPage = !m_loadedImage.filePath.isEmpty() && m_loadedImage.pageCount > 1;
+    m_pageLabel->setVisible(multiPage);
+    m_pageSpinBox->setVisible(multiPage);
+    m_allPagesButton->setVisible(multiPage);
+    if (!multiPage)
+    {
+        return;
+    }
+
+    // 页码从1开始显示；更新范围和当前页时不触发重新加载
+    QSignalBlocker blocker(m_pageSpinBox);
+    m_pageSpinBox->setRange(1, m_loadedImage.pageCount);
+    m_pageSpinBox->setSuffix(QString(" / %1").arg(m_loadedImage.pageCount));
+    m_pageSpinBox->setValue(m_loadedImage.page + 1);
+
+    m_statusLabel->setText(QString("图片已加载 (%1x%2)，第 %3/%4 页")
+                               .arg(m_loadedImage.originalSize.width())
+                               .arg(m_loadedImage.originalSize.height())
+                               .arg(m_loadedImage.page + 1)
+                               .arg(m_loadedImage.pageCount));
+}
+
+void RecognizerWidget::onPageChanged(int page)
+{
+    if (!m_loadedImage.filePath.isEmpty() && page - 1 != m_loadedImage.page)
+    {
+        loadImageFromFile(m_loadedImage.filePath, page - 1);
+    }
+}
+
+void RecognizerWidget::onRecognizeAllPagesClicked()
+{
+    if (m_loadedImage.filePath.isEmpty())
+    {
+        return;
+    }
+    recognizeDocument(m_loadedImage.filePath, getConfig());
+}
+
+void RecognizerWidget::recognizeDocument(const QString& filePath,
+                                         const QRCodeRecognizer::RecognitionConfig& config)
+{
+    if (!m_documentRecognizer)
+    {
+        m_documentRecognizer = std::make_unique<DocumentRecognizer>();
+    }
+
+    QString fileName = QFileInfo(filePath).fileName();
+    bool showProgress = !m_progressBar->isVisible();
+    if (showProgress)
+    {
+        m_progressBar->setVisible(true);
+        m_progressBar->setRange(0, 0); // 不确定进度
+    }
+
+    // 识别期间处理界面事件以更新进度，禁用会重新进入识别或更换当前图片的操作；
+    // 结束后恢复原来的状态（批量识别中调用时按钮可能本来就是禁用的）
+    const QList<QWidget*> controls = {m_selectImageButton, m_loadFromUrlButton, m_recognizeButton,
+                                      m_multiFormatButton, m_allPagesButton, m_pageSpinBox};
+    QList<bool> wasEnabled;
+    for (QWidget* control : controls)
+    {
+        wasEnabled.append(control->isEnabled());
+        control->setEnabled(false);
+    }
+    bool acceptedDrops = acceptDrops();
+    setAcceptDrops(false);
+
+    auto document = m_documentRecognizer->recognizeFile(
+        filePath, config,
+        [this, &fileName](int pagesRead, int pageCount)
+        {
+            m_statusLabel->setText(
+                pageCount > 0
+                    ? QString("正在识别 %1：第 %2/%3 页")
+                          .arg(fileName, QString::number(pagesRead), QString::number(pageCount))
+                    : QString("正在识别 %1：第 %2 页").arg(fileName, QString::number(pagesRead)));
+            QApplication::processEvents();
+        });
+
+    for (int i = 0; i < controls.size(); ++i)
+    {
+        controls[i]->setEnabled(wasEnabled[i]);
+    }
+    setAcceptDrops(acceptedDrops);
+
+    if (showProgress)
+    {
+        m_progressBar->setVisible(false);
+    }
+
+    if (!document.error.isEmpty())
+    {
+        showError(QString("文件 %1: %2").arg(fileName).arg(document.error));
+        return;
+    }
+
+    // 按页报告：每页列出识别到的符号
+    QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
+    m_resultsTextEdit->append(QString("[%1] <span style='color: %5;'>%2：%3 页，识别到 %4 个符号</span>")
+                                  .arg(timestamp, fileName.toHtmlEscaped(),
+                                       QString::number(document.pageCount),
+                                       QString::number(document.symbolCount()), getSuccessColor()));
+
+    for (const auto& page : document.pages)
+    {
+        if (page.results.isEmpty())
+        {
+            continue;
+        }
+        for (int i = 0; i < page.results.size(); ++i)
+        {
+            const auto& result = page.results[i];
+            QString sequence = result.isPartOfSequence()
+                                   ? QString("（序列 %1/%2）").arg(result.sequenceIndex + 1).arg(result.sequenceSize)
+                                   : QString();
+            m_resultsTextEdit->append(QString("  第%1页 #%2 <b>%3</b>%4: %5")
+                                          .arg(page.page + 1)
+                                          .arg(i + 1)
+                                          .arg(result.formatName(), sequence, result.text.toHtmlEscaped()));
+            if (!result.isPartOfSequence())
+            {
+                m_results.append(result);
+            }
+        }
+    }
+
+    // 跨页合并的结构化追加数据作为完整结果
+    for (const auto& sequence : document.sequences)
+    {
+        QStringList pages;
+        for (int page : sequence.pages)
+        {
+            pages << QString::number(page + 1);
+        }
+        m_resultsTextEdit->append(QString("  合并序列（页 %1）<b>%2</b>: %3")
+                                      .arg(pages.join(", "), sequence.result.formatName(),
+                                           sequence.result.text.toHtmlEscaped()));
+        m_results.append(sequence.result);
+    }
+
+    for (const QString& incomplete : document.incompleteSequences)
+    {
+        m_resultsTextEdit->append(QString("  <span style='color: %1;'>不完整的序列: %2</span>")
+                                      .arg(getWarningColor())
+                                      .arg(incomplete.toHtmlEscaped()));
+    }
+
+    m_statusLabel->setText(QString("%1 识别完成：%2 页，%3 个符号，用时 %4 ms")
+                               .arg(fileName, QString::number(document.pageCount),
+                                    QString::number(document.symbolCount()),
+                                    QString::number(document.elapsedMs)));
+}
+
 void RecognizerWidget::processImageList(const QStringList& filePaths)
 {
     if (filePaths.isEmpty())
@@ -586,10 +908,44 @@ void RecognizerWidget::processImageList(const QStringList& filePaths)
 
         for (int i = 0; i < filePaths.size(); ++i)
         {
-            QImage image(filePaths[i]);
-            if (!image.isNull())
+            // 多页文档逐页并行识别
+            if (!isTiledMode() && ScaledImageLoader::pageCount(filePaths[i]) > 1)
+            {
+                recognizeDocument(filePaths[i], config);
+                m_progressBar->setValue(i + 1);
+                QApplication::processEvents();
+                continue;
+            }
+
+            // 批量识别不需要预览，直接解码为缩小的灰度图像
+            LoadedImage loaded = ScaledImageLoader::fromFile(
+                filePaths[i], QRCodeRecognizer::MAX_DECODE_DIMENSION, true);
+            if (!loaded.isNull() && isTiledMode())
+            {
+                // 分块识别报告整幅图中的所有符号
+                auto results = recognizeTiled(loaded, config);
+                for (const auto& result : results)
+                {
+                    updateResultDisplay(result);
+                }
+                if (results.isEmpty())
+                {
+                    showError(QString("文件 %1: %2")
+                                  .arg(QFileInfo(filePaths[i]).fileName())
+                                  .arg(m_tiledRecognizer->getLastError()));
+                }
+            }
+            else if (!loaded.isNull())
             {
-                auto result = m_recognizer->recognizeSync(image, config);
+                auto result = m_recognizer->recognizeSync(loaded.image, config);
+                if (!result.isValid)
+                {
+                    auto fullResults = m_recognizer->recognizeFullResolution(loaded, config);
+                    if (!fullResults.isEmpty())
+                    {
+                        result = fullResults.first();
+                    }
+                }
                 if (result.isValid)
                 {
                     updateResultDisplay(result);
@@ -751,9 +1107,9 @@ void RecognizerWidget::onNetworkImageDownloaded()
 
     // 读取图片数据
     QByteArray imageData = m_currentReply->readAll();
-    QImage image;
+    LoadedImage loaded = ScaledImageLoader::fromData(imageData);
 
-    if (!image.loadFromData(imageData))
+    if (loaded.isNull())
     {
         m_urlStatusLabel->setText("❌ 不是有效的图片");
         m_urlStatusLabel->setStyleSheet(QString("QLabel { color: %1; font-size: 12px; }").arg(getErrorColor()));
@@ -768,8 +1124,9 @@ void RecognizerWidget::onNetworkImageDownloaded()
     m_urlStatusLabel->setStyleSheet(QString("QLabel { color: %1; font-size: 12px; }").arg(getSuccessColor()));
 
     // 更新图片预览
-    m_currentImage = image;
-    updateImagePreview(image);
+    m_loadedImage = loaded;
+    updateImagePreview(loaded.image);
+    updatePageSelector();
 
     // 启用识别按钮
     m_recognizeButton->setEnabled(true);
@@ -784,6 +1141,10 @@ void RecognizerWidget::onNetworkImageDownloaded()
 
     QList<QRCodeRecognizer::RecognitionResult> results =
         m_recognizer->recognizeMultiFormat(m_currentImage, config);
+    if (results.isEmpty())
+    {
+        results = recognizeFullResolution(config);
+    }
 
     if (!results.isEmpty())
     {
@@ -0,0 +1,124 @@
+#include "gui/StatsPanel.h"
+#include "core/RecognitionTelemetry.h"
+
+#include <QDateTime>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QTableWidget>
+#include <QTimer>
+
+StatsPanel::StatsPanel(QWidget* parent)
+    : BaseWidget(parent)
+    , m_summaryLabel(nullptr)
+    , m_stageTable(nullptr)
+    , m_exportButton(nullptr)
+    , m_resetButton(nullptr)
+    , m_refreshTimer(new QTimer(this))
+{
+    setupUI();
+
+    // 只在面板可见时刷新
+    m_refreshTimer->setInterval(REFRESH_INTERVAL);
+    connect(m_refreshTimer, &QTimer::timeout, this, &StatsPanel::refresh);
+}
+
+void StatsPanel::setupUI()
+{
+    QVBoxLayout* mainLayout = createVBoxLayout(this, 5, 5);
+
+    m_summaryLabel = createLabel("暂无识别记录");
+    m_summaryLabel->setWordWrap(true);
+    mainLayout->addWidget(m_summaryLabel);
+
+    m_stageTable = new QTableWidget(0, 6);
+    m_stageTable->setHorizontalHeaderLabels({"阶段", "样本数", "平均(ms)", "P50(ms)", "P95(ms)", "P99(ms)"});
+    m_stageTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_stageTable->horizontalHeader()->setStretchLastSection(true);
+    m_stageTable->verticalHeader()->setVisible(false);
+    m_stageTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_stageTable->setSelectionMode(QAbstractItemView::NoSelection);
+    mainLayout->addWidget(m_stageTable);
+
+    QHBoxLayout* buttonLayout = createHBoxLayout(nullptr, 0, 5);
+    m_exportButton = createButton("导出JSON");
+    m_resetButton = createButton("重置");
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(m_exportButton);
+    buttonLayout->addWidget(m_resetButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(m_exportButton, &QPushButton::clicked, this, &StatsPanel::onExportJson);
+    connect(m_resetButton, &QPushButton::clicked, this, &StatsPanel::onReset);
+}
+
+void StatsPanel::showEvent(QShowEvent* event)
+{
+    BaseWidget::showEvent(event);
+    refresh();
+    m_refreshTimer->start();
+}
+
+void StatsPanel::hideEvent(QHideEvent* event)
+{
+    m_refreshTimer->stop();
+    BaseWidget::hideEvent(event);
+}
+
+void StatsPanel::refresh()
+{
+    auto snapshot = RecognitionTelemetry::instance().snapshot();
+
+    if (snapshot.calls == 0 && snapshot.droppedFrames == 0 && snapshot.skippedFrames == 0) {
+        m_summaryLabel->setText("暂无识别记录");
+    } else {
+        double successRate = snapshot.calls > 0 ? 100.0 * snapshot.successes / snapshot.calls : 0.0;
+        m_summaryLabel->setText(QString("识别次数: %1  成功率: %2%  丢帧: %3  未变化跳过: %4  吞吐量: %5 次/秒")
+                                    .arg(snapshot.calls)
+                                    .arg(successRate, 0, 'f', 1)
+                                    .arg(snapshot.droppedFrames)
+                                    .arg(snapshot.skippedFrames)
+                                    .arg(snapshot.throughput, 0, 'f', 1));
+    }
+
+    m_stageTable->setRowCount(snapshot.stages.size());
+    for (int row = 0; row < snapshot.stages.size(); ++row) {
+        const auto& stage = snapshot.stages[row];
+        const QStringList cells = {
+            stage.name,
+            QString::number(stage.count),
+            QString::number(stage.mean, 'f', 2),
+            QString::number(stage.p50, 'f', 2),
+            QString::number(stage.p95, 'f', 2),
+            QString::number(stage.p99, 'f', 2)
+        };
+        for (int column = 0; column < cells.size(); ++column) {
+            auto* item = m_stageTable->item(row, column);
+            if (!item) {
+                item = new QTableWidgetItem();
+                m_stageTable->setItem(row, column, item);
+            }
+            item->setText(cells[column]);
+        }
+    }
+}
+
+void StatsPanel::onExportJson()
+{
+    QString defaultName = QString("recognition_stats_%1.json")
+                              .arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+    QString fileName = QFileDialog::getSaveFileName(this, "导出性能统计", defaultName, "JSON文件 (*.json)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    if (!RecognitionTelemetry::instance().saveJson(fileName)) {
+        QMessageBox::warning(this, "导出失败", QString("无法写入文件: %1").arg(fileName));
+    }
+}
+
+void StatsPanel::onReset()
+{
+    RecognitionTelemetry::instance().reset();
+    refresh();
+}
@@ -0,0 +1,233 @@
+#include "gui/VideoScanWidget.h"
+#include "utils/AppUtils.h"
+
+#include <QCheckBox>
+#include <QDateTime>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QProgressBar>
+#include <QTableWidget>
+#include <QTimer>
+
+VideoScanWidget::VideoScanWidget(QWidget* parent)
+    : BaseWidget(parent)
+    , m_scanner(new VideoFileScanner(this))
+    , m_fileEdit(nullptr)
+    , m_browseButton(nullptr)
+    , m_startStopButton(nullptr)
+    , m_skipSimilarCheckBox(nullptr)
+    , m_progressBar(nullptr)
+    , m_statusLabel(nullptr)
+    , m_detectionTable(nullptr)
+    , m_exportButton(nullptr)
+    , m_progressTimer(new QTimer(this))
+{
+    setupUI();
+
+    connect(m_scanner, &VideoFileScanner::detectionAdded, this, &VideoScanWidget::onDetectionAdded);
+    connect(m_scanner, &VideoFileScanner::detectionUpdated, this, &VideoScanWidget::onDetectionUpdated);
+    connect(m_scanner, &VideoFileScanner::finished, this, &VideoScanWidget::onScanFinished);
+    connect(m_scanner, &VideoFileScanner::errorOccurred, this, &VideoScanWidget::onScanError);
+
+    // 扫描期间定期刷新进度，而不是每帧刷新
+    m_progressTimer->setInterval(PROGRESS_INTERVAL);
+    connect(m_progressTimer, &QTimer::timeout, this, &VideoScanWidget::updateProgress);
+}
+
+void VideoScanWidget::setupUI()
+{
+    QVBoxLayout* mainLayout = createVBoxLayout(this);
+
+    // 视频文件
+    QGroupBox* fileGroup = createGroupBox("视频文件");
+    QVBoxLayout* fileLayout = createVBoxLayout(fileGroup);
+
+    QHBoxLayout* pathLayout = createHBoxLayout(nullptr, 0, 5);
+    m_fileEdit = new QLineEdit();
+    m_fileEdit->setPlaceholderText("选择要扫描的本地视频文件...");
+    m_browseButton = createButton("浏览...");
+    pathLayout->addWidget(m_fileEdit);
+    pathLayout->addWidget(m_browseButton);
+    fileLayout->addLayout(pathLayout);
+
+    QHBoxLayout* controlLayout = createHBoxLayout(nullptr, 0, 5);
+    m_skipSimilarCheckBox = new QCheckBox("跳过几乎相同的连续帧");
+    m_skipSimilarCheckBox->setChecked(true);
+    m_startStopButton = createButton("开始扫描");
+    controlLayout->addWidget(m_skipSimilarCheckBox);
+    controlLayout->addStretch();
+    controlLayout->addWidget(m_startStopButton);
+    fileLayout->addLayout(controlLayout);
+
+    m_progressBar = new QProgressBar();
+    m_progressBar->setRange(0, 1000);
+    m_progressBar->setValue(0);
+    m_progressBar->setTextVisible(false);
+    fileLayout->addWidget(m_progressBar);
+
+    m_statusLabel = createLabel("未开始");
+    m_statusLabel->setWordWrap(true);
+    fileLayout->addWidget(m_statusLabel);
+
+    mainLayout->addWidget(fileGroup);
+
+    // 检测记录
+    QGroupBox* resultsGroup = createGroupBox("检测记录");
+    QVBoxLayout* resultsLayout = createVBoxLayout(resultsGroup);
+
+    m_detectionTable = new QTableWidget(0, 5);
+    m_detectionTable->setHorizontalHeaderLabels({"首次出现", "最后出现", "格式", "内容", "次数"});
+    m_detectionTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_detectionTable->horizontalHeader()->setSectionResizeMode(3, QHeaderView::Stretch);
+    m_detectionTable->verticalHeader()->setVisible(false);
+    m_detectionTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_detectionTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    resultsLayout->addWidget(m_detectionTable);
+
+    QHBoxLayout* exportLayout = createHBoxLayout(nullptr, 0, 5);
+    m_exportButton = createButton("导出日志");
+    m_exportButton->setEnabled(false);
+    exportLayout->addStretch();
+    exportLayout->addWidget(m_exportButton);
+    resultsLayout->addLayout(exportLayout);
+
+    mainLayout->addWidget(resultsGroup, 1);
+
+    connect(m_browseButton, &QPushButton::clicked, this, &VideoScanWidget::onBrowseClicked);
+    connect(m_startStopButton, &QPushButton::clicked, this, &VideoScanWidget::onStartStopClicked);
+    connect(m_exportButton, &QPushButton::clicked, this, &VideoScanWidget::onExportClicked);
+}
+
+void VideoScanWidget::onBrowseClicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "选择视频文件", m_fileEdit->text(),
+                                                    AppUtils::getVideoFileFilter());
+    if (!fileName.isEmpty()) {
+        m_fileEdit->setText(fileName);
+    }
+}
+
+void VideoScanWidget::onStartStopClicked()
+{
+    if (m_scanner->isRunning()) {
+        m_scanner->stop();
+        setRunning(false);
+        updateProgress();
+        m_statusLabel->setText(m_statusLabel->text() + "（已停止）");
+        return;
+    }
+
+    QString fileName = m_fileEdit->text().trimmed();
+    if (fileName.isEmpty() || !QFileInfo::exists(fileName)) {
+        QMessageBox::warning(this, "警告", "请先选择存在的视频文件！");
+        return;
+    }
+
+    m_detectionTable->setRowCount(0);
+    m_scanner->setSkipThreshold(m_skipSimilarCheckBox->isChecked() ? 2.0 : 0.0);
+    if (m_scanner->start(fileName)) {
+        setRunning(true);
+        m_statusLabel->setText("正在扫描...");
+    }
+}
+
+void VideoScanWidget::onExportClicked()
+{
+    QString defaultName = QString("video_scan_%1.csv")
+                              .arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+    QString fileName = QFileDialog::getSaveFileName(this, "导出检测日志", defaultName, "CSV文件 (*.csv)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    if (!m_scanner->saveLog(fileName)) {
+        QMessageBox::warning(this, "导出失败", QString("无法写入文件: %1").arg(fileName));
+    }
+}
+
+void VideoScanWidget::onDetectionAdded(int index)
+{
+    const auto detection = m_scanner->detections().at(index);
+    m_detectionTable->insertRow(index);
+    setDetectionRow(index, detection);
+    emit qrCodeDetected(detection.result.text, detection.result);
+}
+
+void VideoScanWidget::onDetectionUpdated(int index)
+{
+    setDetectionRow(index, m_scanner->detections().at(index));
+}
+
+void VideoScanWidget::setDetectionRow(int row, const VideoFileScanner::Detection& detection)
+{
+    const QStringList cells = {
+        VideoFileScanner::formatTimestamp(detection.firstSeenMs),
+        VideoFileScanner::formatTimestamp(detection.lastSeenMs),
+        detection.result.formatName(),
+        detection.result.text,
+        QString::number(detection.hits)
+    };
+    for (int column = 0; column < cells.size(); ++column) {
+        auto* item = m_detectionTable->item(row, column);
+        if (!item) {
+            item = new QTableWidgetItem();
+            m_detectionTable->setItem(row, column, item);
+        }
+        item->setText(cells[column]);
+    }
+}
+
+void VideoScanWidget::onScanFinished(const VideoFileScanner::Statistics& statistics)
+{
+    Q_UNUSED(statistics)
+    setRunning(false);
+    updateProgress();
+    m_progressBar->setValue(m_progressBar->maximum());
+    m_statusLabel->setText(m_statusLabel->text() + "（完成）");
+}
+
+void VideoScanWidget::onScanError(const QString& error)
+{
+    QMessageBox::warning(this, "视频识别错误", error);
+}
+
+void VideoScanWidget::updateProgress()
+{
+    auto statistics = m_scanner->statistics();
+
+    if (statistics.durationMs > 0) {
+        m_progressBar->setValue(static_cast<int>(1000 * statistics.positionMs / statistics.durationMs));
+    }
+
+    // 视频时间与实际耗时之比即相对实时播放的加速倍数
+    double fps = statistics.elapsedMs > 0 ? 1000.0 * statistics.framesDecoded / statistics.elapsedMs : 0.0;
+    double speed = statistics.elapsedMs > 0 ? static_cast<double>(statistics.positionMs) / statistics.elapsedMs : 0.0;
+    m_statusLabel->setText(QString("进度: %1 / %2  识别帧: %3  跳过: %4  后端跳帧: %5  识别速度: %6 帧/秒 (%7x)  检测记录: %8")
+                               .arg(VideoFileScanner::formatTimestamp(statistics.positionMs))
+                               .arg(VideoFileScanner::formatTimestamp(statistics.durationMs))
+                               .arg(statistics.framesDecoded)
+                               .arg(statistics.framesSkipped)
+                               .arg(statistics.framesDropped)
+                               .arg(fps, 0, 'f', 1)
+                               .arg(speed, 0, 'f', 1)
+                               .arg(m_detectionTable->rowCount()));
+}
+
+void VideoScanWidget::setRunning(bool running)
+{
+    m_startStopButton->setText(running ? "停止扫描" : "开始扫描");
+    m_browseButton->setEnabled(!running);
+    m_fileEdit->setEnabled(!running);
+    m_skipSimilarCheckBox->setEnabled(!running);
+    m_exportButton->setEnabled(!running && m_detectionTable->rowCount() > 0);
+
+    if (running) {
+        m_progressBar->setValue(0);
+        m_progressTimer->start();
+    } else {
+        m_progressTimer->stop();
+    }
+}
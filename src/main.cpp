@@ -1,13 +1,26 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDir>
+#include <QFile>
 #include <QStandardPaths>
 #include <QTextCodec>
+#include <QTextStream>
+#include "core/DocumentRecognizer.h"
 #include "gui/MainWindow.h"
 
-int main(int argc, char *argv[])
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#ifndef NOMINMAX
+#define NOMINMAX    // windows.h的min/max宏与std::max冲突
+#endif
+#include <windows.h>
+#endif
+
+static void setApplicationInfo(QCoreApplication& app)
 {
-    QApplication app(argc, argv);
-    
     // 设置UTF-8编码支持，确保中文正确处理
     QTextCodec::setCodecForLocale(QTextCodec::codecForName("UTF-8"));
     
@@ -16,6 +29,132 @@ int main(int argc, char *argv[])
     app.setApplicationVersion("3.0");
     app.setOrganizationName("SCU-CS");
     app.setOrganizationDomain("scu-cs.org");
+}
+
+/**
+ * @brief 命令行中是否要求批量识别（需要在创建应用对象之前判断，批量模式不创建界面）
+ */
+static bool isBatchMode(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--batch") == 0 || std::strcmp(argv[i], "-b") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef Q_OS_WIN
+/**
+ * @brief 批量模式下把标准输出和标准错误连接到启动程序的控制台
+ *
+ * 程序以WIN32子系统构建，启动界面时不会弹出控制台窗口，但从控制台运行时标准流也不连接任何地方。
+ * 批量模式附加到父进程的控制台并重新打开未重定向的标准流，已重定向到文件或管道的流保持不变。
+ * 没有父控制台（如在资源管理器中启动）时输出被丢弃，只有退出码有效
+ */
+static void attachParentConsole()
+{
+    auto isRedirected = [](DWORD stdHandle) {
+        HANDLE handle = GetStdHandle(stdHandle);
+        return handle != nullptr && handle != INVALID_HANDLE_VALUE;
+    };
+    bool outRedirected = isRedirected(STD_OUTPUT_HANDLE);
+    bool errRedirected = isRedirected(STD_ERROR_HANDLE);
+
+    if (!AttachConsole(ATTACH_PARENT_PROCESS)) {
+        return;
+    }
+    if (!outRedirected) {
+        std::freopen("CONOUT$", "w", stdout);
+    }
+    if (!errRedirected) {
+        std::freopen("CONOUT$", "w", stderr);
+    }
+}
+#endif
+
+/**
+ * @brief 批量识别：逐个文件按页识别，结果按页和符号以CSV输出
+ * @return 所有文件都能读取时返回0，否则返回1
+ */
+static int runBatch(QCoreApplication& app)
+{
+#ifdef Q_OS_WIN
+    attachParentConsole();
+#endif
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("批量识别图像和多页文档（TIFF、GIF、ICO等）中的条码");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption batchOption(QStringList() << "b" << "batch", "批量识别模式（不显示界面）");
+    QCommandLineOption outputOption(QStringList() << "o" << "output", "把CSV结果写入文件（默认输出到标准输出）", "file");
+    QCommandLineOption maxSymbolsOption("max-symbols", "每页最大识别数量（默认10）", "count", "10");
+    QCommandLineOption tryHarderOption("try-harder", "严格模式（更准确但更慢）");
+    parser.addOption(batchOption);
+    parser.addOption(outputOption);
+    parser.addOption(maxSymbolsOption);
+    parser.addOption(tryHarderOption);
+    parser.addPositionalArgument("files", "待识别的图像或多页文档", "files...");
+    parser.process(app);
+
+    QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    QRCodeRecognizer::RecognitionConfig config;
+    config.maxSymbols = std::max(1, parser.value(maxSymbolsOption).toInt());
+    config.tryHarder = parser.isSet(tryHarderOption);
+
+    QTextStream err(stderr);
+    DocumentRecognizer recognizer;
+    QList<DocumentRecognizer::DocumentResult> documents;
+    bool allReadable = true;
+
+    for (const QString& file : files) {
+        auto document = recognizer.recognizeFile(file, config);
+        if (!document.error.isEmpty()) {
+            allReadable = false;
+            err << file << ": " << document.error << Qt::endl;
+        } else {
+            err << file << ": " << document.pageCount << " 页，" << document.symbolCount() << " 个符号，"
+                << document.sequences.size() << " 个结构化追加序列，用时 " << document.elapsedMs << " ms" << Qt::endl;
+            for (const QString& incomplete : document.incompleteSequences) {
+                err << "  不完整的序列: " << incomplete << Qt::endl;
+            }
+        }
+        documents.append(document);
+    }
+
+    if (parser.isSet(outputOption)) {
+        QFile output(parser.value(outputOption));
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            err << "无法写入文件: " << output.fileName() << Qt::endl;
+            return 1;
+        }
+        QTextStream out(&output);
+        out.setEncoding(QStringConverter::Utf8);
+        DocumentRecognizer::writeReport(out, documents);
+    } else {
+        QTextStream out(stdout);
+        out.setEncoding(QStringConverter::Utf8);
+        DocumentRecognizer::writeReport(out, documents);
+    }
+
+    return allReadable ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (isBatchMode(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        setApplicationInfo(app);
+        return runBatch(app);
+    }
+
+    QApplication app(argc, argv);
+    setApplicationInfo(app);
     
     // 设置应用程序图标
     app.setWindowIcon(QIcon(":/toucher.jpg"));
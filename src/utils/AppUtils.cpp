@@ -63,6 +63,11 @@ QString AppUtils::getSaveImageFileFilter()
     return "PNG 图片 (*.png);;JPEG 图片 (*.jpg *.jpeg);;BMP 图片 (*.bmp);;SVG 矢量图 (*.svg);;所有文件 (*.*)";
 }
 
+QString AppUtils::getVideoFileFilter()
+{
+    return "视频文件 (*.mp4 *.avi *.mkv *.mov *.wmv *.webm *.m4v *.ts);;所有文件 (*.*)";
+}
+
 QString AppUtils::formatFileSize(qint64 bytes)
 {
     const qint64 kb = 1024;